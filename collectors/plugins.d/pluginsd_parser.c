@@ -7,6 +7,121 @@
 #define SERVING_STREAMING(parser) ((parser)->repertoire == PARSER_INIT_STREAMING)
 #define SERVING_PLUGINSD(parser) ((parser)->repertoire == PARSER_INIT_PLUGINSD)
 
+// ----------------------------------------------------------------------------
+// non-blocking writer
+// the streaming receivers pool serves many children per thread, so it never waits
+// for a socket to become writable: whatever the socket cannot take now is kept in
+// writer.pending, and the pool thread sends it when poll() reports the socket writable
+
+static ssize_t parser_writer_write_unsafe(PARSER *parser, const char *txt, size_t len) {
+    ssize_t bytes;
+
+    do {
+        errno = 0;
+
+#ifdef ENABLE_HTTPS
+        if(parser->ssl_output && SSL_connection(parser->ssl_output))
+            bytes = netdata_ssl_write(parser->ssl_output, txt, len);
+        else
+#endif
+            bytes = write(parser->fd, txt, len);
+
+    } while(bytes < 0 && errno == EINTR);
+
+    if(bytes < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        return 0;
+
+    return bytes;
+}
+
+static void parser_writer_failed_unsafe(PARSER *parser, const char *reason) {
+    if(!parser->writer.failed)
+        netdata_log_error("PLUGINSD: cannot send command (non-blocking fd %d): %s", parser->fd, reason);
+
+    parser->writer.failed = true;
+}
+
+static ssize_t send_to_plugin_nonblocking_unsafe(PARSER *parser, const char *txt) {
+    if(parser->writer.failed)
+        return -3;
+
+    size_t len = strlen(txt);
+    size_t sent = 0;
+
+    if(!buffer_strlen(parser->writer.pending)) {
+        ssize_t bytes = parser_writer_write_unsafe(parser, txt, len);
+        if(bytes < 0) {
+            parser_writer_failed_unsafe(parser, "the socket failed");
+            return -3;
+        }
+
+        sent = (size_t)bytes;
+    }
+
+    if(sent < len) {
+        bool was_empty = !buffer_strlen(parser->writer.pending);
+
+        if(buffer_strlen(parser->writer.pending) + len - sent > parser->writer.max_pending) {
+            parser_writer_failed_unsafe(parser, "the other end does not receive the data sent to it");
+            return -3;
+        }
+
+        buffer_memcat(parser->writer.pending, &txt[sent], len - sent);
+
+        // when another thread queued the data, the pool thread may not be polling for POLLOUT yet
+        if(was_empty && parser->writer.wake_fd != -1 &&
+           write(parser->writer.wake_fd, " ", 1) == -1 && errno != EAGAIN && errno != EWOULDBLOCK)
+            netdata_log_error("PLUGINSD: cannot wake up the thread serving fd %d", parser->fd);
+    }
+
+    return (ssize_t)len;
+}
+
+void parser_writer_nonblocking(PARSER *parser, size_t max_pending, int wake_fd) {
+    spinlock_lock(&parser->writer.spinlock);
+    if(!parser->writer.pending)
+        parser->writer.pending = buffer_create(0, NULL);
+
+    parser->writer.max_pending = max_pending;
+    parser->writer.wake_fd = wake_fd;
+    spinlock_unlock(&parser->writer.spinlock);
+}
+
+bool parser_writer_has_pending(PARSER *parser) {
+    spinlock_lock(&parser->writer.spinlock);
+    bool pending = parser->writer.pending && buffer_strlen(parser->writer.pending);
+    spinlock_unlock(&parser->writer.spinlock);
+
+    return pending;
+}
+
+// sends as much of the pending data as the socket can take now
+// returns false when the socket has failed
+bool parser_writer_flush(PARSER *parser) {
+    spinlock_lock(&parser->writer.spinlock);
+
+    BUFFER *wb = parser->writer.pending;
+    while(wb && !parser->writer.failed && buffer_strlen(wb)) {
+        ssize_t bytes = parser_writer_write_unsafe(parser, buffer_tostring(wb), buffer_strlen(wb));
+        if(bytes < 0) {
+            parser_writer_failed_unsafe(parser, "the socket failed");
+            break;
+        }
+
+        if(!bytes)
+            break;
+
+        wb->len -= (size_t)bytes;
+        memmove(wb->buffer, &wb->buffer[bytes], wb->len);
+        wb->buffer[wb->len] = '\0';
+    }
+
+    bool ok = !parser->writer.failed;
+    spinlock_unlock(&parser->writer.spinlock);
+
+    return ok;
+}
+
 static ssize_t send_to_plugin(const char *txt, void *data) {
     PARSER *parser = data;
 
@@ -22,6 +137,12 @@ static ssize_t send_to_plugin(const char *txt, void *data) {
     spinlock_lock(&parser->writer.spinlock);
     ssize_t bytes = -1;
 
+    if(parser->writer.pending) {
+        bytes = send_to_plugin_nonblocking_unsafe(parser, txt);
+        spinlock_unlock(&parser->writer.spinlock);
+        return bytes;
+    }
+
 #ifdef ENABLE_HTTPS
     NETDATA_SSL *ssl = parser->ssl_output;
     if(ssl) {
@@ -1894,21 +2015,11 @@ static inline PARSER_RC pluginsd_replay_end(char **words, size_t num_words, PARS
     return ok ? PARSER_RC_OK : PARSER_RC_ERROR;
 }
 
-static inline PARSER_RC pluginsd_begin_v2(char **words, size_t num_words, PARSER *parser) {
-    timing_init();
-
-    int idx = 1;
-    ssize_t slot = pluginsd_parse_rrd_slot(words, num_words);
-    if(slot >= 0) idx++;
-
-    char *id = get_word(words, num_words, idx++);
-    char *update_every_str = get_word(words, num_words, idx++);
-    char *end_time_str = get_word(words, num_words, idx++);
-    char *wall_clock_time_str = get_word(words, num_words, idx++);
-
-    if(unlikely(!id || !update_every_str || !end_time_str || !wall_clock_time_str))
-        return PLUGINSD_DISABLE_PLUGIN(parser, PLUGINSD_KEYWORD_BEGIN_V2, "missing parameters");
-
+// the work of BEGIN2, for both text and binary frames
+// the *_str parameters are the original text of the values, to be copied forward when possible - NULL for binary frames
+static inline PARSER_RC pluginsd_begin_v2_execute(PARSER *parser, ssize_t slot, const char *id,
+                                                  time_t update_every, time_t end_time, time_t wall_clock_time,
+                                                  const char *update_every_str, const char *end_time_str, const char *wall_clock_time_str) {
     RRDHOST *host = pluginsd_require_scope_host(parser, PLUGINSD_KEYWORD_BEGIN_V2);
     if(unlikely(!host)) return PLUGINSD_DISABLE_PLUGIN(parser, NULL, NULL);
 
@@ -1926,23 +2037,9 @@ static inline PARSER_RC pluginsd_begin_v2(char **words, size_t num_words, PARSER
 
     timing_step(TIMING_STEP_BEGIN2_FIND_CHART);
 
-    // ------------------------------------------------------------------------
-    // parse the parameters
-
-    time_t update_every = (time_t) str2ull_encoded(update_every_str);
-    time_t end_time = (time_t) str2ull_encoded(end_time_str);
-
-    time_t wall_clock_time;
-    if(likely(*wall_clock_time_str == '#'))
-        wall_clock_time = end_time;
-    else
-        wall_clock_time = (time_t) str2ull_encoded(wall_clock_time_str);
-
     if (unlikely(update_every != st->update_every))
         rrdset_set_update_every_s(st, update_every);
 
-    timing_step(TIMING_STEP_BEGIN2_PARSE);
-
     // ------------------------------------------------------------------------
     // prepare our state
 
@@ -1961,9 +2058,25 @@ static inline PARSER_RC pluginsd_begin_v2(char **words, size_t num_words, PARSER
     if(!parser->user.v2.stream_buffer.wb && rrdhost_has_rrdpush_sender_enabled(st->rrdhost))
         parser->user.v2.stream_buffer = rrdset_push_metric_initialize(parser->user.st, wall_clock_time);
 
-    if(parser->user.v2.stream_buffer.v2 && parser->user.v2.stream_buffer.wb) {
+    if(parser->user.v2.stream_buffer.v2 && parser->user.v2.stream_buffer.wb &&
+       stream_has_capability(&parser->user.v2.stream_buffer, STREAM_CAP_BINARY_DATA)) {
+        RRDSET_STREAM_BUFFER *rsb = &parser->user.v2.stream_buffer;
+
+        if(unlikely(rsb->begin_v2_added))
+            stream_binary_end(rsb->wb, &rsb->binary);
+
+        stream_binary_begin(rsb->wb, &rsb->binary,
+                            stream_has_capability(rsb, STREAM_CAP_SLOTS) ? st->rrdpush.sender.chart_slot : 0,
+                            rrdset_id(st), string_strlen(st->id),
+                            update_every, end_time, wall_clock_time);
+
+        rsb->last_point_end_time_s = end_time;
+        rsb->begin_v2_added = true;
+    }
+    else if(parser->user.v2.stream_buffer.v2 && parser->user.v2.stream_buffer.wb) {
         // check receiver capabilities
-        bool can_copy = stream_has_capability(&parser->user, STREAM_CAP_IEEE754) == stream_has_capability(&parser->user.v2.stream_buffer, STREAM_CAP_IEEE754);
+        bool can_copy = update_every_str && end_time_str && wall_clock_time_str &&
+                stream_has_capability(&parser->user, STREAM_CAP_IEEE754) == stream_has_capability(&parser->user.v2.stream_buffer, STREAM_CAP_IEEE754);
 
         // check sender capabilities
         bool with_slots = stream_has_capability(&parser->user.v2.stream_buffer, STREAM_CAP_SLOTS) ? true : false;
@@ -2034,31 +2147,53 @@ static inline PARSER_RC pluginsd_begin_v2(char **words, size_t num_words, PARSER
     return PARSER_RC_OK;
 }
 
-static inline PARSER_RC pluginsd_set_v2(char **words, size_t num_words, PARSER *parser) {
+static inline PARSER_RC pluginsd_begin_v2(char **words, size_t num_words, PARSER *parser) {
     timing_init();
 
     int idx = 1;
     ssize_t slot = pluginsd_parse_rrd_slot(words, num_words);
     if(slot >= 0) idx++;
 
-    char *dimension = get_word(words, num_words, idx++);
-    char *collected_str = get_word(words, num_words, idx++);
-    char *value_str = get_word(words, num_words, idx++);
-    char *flags_str = get_word(words, num_words, idx++);
+    char *id = get_word(words, num_words, idx++);
+    char *update_every_str = get_word(words, num_words, idx++);
+    char *end_time_str = get_word(words, num_words, idx++);
+    char *wall_clock_time_str = get_word(words, num_words, idx++);
 
-    if(unlikely(!dimension || !collected_str || !value_str || !flags_str))
-        return PLUGINSD_DISABLE_PLUGIN(parser, PLUGINSD_KEYWORD_SET_V2, "missing parameters");
+    if(unlikely(!id || !update_every_str || !end_time_str || !wall_clock_time_str))
+        return PLUGINSD_DISABLE_PLUGIN(parser, PLUGINSD_KEYWORD_BEGIN_V2, "missing parameters");
+
+    // ------------------------------------------------------------------------
+    // parse the parameters
+
+    time_t update_every = (time_t) str2ull_encoded(update_every_str);
+    time_t end_time = (time_t) str2ull_encoded(end_time_str);
+
+    time_t wall_clock_time;
+    if(likely(*wall_clock_time_str == '#'))
+        wall_clock_time = end_time;
+    else
+        wall_clock_time = (time_t) str2ull_encoded(wall_clock_time_str);
+
+    timing_step(TIMING_STEP_BEGIN2_PARSE);
+
+    return pluginsd_begin_v2_execute(parser, slot, id, update_every, end_time, wall_clock_time,
+                                     update_every_str, end_time_str, wall_clock_time_str);
+}
 
+// the work of SET2, for both text and binary frames
+// the *_str parameters are the original text of the values, to be copied forward when possible - NULL for binary frames
+// finds the dimension of SET2, for both text and binary frames - NULL when the plugin has to be disabled
+static inline RRDDIM *pluginsd_set_v2_dimension(PARSER *parser, ssize_t slot, const char *dimension) {
     RRDHOST *host = pluginsd_require_scope_host(parser, PLUGINSD_KEYWORD_SET_V2);
-    if(unlikely(!host)) return PLUGINSD_DISABLE_PLUGIN(parser, NULL, NULL);
+    if(unlikely(!host)) return NULL;
 
     RRDSET *st = pluginsd_require_scope_chart(parser, PLUGINSD_KEYWORD_SET_V2, PLUGINSD_KEYWORD_BEGIN_V2);
-    if(unlikely(!st)) return PLUGINSD_DISABLE_PLUGIN(parser, NULL, NULL);
+    if(unlikely(!st)) return NULL;
 
     timing_step(TIMING_STEP_SET2_PREPARE);
 
     RRDDIM *rd = pluginsd_acquire_dimension(host, st, dimension, slot, PLUGINSD_KEYWORD_SET_V2);
-    if(unlikely(!rd)) return PLUGINSD_DISABLE_PLUGIN(parser, NULL, NULL);
+    if(unlikely(!rd)) return NULL;
 
     st->pluginsd.set = true;
 
@@ -2067,20 +2202,12 @@ static inline PARSER_RC pluginsd_set_v2(char **words, size_t num_words, PARSER *
 
     timing_step(TIMING_STEP_SET2_LOOKUP_DIMENSION);
 
-    // ------------------------------------------------------------------------
-    // parse the parameters
-
-    collected_number collected_value = (collected_number) str2ll_encoded(collected_str);
-
-    NETDATA_DOUBLE value;
-    if(*value_str == '#')
-        value = (NETDATA_DOUBLE)collected_value;
-    else
-        value = str2ndd_encoded(value_str, NULL);
-
-    SN_FLAGS flags = pluginsd_parse_storage_number_flags(flags_str);
+    return rd;
+}
 
-    timing_step(TIMING_STEP_SET2_PARSE);
+static inline PARSER_RC pluginsd_set_v2_execute(PARSER *parser, RRDDIM *rd,
+                                                collected_number collected_value, NETDATA_DOUBLE value, SN_FLAGS flags,
+                                                const char *collected_str, const char *value_str) {
 
     // ------------------------------------------------------------------------
     // check value and ML
@@ -2106,9 +2233,14 @@ static inline PARSER_RC pluginsd_set_v2(char **words, size_t num_words, PARSER *
     // ------------------------------------------------------------------------
     // propagate it forward in v2
 
-    if(parser->user.v2.stream_buffer.v2 && parser->user.v2.stream_buffer.begin_v2_added && parser->user.v2.stream_buffer.wb) {
+    if(parser->user.v2.stream_buffer.v2 && parser->user.v2.stream_buffer.begin_v2_added && parser->user.v2.stream_buffer.wb &&
+       stream_has_capability(&parser->user.v2.stream_buffer, STREAM_CAP_BINARY_DATA)) {
+        rrddim_push_metrics_v2_binary_set(&parser->user.v2.stream_buffer, rd, collected_value, value, flags);
+    }
+    else if(parser->user.v2.stream_buffer.v2 && parser->user.v2.stream_buffer.begin_v2_added && parser->user.v2.stream_buffer.wb) {
         // check if receiver and sender have the same number parsing capabilities
-        bool can_copy = stream_has_capability(&parser->user, STREAM_CAP_IEEE754) == stream_has_capability(&parser->user.v2.stream_buffer, STREAM_CAP_IEEE754);
+        bool can_copy = collected_str && value_str &&
+                stream_has_capability(&parser->user, STREAM_CAP_IEEE754) == stream_has_capability(&parser->user.v2.stream_buffer, STREAM_CAP_IEEE754);
 
         // check the sender capabilities
         bool with_slots = stream_has_capability(&parser->user.v2.stream_buffer, STREAM_CAP_SLOTS) ? true : false;
@@ -2160,6 +2292,42 @@ static inline PARSER_RC pluginsd_set_v2(char **words, size_t num_words, PARSER *
     return PARSER_RC_OK;
 }
 
+static inline PARSER_RC pluginsd_set_v2(char **words, size_t num_words, PARSER *parser) {
+    timing_init();
+
+    int idx = 1;
+    ssize_t slot = pluginsd_parse_rrd_slot(words, num_words);
+    if(slot >= 0) idx++;
+
+    char *dimension = get_word(words, num_words, idx++);
+    char *collected_str = get_word(words, num_words, idx++);
+    char *value_str = get_word(words, num_words, idx++);
+    char *flags_str = get_word(words, num_words, idx++);
+
+    if(unlikely(!dimension || !collected_str || !value_str || !flags_str))
+        return PLUGINSD_DISABLE_PLUGIN(parser, PLUGINSD_KEYWORD_SET_V2, "missing parameters");
+
+    // ------------------------------------------------------------------------
+    // parse the parameters
+
+    collected_number collected_value = (collected_number) str2ll_encoded(collected_str);
+
+    NETDATA_DOUBLE value;
+    if(*value_str == '#')
+        value = (NETDATA_DOUBLE)collected_value;
+    else
+        value = str2ndd_encoded(value_str, NULL);
+
+    SN_FLAGS flags = pluginsd_parse_storage_number_flags(flags_str);
+
+    timing_step(TIMING_STEP_SET2_PARSE);
+
+    RRDDIM *rd = pluginsd_set_v2_dimension(parser, slot, dimension);
+    if(unlikely(!rd)) return PLUGINSD_DISABLE_PLUGIN(parser, NULL, NULL);
+
+    return pluginsd_set_v2_execute(parser, rd, collected_value, value, flags, collected_str, value_str);
+}
+
 void pluginsd_cleanup_v2(PARSER *parser) {
     // this is called when the thread is stopped while processing
     pluginsd_clear_scope_chart(parser, "THREAD CLEANUP");
@@ -2238,6 +2406,115 @@ static inline PARSER_RC pluginsd_end_v2(char **words __maybe_unused, size_t num_
     return PARSER_RC_OK;
 }
 
+// ----------------------------------------------------------------------------
+// binary frames of BEGIN2 / SET2 / END2 (see streaming/binary.h)
+
+PARSER_RC pluginsd_binary_frame(PARSER *parser, char *frame) {
+    char *records = &frame[1];
+    ssize_t len = stream_binary_frame_unescape(records);
+    if(unlikely(len < 0))
+        return PLUGINSD_DISABLE_PLUGIN(parser, "BINARY", "corrupted frame");
+
+    STREAM_BINARY_READER r = {
+            .pos = (const uint8_t *)records,
+            .end = (const uint8_t *)records + len,
+            .error = false,
+    };
+
+    PARSER_RC rc = PARSER_RC_OK;
+    while(rc == PARSER_RC_OK && r.pos < r.end) {
+        timing_init();
+
+        switch(stream_binary_get_byte(&r)) {
+            case STREAM_BINARY_RECORD_BEGIN: {
+                ssize_t slot = (ssize_t)stream_binary_get_varint(&r);
+                const char *id = stream_binary_get_string(&r);
+                time_t update_every = (time_t)stream_binary_get_varint(&r);
+                time_t end_time = (time_t)stream_binary_get_varint(&r);
+                time_t wall_clock_time = end_time + (time_t)stream_binary_get_zigzag(&r);
+
+                if(likely(!r.error))
+                    rc = pluginsd_begin_v2_execute(parser, slot ? slot : -1, id,
+                                                   update_every, end_time, wall_clock_time,
+                                                   NULL, NULL, NULL);
+                break;
+            }
+
+            case STREAM_BINARY_RECORD_SET: {
+                ssize_t slot = (ssize_t)stream_binary_get_varint(&r);
+                const char *dimension = stream_binary_get_string(&r);
+                collected_number collected_value = (collected_number)stream_binary_get_zigzag(&r);
+                uint64_t flags_and_value = stream_binary_get_varint(&r);
+
+                NETDATA_DOUBLE value;
+                if(flags_and_value & 1)
+                    value = stream_binary_get_double(&r);
+                else
+                    value = (NETDATA_DOUBLE)collected_value;
+
+                if(unlikely(r.error))
+                    break;
+
+                RRDDIM *rd = pluginsd_set_v2_dimension(parser, slot ? slot : -1, dimension);
+                if(unlikely(!rd))
+                    return PLUGINSD_DISABLE_PLUGIN(parser, NULL, NULL);
+
+                // the base of the next delta records of this dimension
+                stream_binary_delta_set(&rd->rrdpush.receiver.delta, rd->rrdset->rrdhost->rrdpush_receiver_connection_counter,
+                                        collected_value, value);
+
+                rc = pluginsd_set_v2_execute(parser, rd, collected_value, value, (SN_FLAGS)(flags_and_value >> 1),
+                                             NULL, NULL);
+                break;
+            }
+
+            case STREAM_BINARY_RECORD_DELTA: {
+                ssize_t slot = (ssize_t)stream_binary_get_varint(&r);
+                const char *dimension = stream_binary_get_string(&r);
+                uint64_t collected_delta = (uint64_t)stream_binary_get_zigzag(&r);
+                uint64_t flags_and_value = stream_binary_get_varint(&r);
+                uint64_t value_xor = (flags_and_value & 1) ? stream_binary_get_xor(&r) : 0;
+
+                if(unlikely(r.error))
+                    break;
+
+                RRDDIM *rd = pluginsd_set_v2_dimension(parser, slot ? slot : -1, dimension);
+                if(unlikely(!rd))
+                    return PLUGINSD_DISABLE_PLUGIN(parser, NULL, NULL);
+
+                STREAM_BINARY_DELTA *base = &rd->rrdpush.receiver.delta;
+                if(unlikely(!stream_binary_delta_apply(base, rd->rrdset->rrdhost->rrdpush_receiver_connection_counter,
+                                                       collected_delta, flags_and_value, value_xor))) {
+                    // values encoded for a previous connection of the sender,
+                    // it will send them in full after the chart definition
+                    nd_log_limit_static_global_var(erl, 1, 0);
+                    nd_log_limit(&erl, NDLS_DAEMON, NDLP_ERR,
+                                 "PLUGINSD: 'host:%s/chart:%s/dim:%s' got a delta without a base, ignoring it.",
+                                 rrdhost_hostname(rd->rrdset->rrdhost), rrdset_id(rd->rrdset), rrddim_id(rd));
+                    break;
+                }
+
+                rc = pluginsd_set_v2_execute(parser, rd, base->collected, stream_binary_bits_double(base->value),
+                                             (SN_FLAGS)(flags_and_value >> 1), NULL, NULL);
+                break;
+            }
+
+            case STREAM_BINARY_RECORD_END:
+                rc = pluginsd_end_v2(NULL, 0, parser);
+                break;
+
+            default:
+                r.error = true;
+                break;
+        }
+
+        if(unlikely(r.error))
+            return PLUGINSD_DISABLE_PLUGIN(parser, "BINARY", "malformed record");
+    }
+
+    return rc;
+}
+
 static inline PARSER_RC pluginsd_exit(char **words __maybe_unused, size_t num_words __maybe_unused, PARSER *parser __maybe_unused) {
     netdata_log_info("PLUGINSD: plugin called EXIT.");
     return PARSER_RC_STOP;
@@ -3019,6 +3296,7 @@ PARSER *parser_init(struct parser_user_object *user, FILE *fp_input, FILE *fp_ou
     parser->flags = flags;
 
     spinlock_init(&parser->writer.spinlock);
+    parser->writer.wake_fd = -1;
     return parser;
 }
 
@@ -3161,6 +3439,7 @@ void parser_destroy(PARSER *parser) {
     parser_destroy_dyncfg(parser);
 
     dictionary_destroy(parser->inflight.functions);
+    buffer_free(parser->writer.pending);
     freez(parser);
 }
 
@@ -3203,3 +3482,389 @@ int pluginsd_parser_unittest(void) {
     parser_destroy(p);
     return 0;
 }
+
+// ----------------------------------------------------------------------------
+// binary frames unittest
+
+// unescapes in place the single frame in wb and returns a reader for its records
+static STREAM_BINARY_READER binary_unittest_reader(BUFFER *wb, bool *corrupted) {
+    ssize_t len = stream_binary_frame_unescape(&wb->buffer[1]);
+    *corrupted = (len < 0);
+
+    return (STREAM_BINARY_READER){
+            .pos = (const uint8_t *)&wb->buffer[1],
+            .end = (const uint8_t *)&wb->buffer[1] + (len < 0 ? 0 : len),
+            .error = false,
+    };
+}
+
+static void binary_unittest_frame_start(BUFFER *wb) {
+    buffer_flush(wb);
+    buffer_need_bytes(wb, 1024);
+    wb->buffer[wb->len++] = (char)STREAM_BINARY_FRAME_MARKER;
+}
+
+static void binary_unittest_frame_end(BUFFER *wb) {
+    wb->buffer[wb->len++] = '\n';
+    wb->buffer[wb->len] = '\0';
+}
+
+static int binary_unittest_numbers(BUFFER *wb) {
+    int errors = 0;
+    bool corrupted;
+
+    struct {
+        uint64_t value;
+        size_t bytes;
+    } varints[] = {
+            { 0, 1 },
+            { 127, 1 },
+            { 128, 2 },
+            { 16383, 2 },
+            { 16384, 3 },
+            { UINT32_MAX, 5 },
+            { INT64_MAX, 9 },
+            { UINT64_MAX, 10 },
+    };
+
+    for(size_t i = 0; i < sizeof(varints) / sizeof(varints[0]) ;i++) {
+        binary_unittest_frame_start(wb);
+        stream_binary_put_varint(wb, varints[i].value);
+        binary_unittest_frame_end(wb);
+
+        STREAM_BINARY_READER r = binary_unittest_reader(wb, &corrupted);
+        size_t bytes = r.end - r.pos;
+        uint64_t v = stream_binary_get_varint(&r);
+        if(corrupted || r.error || v != varints[i].value || bytes != varints[i].bytes || r.pos != r.end) {
+            fprintf(stderr, "BINARY: varint %"PRIu64" is decoded as %"PRIu64" from %zu bytes (expected %zu bytes)\n",
+                    varints[i].value, v, bytes, varints[i].bytes);
+            errors++;
+        }
+    }
+
+    struct {
+        int64_t value;
+        uint64_t encoded;
+    } zigzags[] = {
+            { 0, 0 },
+            { -1, 1 },
+            { 1, 2 },
+            { -2, 3 },
+            { INT64_MAX, UINT64_MAX - 1 },
+            { INT64_MIN, UINT64_MAX },
+    };
+
+    for(size_t i = 0; i < sizeof(zigzags) / sizeof(zigzags[0]) ;i++) {
+        binary_unittest_frame_start(wb);
+        stream_binary_put_zigzag(wb, zigzags[i].value);
+        binary_unittest_frame_end(wb);
+
+        STREAM_BINARY_READER r = binary_unittest_reader(wb, &corrupted);
+        uint64_t encoded = stream_binary_get_varint(&r);
+
+        r = (STREAM_BINARY_READER){ .pos = (const uint8_t *)&wb->buffer[1], .end = r.end, .error = false };
+        int64_t v = stream_binary_get_zigzag(&r);
+
+        if(corrupted || r.error || v != zigzags[i].value || encoded != zigzags[i].encoded) {
+            fprintf(stderr, "BINARY: zigzag %"PRId64" is encoded as %"PRIu64" and decoded as %"PRId64"\n",
+                    zigzags[i].value, encoded, v);
+            errors++;
+        }
+    }
+
+    // a varint longer than 64 bits
+    binary_unittest_frame_start(wb);
+    for(size_t i = 0; i < 10 ;i++)
+        stream_binary_put_byte(wb, 0x81);
+    stream_binary_put_byte(wb, 0x01);
+    binary_unittest_frame_end(wb);
+    {
+        STREAM_BINARY_READER r = binary_unittest_reader(wb, &corrupted);
+        stream_binary_get_varint(&r);
+        if(!r.error) {
+            fprintf(stderr, "BINARY: a varint of 11 bytes is accepted\n");
+            errors++;
+        }
+    }
+
+    return errors;
+}
+
+static int binary_unittest_escaping(BUFFER *wb) {
+    int errors = 0;
+    bool corrupted;
+
+    const char bytes[] = { 'a', '\n', '\0', STREAM_BINARY_ESCAPE, STREAM_BINARY_ESCAPE ^ STREAM_BINARY_ESCAPE_XOR, (char)0xff, 'z' };
+
+    binary_unittest_frame_start(wb);
+    for(size_t i = 0; i < sizeof(bytes) ;i++)
+        stream_binary_put_byte(wb, (uint8_t)bytes[i]);
+    binary_unittest_frame_end(wb);
+
+    // the escaped bytes do not appear in the frame, and the frame is a single line
+    if(wb->len != 1 + sizeof(bytes) + 3 + 1 || strlen(wb->buffer) != wb->len || strchr(wb->buffer, '\n') != &wb->buffer[wb->len - 1]) {
+        fprintf(stderr, "BINARY: escaped frame has %zu bytes, expected %zu\n", wb->len, 1 + sizeof(bytes) + 3 + 1);
+        errors++;
+    }
+
+    STREAM_BINARY_READER r = binary_unittest_reader(wb, &corrupted);
+    if(corrupted || (size_t)(r.end - r.pos) != sizeof(bytes) || memcmp(r.pos, bytes, sizeof(bytes)) != 0) {
+        fprintf(stderr, "BINARY: the escaped bytes are not restored\n");
+        errors++;
+    }
+
+    // an escape at the end of the frame
+    binary_unittest_frame_start(wb);
+    stream_binary_put_byte(wb, 'a');
+    wb->buffer[wb->len++] = (char)STREAM_BINARY_ESCAPE;
+    binary_unittest_frame_end(wb);
+    binary_unittest_reader(wb, &corrupted);
+    if(!corrupted) {
+        fprintf(stderr, "BINARY: a frame ending with an escape is accepted\n");
+        errors++;
+    }
+
+    return errors;
+}
+
+static int binary_unittest_frames(BUFFER *wb) {
+    int errors = 0;
+    STREAM_BINARY_FRAME f = { 0 };
+    const char *id = "a_dimension_id_with_\n_and_\x10";
+    size_t id_len = strlen(id);
+    size_t records = 2000;
+
+    buffer_flush(wb);
+    stream_binary_begin(wb, &f, 1, "chart", 5, 1, 1700000000, 1700000001);
+    for(size_t i = 0; i < records ;i++)
+        stream_binary_set(wb, &f, i + 1, id, id_len, (collected_number)i * 1000, (NETDATA_DOUBLE)i + 0.5, SN_FLAG_NONE);
+    stream_binary_end(wb, &f);
+
+    size_t frames = 0, sets = 0, begins = 0, ends = 0;
+    char *s = wb->buffer;
+    while(*s) {
+        char *nl = strchr(s, '\n');
+        if(!nl || *s != (char)STREAM_BINARY_FRAME_MARKER) {
+            fprintf(stderr, "BINARY: frame %zu is not a complete line starting with the marker\n", frames);
+            errors++;
+            break;
+        }
+
+        // a frame is closed after the first record that makes it bigger than the limit
+        if((size_t)(nl - s) > STREAM_BINARY_FRAME_MAX_SIZE + 2 * (id_len + 1) + STREAM_BINARY_RECORD_NUMBERS_MAX_SIZE) {
+            fprintf(stderr, "BINARY: frame %zu has %zu bytes\n", frames, (size_t)(nl - s));
+            errors++;
+        }
+
+        frames++;
+        char *next = nl + 1;
+
+        ssize_t len = stream_binary_frame_unescape(&s[1]);
+        if(len < 0) {
+            fprintf(stderr, "BINARY: frame %zu is corrupted\n", frames);
+            errors++;
+            break;
+        }
+
+        // every frame has complete records
+        STREAM_BINARY_READER r = { .pos = (const uint8_t *)&s[1], .end = (const uint8_t *)&s[1] + len, .error = false };
+        while(r.pos < r.end && !r.error) {
+            switch(stream_binary_get_byte(&r)) {
+                case STREAM_BINARY_RECORD_BEGIN:
+                    stream_binary_get_varint(&r);
+                    stream_binary_get_string(&r);
+                    stream_binary_get_varint(&r);
+                    stream_binary_get_varint(&r);
+                    stream_binary_get_zigzag(&r);
+                    begins++;
+                    break;
+
+                case STREAM_BINARY_RECORD_SET: {
+                    uint64_t slot = stream_binary_get_varint(&r);
+                    const char *dim = stream_binary_get_string(&r);
+                    collected_number collected = (collected_number)stream_binary_get_zigzag(&r);
+                    uint64_t flags_and_value = stream_binary_get_varint(&r);
+                    NETDATA_DOUBLE value = (flags_and_value & 1) ? stream_binary_get_double(&r) : NAN;
+
+                    if(!r.error && (slot != sets + 1 || strcmp(dim, id) != 0 ||
+                                    collected != (collected_number)sets * 1000 || value != (NETDATA_DOUBLE)sets + 0.5)) {
+                        fprintf(stderr, "BINARY: record %zu is not decoded properly\n", sets);
+                        errors++;
+                    }
+                    sets++;
+                    break;
+                }
+
+                case STREAM_BINARY_RECORD_END:
+                    ends++;
+                    break;
+
+                default:
+                    r.error = true;
+                    break;
+            }
+        }
+
+        if(r.error) {
+            fprintf(stderr, "BINARY: frame %zu has incomplete or invalid records\n", frames);
+            errors++;
+        }
+
+        s = next;
+    }
+
+    if(frames < 2 || begins != 1 || sets != records || ends != 1) {
+        fprintf(stderr, "BINARY: got %zu frames with %zu begin, %zu set and %zu end records\n", frames, begins, sets, ends);
+        errors++;
+    }
+
+    return errors;
+}
+
+static int binary_unittest_delta(BUFFER *wb) {
+    int errors = 0;
+
+    struct {
+        collected_number collected;
+        NETDATA_DOUBLE value;
+        SN_FLAGS flags;
+        uint32_t generation;        // of the sender
+        uint32_t connection;        // of the receiver
+        char record;                // expected to be sent
+        bool applied;               // expected to be accepted by the receiver
+    } steps[] = {
+            { 100, 100.0, SN_FLAG_NONE, 1, 7, STREAM_BINARY_RECORD_SET, true },
+            { 105, 105.0, SN_FLAG_NONE, 1, 7, STREAM_BINARY_RECORD_DELTA, true },           // a delta of '\n'
+            { 105, 105.0, SN_FLAG_RESET, 1, 7, STREAM_BINARY_RECORD_DELTA, true },          // a delta of '\0'
+            { 113, 3.25, SN_FLAG_NONE, 1, 7, STREAM_BINARY_RECORD_DELTA, true },            // a delta of the escape byte, with a value
+            { 113, 3.25, SN_FLAG_NONE, 1, 7, STREAM_BINARY_RECORD_DELTA, true },            // the same value
+            { -50, -50.0 / 3.0, SN_FLAG_NONE, 1, 7, STREAM_BINARY_RECORD_DELTA, true },
+            { 60, 60.0, SN_FLAG_NONE, 1, 8, STREAM_BINARY_RECORD_DELTA, false },            // the child reconnected
+            { 70, 70.5, SN_FLAG_NONE, 2, 8, STREAM_BINARY_RECORD_SET, true },               // new generation of the sender
+            { 71, 71.0, SN_FLAG_NONE, 2, 8, STREAM_BINARY_RECORD_DELTA, true },
+    };
+
+    STREAM_BINARY_DELTA sender = { 0 }, receiver = { 0 };
+
+    for(size_t i = 0; i < sizeof(steps) / sizeof(steps[0]) ;i++) {
+        STREAM_BINARY_FRAME f = { 0 };
+        buffer_flush(wb);
+        stream_binary_set_with_base(wb, &f, i, "dim", 3, steps[i].collected, steps[i].value, steps[i].flags,
+                                    &sender, steps[i].generation);
+        stream_binary_frame_close(wb, &f);
+
+        if(strlen(wb->buffer) != wb->len || strchr(wb->buffer, '\n') != &wb->buffer[wb->len - 1]) {
+            fprintf(stderr, "BINARY: delta step %zu is not escaped properly\n", i);
+            errors++;
+            continue;
+        }
+
+        bool corrupted;
+        STREAM_BINARY_READER r = binary_unittest_reader(wb, &corrupted);
+        char record = (char)stream_binary_get_byte(&r);
+        uint64_t slot = stream_binary_get_varint(&r);
+        const char *id = stream_binary_get_string(&r);
+        int64_t collected = stream_binary_get_zigzag(&r);
+        uint64_t flags_and_value = stream_binary_get_varint(&r);
+
+        bool applied = true;
+        if(record == STREAM_BINARY_RECORD_SET) {
+            collected_number collected_value = (collected_number)collected;
+            NETDATA_DOUBLE value = (flags_and_value & 1) ? stream_binary_get_double(&r) : (NETDATA_DOUBLE)collected_value;
+            stream_binary_delta_set(&receiver, steps[i].connection, collected_value, value);
+        }
+        else if(record == STREAM_BINARY_RECORD_DELTA) {
+            uint64_t value_xor = (flags_and_value & 1) ? stream_binary_get_xor(&r) : 0;
+            if(!r.error)
+                applied = stream_binary_delta_apply(&receiver, steps[i].connection,
+                                                    (uint64_t)collected, flags_and_value, value_xor);
+        }
+
+        if(corrupted || r.error || r.pos != r.end || record != steps[i].record || slot != i || strcmp(id, "dim") != 0 ||
+           (SN_FLAGS)(flags_and_value >> 1) != steps[i].flags ||
+           (flags_and_value & 1) != ((NETDATA_DOUBLE)steps[i].collected != steps[i].value) ||
+           applied != steps[i].applied) {
+            fprintf(stderr, "BINARY: delta step %zu got record '%c', applied %s\n", i, record, applied ? "true" : "false");
+            errors++;
+            continue;
+        }
+
+        if(applied && (receiver.collected != steps[i].collected ||
+                       receiver.value != stream_binary_double_bits(steps[i].value))) {
+            fprintf(stderr, "BINARY: delta step %zu decoded %lld and %f, expected %lld and %f\n", i,
+                    (long long)receiver.collected, (double)stream_binary_bits_double(receiver.value),
+                    (long long)steps[i].collected, (double)steps[i].value);
+            errors++;
+        }
+    }
+
+    return errors;
+}
+
+static int binary_unittest_rejected_frames(BUFFER *wb) {
+    int errors = 0;
+
+    PARSER *p = parser_init(NULL, NULL, NULL, -1, PARSER_INPUT_SPLIT, NULL);
+    pluginsd_keywords_init(p, PARSER_INIT_PLUGINSD | PARSER_INIT_STREAMING);
+
+    for(size_t test = 0; test < 4 ;test++) {
+        const char *name = NULL;
+        binary_unittest_frame_start(wb);
+
+        switch(test) {
+            case 0:
+                name = "a corrupted escape";
+                stream_binary_put_byte(wb, STREAM_BINARY_RECORD_END);
+                wb->buffer[wb->len++] = (char)STREAM_BINARY_ESCAPE;
+                break;
+
+            case 1:
+                name = "an unknown record type";
+                stream_binary_put_byte(wb, 'X');
+                break;
+
+            case 2:
+                name = "a truncated varint";
+                stream_binary_put_byte(wb, STREAM_BINARY_RECORD_BEGIN);
+                stream_binary_put_byte(wb, 0x80);
+                stream_binary_put_byte(wb, 0x80);
+                break;
+
+            case 3:
+                name = "a truncated 'S' record";
+                stream_binary_put_byte(wb, STREAM_BINARY_RECORD_SET);
+                stream_binary_put_varint(wb, 0);
+                stream_binary_put_string(wb, "dim", 3);
+                stream_binary_put_zigzag(wb, 5);
+                break;
+        }
+
+        binary_unittest_frame_end(wb);
+
+        p->user.enabled = 1;
+        PARSER_RC rc = pluginsd_binary_frame(p, wb->buffer);
+        if(rc != PARSER_RC_ERROR || p->user.enabled) {
+            fprintf(stderr, "BINARY: a frame with %s is not rejected\n", name);
+            errors++;
+        }
+    }
+
+    parser_destroy(p);
+    return errors;
+}
+
+int pluginsd_binary_unittest(void) {
+    int errors = 0;
+    BUFFER *wb = buffer_create(0, NULL);
+
+    errors += binary_unittest_numbers(wb);
+    errors += binary_unittest_escaping(wb);
+    errors += binary_unittest_frames(wb);
+    errors += binary_unittest_delta(wb);
+    errors += binary_unittest_rejected_frames(wb);
+
+    buffer_free(wb);
+
+    fprintf(stderr, "BINARY: wire format unittest %s\n", errors ? "FAILED" : "OK");
+    return errors;
+}
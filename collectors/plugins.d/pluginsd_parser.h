@@ -128,6 +128,10 @@ typedef struct parser {
 
     struct {
         SPINLOCK spinlock;
+        BUFFER *pending;            // set for non-blocking sockets, the data the socket could not take yet
+        size_t max_pending;         // the socket fails when more data are pending
+        int wake_fd;                // written to, to wake up the thread serving the socket
+        bool failed;
     } writer;
 
 } PARSER;
@@ -139,6 +143,11 @@ void pluginsd_cleanup_v2(PARSER *parser);
 void inflight_functions_init(PARSER *parser);
 void pluginsd_keywords_init(PARSER *parser, PARSER_REPERTOIRE repertoire);
 PARSER_RC parser_execute(PARSER *parser, PARSER_KEYWORD *keyword, char **words, size_t num_words);
+PARSER_RC pluginsd_binary_frame(PARSER *parser, char *frame);
+
+void parser_writer_nonblocking(PARSER *parser, size_t max_pending, int wake_fd);
+bool parser_writer_has_pending(PARSER *parser);
+bool parser_writer_flush(PARSER *parser);
 
 static inline int find_first_keyword(const char *src, char *dst, int dst_size, bool *isspace_map) {
     const char *s = src, *keyword_start;
@@ -206,6 +215,12 @@ static inline int parser_action(PARSER *parser, char *input) {
         return 0;
     }
 
+    if(unlikely((uint8_t)*input == STREAM_BINARY_FRAME_MARKER && stream_has_capability(&parser->user, STREAM_CAP_BINARY_DATA))) {
+        // BEGIN2 / SET2 / END2 in binary, without words to split
+        PARSER_RC rc = pluginsd_binary_frame(parser, input);
+        return (rc == PARSER_RC_ERROR || rc == PARSER_RC_STOP);
+    }
+
     parser->line.num_words = quoted_strings_splitter_pluginsd(input, parser->line.words, PLUGINSD_MAX_WORDS);
     const char *command = get_word(parser->line.words, parser->line.num_words, 0);
 
@@ -37,6 +37,33 @@ typedef struct statsd_metric_counter { // counter and meter
     collected_number value;
 } STATSD_METRIC_COUNTER;
 
+// a histogram sketch (DDSketch) - a mergeable quantile sketch with bounded memory and O(1) inserts
+// values are counted in buckets of logarithmically growing widths, so that all quantiles
+// are estimated within the configured relative accuracy
+
+#define STATSD_SKETCH_BUCKETS 2048
+
+typedef struct statsd_sketch_store {
+    int32_t offset;                 // the bucket index of counts[0]
+    int32_t min_index;              // the lowest bucket index used
+    int32_t max_index;              // the highest bucket index used
+    uint64_t count;
+    uint32_t *counts;               // STATSD_SKETCH_BUCKETS counters, allocated on first use
+} STATSD_SKETCH_STORE;
+
+typedef struct statsd_sketch {
+    STATSD_SKETCH_STORE positive;
+    STATSD_SKETCH_STORE negative;   // the absolute values of the negative values
+    uint64_t zeros;
+
+    uint64_t count;
+    NETDATA_DOUBLE min;
+    NETDATA_DOUBLE max;
+    NETDATA_DOUBLE sum;
+    NETDATA_DOUBLE mean;            // running mean and sum of squared differences (Welford)
+    NETDATA_DOUBLE m2;
+} STATSD_SKETCH;
+
 typedef struct statsd_histogram_extensions {
     netdata_mutex_t mutex;
 
@@ -60,6 +87,8 @@ typedef struct statsd_histogram_extensions {
     uint32_t size;
     uint32_t used;
     NETDATA_DOUBLE *values;   // dynamic array of values collected
+
+    STATSD_SKETCH *sketch;    // when set, values are collected in this sketch instead
 } STATSD_METRIC_HISTOGRAM_EXTENSIONS;
 
 typedef struct statsd_metric_histogram { // histogram and timer
@@ -68,6 +97,7 @@ typedef struct statsd_metric_histogram { // histogram and timer
 
 typedef struct statsd_metric_set {
     DICTIONARY *dict;
+    uint8_t *hll;           // when set, the values are counted in this hyperloglog instead
 } STATSD_METRIC_SET;
 
 typedef struct statsd_metric_dictionary_item {
@@ -77,6 +107,7 @@ typedef struct statsd_metric_dictionary_item {
 
 typedef struct statsd_metric_dictionary {
     DICTIONARY *dict;
+    uint8_t *hll;           // when set, the unique values are counted in this hyperloglog too
 } STATSD_METRIC_DICTIONARY;
 
 
@@ -279,6 +310,18 @@ static struct statsd {
     double histogram_percentile;
     char *histogram_percentile_str;
 
+    struct {
+        SIMPLE_PATTERN *metrics;    // the histograms and timers using sketches
+        double relative_accuracy;
+        NETDATA_DOUBLE gamma;
+        NETDATA_DOUBLE log_gamma;
+    } sketch;
+
+    struct {
+        SIMPLE_PATTERN *metrics;    // the sets and dictionaries using hyperloglog
+        uint8_t precision;          // the registers are 2^precision
+    } hyperloglog;
+
     int threads;
     struct collection_thread_status *collection_threads_status;
 
@@ -352,6 +395,14 @@ static struct statsd {
         .apps = NULL,
         .histogram_percentile = 95.0,
         .histogram_increase_step = 10,
+        .sketch = {
+                .metrics = NULL,
+                .relative_accuracy = 0.01,
+        },
+        .hyperloglog = {
+                .metrics = NULL,
+                .precision = 12,
+        },
         .dictionary_max_unique = 200,
         .threads = 0,
         .collection_threads_status = NULL,
@@ -383,6 +434,17 @@ static void dictionary_metric_insert_callback(const DICTIONARY_ITEM *item, void
     if (m->type == STATSD_METRIC_TYPE_HISTOGRAM || m->type == STATSD_METRIC_TYPE_TIMER) {
         m->histogram.ext = callocz(1,sizeof(STATSD_METRIC_HISTOGRAM_EXTENSIONS));
         netdata_mutex_init(&m->histogram.ext->mutex);
+
+        if(statsd.sketch.metrics && simple_pattern_matches(statsd.sketch.metrics, name))
+            m->histogram.ext->sketch = callocz(1, sizeof(STATSD_SKETCH));
+    }
+    else if(m->type == STATSD_METRIC_TYPE_SET) {
+        if(statsd.hyperloglog.metrics && simple_pattern_matches(statsd.hyperloglog.metrics, name))
+            m->set.hll = callocz((size_t)1 << statsd.hyperloglog.precision, sizeof(uint8_t));
+    }
+    else if(m->type == STATSD_METRIC_TYPE_DICTIONARY) {
+        if(statsd.hyperloglog.metrics && simple_pattern_matches(statsd.hyperloglog.metrics, name))
+            m->dictionary.hll = callocz((size_t)1 << statsd.hyperloglog.precision, sizeof(uint8_t));
     }
 
     __atomic_fetch_add(&index->metrics, 1, __ATOMIC_RELAXED);
@@ -394,9 +456,23 @@ static void dictionary_metric_delete_callback(const DICTIONARY_ITEM *item, void
     STATSD_METRIC *m = (STATSD_METRIC *)value;
 
     if(m->type == STATSD_METRIC_TYPE_HISTOGRAM || m->type == STATSD_METRIC_TYPE_TIMER) {
+        if(m->histogram.ext->sketch) {
+            freez(m->histogram.ext->sketch->positive.counts);
+            freez(m->histogram.ext->sketch->negative.counts);
+            freez(m->histogram.ext->sketch);
+        }
+        freez(m->histogram.ext->values);
         freez(m->histogram.ext);
         m->histogram.ext = NULL;
     }
+    else if(m->type == STATSD_METRIC_TYPE_SET) {
+        freez(m->set.hll);
+        m->set.hll = NULL;
+    }
+    else if(m->type == STATSD_METRIC_TYPE_DICTIONARY) {
+        freez(m->dictionary.hll);
+        m->dictionary.hll = NULL;
+    }
 
     freez(m->units);
     freez(m->family);
@@ -535,6 +611,147 @@ static inline void statsd_process_counter_or_meter(STATSD_METRIC *m, const char
 #define statsd_process_counter(m, value, sampling) statsd_process_counter_or_meter(m, value, sampling)
 #define statsd_process_meter(m, value, sampling) statsd_process_counter_or_meter(m, value, sampling)
 
+// --------------------------------------------------------------------------------------------------------------------
+// histogram sketches
+
+// values closer to zero than this are counted as zeros
+#define STATSD_SKETCH_MIN_VALUE 1e-9
+
+static inline int32_t statsd_sketch_index(NETDATA_DOUBLE v) {
+    return (int32_t)ceil(log(v) / statsd.sketch.log_gamma);
+}
+
+static inline NETDATA_DOUBLE statsd_sketch_value(int32_t index) {
+    return 2.0 * pow(statsd.sketch.gamma, (NETDATA_DOUBLE)index) / (statsd.sketch.gamma + 1.0);
+}
+
+static void statsd_sketch_store_move(STATSD_SKETCH_STORE *s, int32_t index, netdata_mutex_t *mutex) {
+    int32_t lo = (index < s->min_index) ? index : s->min_index;
+    int32_t hi = (index > s->max_index) ? index : s->max_index;
+
+    int32_t offset;
+    if(hi - lo < STATSD_SKETCH_BUCKETS)
+        // everything fits, center the used buckets
+        offset = lo - (STATSD_SKETCH_BUCKETS - (hi - lo + 1)) / 2;
+    else
+        // collapse the lowest buckets to the first one
+        offset = hi - STATSD_SKETCH_BUCKETS + 1;
+
+    uint32_t *counts = callocz(STATSD_SKETCH_BUCKETS, sizeof(uint32_t));
+    for(int32_t i = s->min_index; i <= s->max_index ;i++) {
+        int32_t to = (i < offset) ? offset : i;
+        counts[to - offset] += s->counts[i - s->offset];
+    }
+
+    // the flushing thread may be reading the buckets
+    netdata_mutex_lock(mutex);
+    freez(s->counts);
+    s->counts = counts;
+    s->offset = offset;
+    if(s->min_index < offset)
+        s->min_index = offset;
+    netdata_mutex_unlock(mutex);
+}
+
+static inline void statsd_sketch_store_add(STATSD_SKETCH_STORE *s, int32_t index, uint32_t n, netdata_mutex_t *mutex) {
+    if(unlikely(!s->counts)) {
+        netdata_mutex_lock(mutex);
+        s->counts = callocz(STATSD_SKETCH_BUCKETS, sizeof(uint32_t));
+        netdata_mutex_unlock(mutex);
+    }
+
+    if(unlikely(!s->count)) {
+        s->offset = index - STATSD_SKETCH_BUCKETS / 2;
+        s->min_index = s->max_index = index;
+    }
+    else if(unlikely(index < s->offset || index >= s->offset + STATSD_SKETCH_BUCKETS))
+        statsd_sketch_store_move(s, index, mutex);
+
+    if(unlikely(index < s->offset))
+        index = s->offset;
+
+    s->counts[index - s->offset] += n;
+    s->count += n;
+
+    if(index < s->min_index) s->min_index = index;
+    if(index > s->max_index) s->max_index = index;
+}
+
+static inline void statsd_sketch_store_reset(STATSD_SKETCH_STORE *s) {
+    if(s->count)
+        memset(&s->counts[s->min_index - s->offset], 0, (s->max_index - s->min_index + 1) * sizeof(uint32_t));
+
+    s->count = 0;
+}
+
+static inline void statsd_sketch_add(STATSD_SKETCH *sk, NETDATA_DOUBLE v, uint32_t n, netdata_mutex_t *mutex) {
+    if(v > STATSD_SKETCH_MIN_VALUE)
+        statsd_sketch_store_add(&sk->positive, statsd_sketch_index(v), n, mutex);
+    else if(v < -STATSD_SKETCH_MIN_VALUE)
+        statsd_sketch_store_add(&sk->negative, statsd_sketch_index(-v), n, mutex);
+    else
+        sk->zeros += n;
+
+    if(unlikely(!sk->count))
+        sk->min = sk->max = v;
+    else {
+        if(v < sk->min) sk->min = v;
+        if(v > sk->max) sk->max = v;
+    }
+
+    sk->count += n;
+    sk->sum += v * n;
+
+    NETDATA_DOUBLE delta = v - sk->mean;
+    sk->mean += delta * n / (NETDATA_DOUBLE)sk->count;
+    sk->m2 += delta * (v - sk->mean) * n;
+}
+
+static inline void statsd_sketch_reset(STATSD_SKETCH *sk) {
+    statsd_sketch_store_reset(&sk->positive);
+    statsd_sketch_store_reset(&sk->negative);
+    sk->zeros = 0;
+    sk->count = 0;
+    sk->min = sk->max = sk->sum = sk->mean = sk->m2 = 0.0;
+}
+
+// the value at the given rank (0 based), as if the values were sorted
+static NETDATA_DOUBLE statsd_sketch_value_at_rank(STATSD_SKETCH *sk, uint64_t rank) {
+    NETDATA_DOUBLE v = sk->max;
+    uint64_t seen = 0;
+
+    if(sk->negative.count) {
+        for(int32_t i = sk->negative.max_index; i >= sk->negative.min_index ;i--) {
+            seen += sk->negative.counts[i - sk->negative.offset];
+            if(seen > rank) {
+                v = -statsd_sketch_value(i);
+                goto done;
+            }
+        }
+    }
+
+    seen += sk->zeros;
+    if(seen > rank) {
+        v = 0.0;
+        goto done;
+    }
+
+    if(sk->positive.count) {
+        for(int32_t i = sk->positive.min_index; i <= sk->positive.max_index ;i++) {
+            seen += sk->positive.counts[i - sk->positive.offset];
+            if(seen > rank) {
+                v = statsd_sketch_value(i);
+                goto done;
+            }
+        }
+    }
+
+done:
+    if(v < sk->min) v = sk->min;
+    if(v > sk->max) v = sk->max;
+    return v;
+}
+
 static inline void statsd_process_histogram_or_timer(STATSD_METRIC *m, const char *value, const char *sampling, const char *type) {
     if(!is_metric_useful_for_collection(m)) return;
 
@@ -545,6 +762,8 @@ static inline void statsd_process_histogram_or_timer(STATSD_METRIC *m, const cha
 
     if(unlikely(m->reset)) {
         m->histogram.ext->used = 0;
+        if(m->histogram.ext->sketch)
+            statsd_sketch_reset(m->histogram.ext->sketch);
         statsd_reset_metric(m);
     }
 
@@ -558,16 +777,25 @@ static inline void statsd_process_histogram_or_timer(STATSD_METRIC *m, const cha
         if(unlikely(isgreater(sampling_rate, 1.0))) sampling_rate = 1.0;
 
         long long samples = llrintndd(1.0 / sampling_rate);
-        while(samples-- > 0) {
 
-            if(unlikely(m->histogram.ext->used == m->histogram.ext->size)) {
-                netdata_mutex_lock(&m->histogram.ext->mutex);
-                m->histogram.ext->size += statsd.histogram_increase_step;
-                m->histogram.ext->values = reallocz(m->histogram.ext->values, sizeof(NETDATA_DOUBLE) * m->histogram.ext->size);
-                netdata_mutex_unlock(&m->histogram.ext->mutex);
-            }
+        if(m->histogram.ext->sketch) {
+            // the buckets count in 32 bits
+            uint32_t n = (samples < 1) ? 1 : (samples > UINT32_MAX) ? UINT32_MAX : (uint32_t)samples;
+            statsd_sketch_add(m->histogram.ext->sketch, v, n, &m->histogram.ext->mutex);
+        }
+
+        else {
+            while(samples-- > 0) {
+
+                if(unlikely(m->histogram.ext->used == m->histogram.ext->size)) {
+                    netdata_mutex_lock(&m->histogram.ext->mutex);
+                    m->histogram.ext->size += statsd.histogram_increase_step;
+                    m->histogram.ext->values = reallocz(m->histogram.ext->values, sizeof(NETDATA_DOUBLE) * m->histogram.ext->size);
+                    netdata_mutex_unlock(&m->histogram.ext->mutex);
+                }
 
-            m->histogram.ext->values[m->histogram.ext->used++] = v;
+                m->histogram.ext->values[m->histogram.ext->used++] = v;
+            }
         }
 
         metric_update_counters_and_obsoletion(m);
@@ -577,6 +805,76 @@ static inline void statsd_process_histogram_or_timer(STATSD_METRIC *m, const cha
 #define statsd_process_timer(m, value, sampling) statsd_process_histogram_or_timer(m, value, sampling, "timer")
 #define statsd_process_histogram(m, value, sampling) statsd_process_histogram_or_timer(m, value, sampling, "histogram")
 
+// --------------------------------------------------------------------------------------------------------------------
+// hyperloglog - approximate count of unique values, in 2^precision bytes per metric
+
+static inline void statsd_hyperloglog_add(uint8_t *registers, const char *value) {
+    uint8_t p = statsd.hyperloglog.precision;
+    uint64_t hash = XXH3_64bits(value, strlen(value));
+
+    // the first p bits select the register, the rest give the rank
+    // the guard bit limits the rank to 64 - p + 1
+    size_t index = (size_t)(hash >> (64 - p));
+    uint8_t rank = (uint8_t)(__builtin_clzll((hash << p) | ((uint64_t)1 << (p - 1))) + 1);
+
+    if(rank > registers[index])
+        registers[index] = rank;
+}
+
+// the improved raw estimator of Otmar Ertl, "New cardinality estimation algorithms for HyperLogLog sketches" (2017)
+// it is accurate for all cardinalities, without switching to linear counting and without bias correction tables
+
+static NETDATA_DOUBLE statsd_hyperloglog_sigma(NETDATA_DOUBLE x) {
+    if(x == 1.0)
+        return INFINITY;
+
+    NETDATA_DOUBLE y = 1.0, z = x, z_prev;
+    do {
+        x *= x;
+        z_prev = z;
+        z += x * y;
+        y += y;
+    } while(z != z_prev);
+
+    return z;
+}
+
+static NETDATA_DOUBLE statsd_hyperloglog_tau(NETDATA_DOUBLE x) {
+    if(x == 0.0 || x == 1.0)
+        return 0.0;
+
+    NETDATA_DOUBLE y = 1.0, z = 1.0 - x, z_prev;
+    do {
+        x = sqrt(x);
+        z_prev = z;
+        y *= 0.5;
+        z -= (1.0 - x) * (1.0 - x) * y;
+    } while(z != z_prev);
+
+    return z / 3.0;
+}
+
+static NETDATA_DOUBLE statsd_hyperloglog_estimate(uint8_t *registers) {
+    uint8_t p = statsd.hyperloglog.precision;
+    size_t m = (size_t)1 << p;
+    int q = 64 - p;
+
+    // the number of registers with each rank - ranks go up to q + 1
+    size_t histogram[64 + 2] = { 0 };
+    for(size_t i = 0; i < m ;i++)
+        histogram[registers[i]]++;
+
+    if(histogram[0] == m)
+        return 0.0;
+
+    NETDATA_DOUBLE z = (NETDATA_DOUBLE)m * statsd_hyperloglog_tau(1.0 - (NETDATA_DOUBLE)histogram[q + 1] / (NETDATA_DOUBLE)m);
+    for(int k = q; k >= 1 ;k--)
+        z = 0.5 * (z + (NETDATA_DOUBLE)histogram[k]);
+    z += (NETDATA_DOUBLE)m * statsd_hyperloglog_sigma((NETDATA_DOUBLE)histogram[0] / (NETDATA_DOUBLE)m);
+
+    return (NETDATA_DOUBLE)m / (2.0 * log(2.0)) * (NETDATA_DOUBLE)m / z;
+}
+
 static inline void statsd_process_set(STATSD_METRIC *m, const char *value) {
     if(!is_metric_useful_for_collection(m)) return;
 
@@ -590,15 +888,22 @@ static inline void statsd_process_set(STATSD_METRIC *m, const char *value) {
             dictionary_destroy(m->set.dict);
             m->set.dict = NULL;
         }
+        if(m->set.hll)
+            memset(m->set.hll, 0, (size_t)1 << statsd.hyperloglog.precision);
+
         statsd_reset_metric(m);
     }
 
-    if (unlikely(!m->set.dict))
+    if (unlikely(!m->set.dict && !m->set.hll))
         m->set.dict = dictionary_create_advanced(STATSD_DICTIONARY_OPTIONS, &dictionary_stats_category_collectors, 0);
 
     if(unlikely(value_is_zinit(value))) {
         // magic loading of metric, without affecting anything
     }
+    else if(m->set.hll) {
+        statsd_hyperloglog_add(m->set.hll, value);
+        metric_update_counters_and_obsoletion(m);
+    }
     else {
 #ifdef STATSD_MULTITHREADED
         // avoid the write lock to check if something is already there
@@ -629,6 +934,9 @@ static inline void statsd_process_dictionary(STATSD_METRIC *m, const char *value
         // magic loading of metric, without affecting anything
     }
     else {
+        if(m->dictionary.hll)
+            statsd_hyperloglog_add(m->dictionary.hll, value);
+
         STATSD_METRIC_DICTIONARY_ITEM *t = (STATSD_METRIC_DICTIONARY_ITEM *)dictionary_get(m->dictionary.dict, value);
 
         if (unlikely(!t)) {
@@ -1922,7 +2230,10 @@ static inline void statsd_flush_set(STATSD_METRIC *m) {
 
     int updated = 0;
     if(unlikely(!m->reset && m->count)) {
-        m->last = (collected_number)dictionary_entries(m->set.dict);
+        if(m->set.hll)
+            m->last = (collected_number)roundndd(statsd_hyperloglog_estimate(m->set.hll));
+        else
+            m->last = (collected_number)dictionary_entries(m->set.dict);
 
         m->reset = 1;
         updated = 1;
@@ -1942,7 +2253,12 @@ static inline void statsd_flush_dictionary(STATSD_METRIC *m) {
 
     int updated = 0;
     if(unlikely(!m->reset && m->count)) {
-        m->last = (collected_number)dictionary_entries(m->dictionary.dict);
+        // values beyond the max unique dimensions are grouped as 'other',
+        // but the hyperloglog still counts them
+        if(m->dictionary.hll)
+            m->last = (collected_number)roundndd(statsd_hyperloglog_estimate(m->dictionary.hll));
+        else
+            m->last = (collected_number)dictionary_entries(m->dictionary.dict);
 
         m->reset = 1;
         updated = 1;
@@ -1971,7 +2287,27 @@ static inline void statsd_flush_timer_or_histogram(STATSD_METRIC *m, const char
     netdata_log_debug(D_STATSD, "flushing %s metric '%s'", dim, m->name);
 
     int updated = 0;
-    if(unlikely(!m->reset && m->count && m->histogram.ext->used > 0)) {
+    STATSD_SKETCH *sk = m->histogram.ext->sketch;
+    if(unlikely(!m->reset && m->count && sk && sk->count > 0)) {
+        netdata_mutex_lock(&m->histogram.ext->mutex);
+
+        m->histogram.ext->last_min = (collected_number)roundndd(sk->min * statsd.decimal_detail);
+        m->histogram.ext->last_max = (collected_number)roundndd(sk->max * statsd.decimal_detail);
+        m->last = (collected_number)roundndd(sk->sum / (NETDATA_DOUBLE)sk->count * statsd.decimal_detail);
+        m->histogram.ext->last_median = (collected_number)roundndd(statsd_sketch_value_at_rank(sk, (sk->count - 1) / 2) * statsd.decimal_detail);
+        m->histogram.ext->last_stddev = (collected_number)roundndd(((sk->count == 1) ? sk->min : sqrtndd(sk->m2 / (NETDATA_DOUBLE)sk->count)) * statsd.decimal_detail);
+        m->histogram.ext->last_sum = (collected_number)roundndd(sk->sum * statsd.decimal_detail);
+
+        uint64_t pct_len = (uint64_t)floor((double)sk->count * statsd.histogram_percentile / 100.0);
+        m->histogram.ext->last_percentile = (collected_number)roundndd(statsd_sketch_value_at_rank(sk, (pct_len < 1) ? 0 : pct_len - 1) * statsd.decimal_detail);
+
+        netdata_mutex_unlock(&m->histogram.ext->mutex);
+
+        m->histogram.ext->zeroed = 0;
+        m->reset = 1;
+        updated = 1;
+    }
+    else if(unlikely(!m->reset && m->count && m->histogram.ext->used > 0)) {
         netdata_mutex_lock(&m->histogram.ext->mutex);
 
         size_t len = m->histogram.ext->used;
@@ -2518,6 +2854,31 @@ void *statsd_main(void *ptr) {
         statsd.histogram_percentile_str = strdupz(buffer);
     }
 
+    statsd.sketch.metrics = simple_pattern_create(
+            config_get(CONFIG_SECTION_STATSD, "histograms and timers using sketches", ""), NULL,
+            SIMPLE_PATTERN_EXACT, true);
+
+    statsd.sketch.relative_accuracy = (double)config_get_float(CONFIG_SECTION_STATSD, "histograms and timers sketch relative accuracy", statsd.sketch.relative_accuracy);
+    if(!isgreater(statsd.sketch.relative_accuracy, 0) || !isless(statsd.sketch.relative_accuracy, 1)) {
+        collector_error("STATSD: invalid histograms and timers sketch relative accuracy %0.5f given", statsd.sketch.relative_accuracy);
+        statsd.sketch.relative_accuracy = 0.01;
+    }
+    statsd.sketch.gamma = (1.0 + statsd.sketch.relative_accuracy) / (1.0 - statsd.sketch.relative_accuracy);
+    statsd.sketch.log_gamma = log(statsd.sketch.gamma);
+
+    statsd.hyperloglog.metrics = simple_pattern_create(
+            config_get(CONFIG_SECTION_STATSD, "sets and dictionaries using hyperloglog", ""), NULL,
+            SIMPLE_PATTERN_EXACT, true);
+
+    {
+        long long precision = config_get_number(CONFIG_SECTION_STATSD, "sets and dictionaries hyperloglog precision", statsd.hyperloglog.precision);
+        if(precision < 4 || precision > 18) {
+            collector_error("STATSD: invalid sets and dictionaries hyperloglog precision %lld given, it must be between 4 and 18", precision);
+            precision = 12;
+        }
+        statsd.hyperloglog.precision = (uint8_t)precision;
+    }
+
     statsd.dictionary_max_unique = config_get_number(CONFIG_SECTION_STATSD, "dictionaries max unique dimensions", statsd.dictionary_max_unique);
 
     if(config_get_boolean(CONFIG_SECTION_STATSD, "add dimension for number of events received", 0)) {
@@ -2891,3 +3252,279 @@ cleanup: ; // added semi-colon to prevent older gcc error: label at end of compo
     netdata_thread_cleanup_pop(1);
     return NULL;
 }
+
+// --------------------------------------------------------------------------------------------------------------------
+// unittests
+
+static uint64_t statsd_unittest_random(uint64_t *state) {
+    // xorshift64, so that the tests are repeatable
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return *state = x;
+}
+
+static NETDATA_DOUBLE statsd_unittest_random_double(uint64_t *state, NETDATA_DOUBLE min, NETDATA_DOUBLE max) {
+    return min + (max - min) * (NETDATA_DOUBLE)(statsd_unittest_random(state) >> 11) / (NETDATA_DOUBLE)(1ULL << 53);
+}
+
+static int statsd_sketch_unittest_check(const char *name, STATSD_SKETCH *sk, NETDATA_DOUBLE *values, size_t entries) {
+    int errors = 0;
+
+    sort_series(values, entries);
+
+    if(sk->count != entries || sk->min != values[0] || sk->max != values[entries - 1]) {
+        fprintf(stderr, "STATSD SKETCH: %s: count %"PRIu64", min %f, max %f, expected count %zu, min %f, max %f\n",
+                name, sk->count, (double)sk->min, (double)sk->max, entries, (double)values[0], (double)values[entries - 1]);
+        errors++;
+    }
+
+    // values collapsed to the lowest bucket are estimated above their real value
+    int32_t collapsed = (sk->positive.count) ? sk->positive.offset : INT32_MIN;
+
+    NETDATA_DOUBLE alpha = statsd.sketch.relative_accuracy * (1.0 + 1e-9);
+    for(size_t rank = 0; rank < entries ;rank++) {
+        NETDATA_DOUBLE exact = values[rank];
+        NETDATA_DOUBLE v = statsd_sketch_value_at_rank(sk, rank);
+
+        bool ok;
+        if(exact > STATSD_SKETCH_MIN_VALUE && statsd_sketch_index(exact) < collapsed)
+            ok = v >= exact && v <= statsd_sketch_value(collapsed) * (1.0 + 1e-9);
+        else
+            ok = fabsndd(v - exact) <= alpha * fabsndd(exact) + STATSD_SKETCH_MIN_VALUE;
+
+        if(!ok) {
+            fprintf(stderr, "STATSD SKETCH: %s: the value at rank %zu is %f, expected %f within %0.2f%%\n",
+                    name, rank, (double)v, (double)exact, (double)(statsd.sketch.relative_accuracy * 100.0));
+            errors++;
+            break;
+        }
+    }
+
+    return errors;
+}
+
+static void statsd_sketch_unittest_free(STATSD_SKETCH *sk) {
+    freez(sk->positive.counts);
+    freez(sk->negative.counts);
+    memset(sk, 0, sizeof(*sk));
+}
+
+static int statsd_sketch_unittest_distributions(netdata_mutex_t *mutex) {
+    int errors = 0;
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    size_t entries = 10000;
+    NETDATA_DOUBLE *values = mallocz(entries * sizeof(NETDATA_DOUBLE));
+    STATSD_SKETCH sk = { 0 };
+
+    for(int distribution = 0; distribution < 4 ;distribution++) {
+        const char *name;
+
+        for(size_t i = 0; i < entries ;i++) {
+            switch(distribution) {
+                default:
+                case 0:
+                    name = "uniform";
+                    values[i] = (NETDATA_DOUBLE)(1 + statsd_unittest_random(&state) % 1000);
+                    break;
+
+                case 1:
+                    name = "log-uniform";
+                    values[i] = pow(10.0, statsd_unittest_random_double(&state, -3.0, 6.0));
+                    break;
+
+                case 2:
+                    // negatives, zeros and values too close to zero
+                    name = "mixed sign";
+                    switch(i % 10) {
+                        case 0: values[i] = 0.0; break;
+                        case 1: values[i] = 1e-12; break;
+                        case 2: values[i] = -1e-12; break;
+                        default: values[i] = statsd_unittest_random_double(&state, -1000.0, 1000.0); break;
+                    }
+                    break;
+
+                case 3:
+                    name = "negative";
+                    values[i] = -pow(10.0, statsd_unittest_random_double(&state, -3.0, 6.0));
+                    break;
+            }
+
+            statsd_sketch_add(&sk, values[i], 1, mutex);
+        }
+
+        errors += statsd_sketch_unittest_check(name, &sk, values, entries);
+
+        // a reset sketch must be usable again
+        statsd_sketch_reset(&sk);
+    }
+
+    statsd_sketch_unittest_free(&sk);
+
+    // sampled values are counted once per sample
+    size_t e = 0;
+    for(size_t i = 1; i <= 100 ;i++) {
+        statsd_sketch_add(&sk, (NETDATA_DOUBLE)i, 100, mutex);
+        for(size_t j = 0; j < 100 ;j++)
+            values[e++] = (NETDATA_DOUBLE)i;
+    }
+    errors += statsd_sketch_unittest_check("sampled", &sk, values, e);
+    statsd_sketch_unittest_free(&sk);
+
+    freez(values);
+    return errors;
+}
+
+static int statsd_sketch_unittest_store(netdata_mutex_t *mutex) {
+    int errors = 0;
+    uint64_t state = 0x2545F4914F6CDD1DULL;
+    STATSD_SKETCH sk = { 0 };
+
+    // the first value centers the store, the next ones move it without losing anything
+    NETDATA_DOUBLE moving[] = { 1.0, 1e10, 1e-6, 1e10, 1.0 };
+    size_t entries = sizeof(moving) / sizeof(moving[0]);
+    for(size_t i = 0; i < entries ;i++)
+        statsd_sketch_add(&sk, moving[i], 1, mutex);
+
+    if(statsd_sketch_index(1e10) - statsd_sketch_index(1e-6) >= STATSD_SKETCH_BUCKETS) {
+        fprintf(stderr, "STATSD SKETCH: the moving test values do not fit in the store\n");
+        errors++;
+    }
+    errors += statsd_sketch_unittest_check("moving", &sk, moving, entries);
+    statsd_sketch_unittest_free(&sk);
+
+    // values spanning more buckets than the store has, collapse the lowest ones
+    entries = 10000;
+    NETDATA_DOUBLE *values = mallocz(entries * sizeof(NETDATA_DOUBLE));
+    for(size_t i = 0; i < entries ;i++) {
+        values[i] = pow(10.0, statsd_unittest_random_double(&state, -6.0, 15.0));
+        statsd_sketch_add(&sk, values[i], 1, mutex);
+    }
+
+    if(statsd_sketch_index(1e15) - statsd_sketch_index(1e-6) < STATSD_SKETCH_BUCKETS) {
+        fprintf(stderr, "STATSD SKETCH: the collapsing test values fit in the store\n");
+        errors++;
+    }
+
+    if(sk.positive.count != entries ||
+        sk.positive.min_index < sk.positive.offset ||
+        sk.positive.max_index >= sk.positive.offset + STATSD_SKETCH_BUCKETS ||
+        sk.positive.max_index != statsd_sketch_index(sk.max)) {
+        fprintf(stderr, "STATSD SKETCH: collapsed store has count %"PRIu64", offset %d, min index %d, max index %d\n",
+                sk.positive.count, sk.positive.offset, sk.positive.min_index, sk.positive.max_index);
+        errors++;
+    }
+
+    errors += statsd_sketch_unittest_check("collapsing", &sk, values, entries);
+    statsd_sketch_unittest_free(&sk);
+
+    freez(values);
+    return errors;
+}
+
+int statsd_sketch_unittest(void) {
+    int errors = 0;
+    netdata_mutex_t mutex;
+    netdata_mutex_init(&mutex);
+
+    NETDATA_DOUBLE relative_accuracy = statsd.sketch.relative_accuracy;
+    NETDATA_DOUBLE gamma = statsd.sketch.gamma;
+    NETDATA_DOUBLE log_gamma = statsd.sketch.log_gamma;
+
+    NETDATA_DOUBLE accuracies[] = { 0.01, 0.05 };
+    for(size_t i = 0; i < sizeof(accuracies) / sizeof(accuracies[0]) ;i++) {
+        statsd.sketch.relative_accuracy = accuracies[i];
+        statsd.sketch.gamma = (1.0 + statsd.sketch.relative_accuracy) / (1.0 - statsd.sketch.relative_accuracy);
+        statsd.sketch.log_gamma = log(statsd.sketch.gamma);
+
+        errors += statsd_sketch_unittest_distributions(&mutex);
+
+        // the store tests need the default accuracy to span more than the buckets
+        if(accuracies[i] == 0.01)
+            errors += statsd_sketch_unittest_store(&mutex);
+    }
+
+    statsd.sketch.relative_accuracy = relative_accuracy;
+    statsd.sketch.gamma = gamma;
+    statsd.sketch.log_gamma = log_gamma;
+
+    netdata_mutex_destroy(&mutex);
+
+    fprintf(stderr, "STATSD: histogram sketch unittest %s\n", errors ? "FAILED" : "OK");
+    return errors;
+}
+
+static int statsd_hyperloglog_unittest_precision(uint8_t precision) {
+    int errors = 0;
+    size_t m = (size_t)1 << precision;
+    uint8_t *registers = callocz(m, sizeof(uint8_t));
+    uint8_t *copy = mallocz(m * sizeof(uint8_t));
+    char value[30];
+
+    statsd.hyperloglog.precision = precision;
+
+    // the standard error of hyperloglog is 1.04 / sqrt(m), allow 3 of them,
+    // plus one value for the few registers shared by small counts
+    NETDATA_DOUBLE max_error = 3.0 * 1.04 / sqrt((NETDATA_DOUBLE)m);
+
+    // the classic estimator switches to linear counting at 2.5 * m, check around it too
+    size_t checkpoints[] = { 1, 10, 100, 1000, 2 * m, 5 * m / 2 - m / 8, 5 * m / 2 + m / 8, 4 * m, 10000, 100000, 1000000 };
+
+    if(statsd_hyperloglog_estimate(registers) != 0.0) {
+        fprintf(stderr, "STATSD HYPERLOGLOG: precision %u, empty registers estimate %f\n",
+                precision, (double)statsd_hyperloglog_estimate(registers));
+        errors++;
+    }
+
+    size_t added = 0;
+    for(size_t c = 0; c < sizeof(checkpoints) / sizeof(checkpoints[0]) ;c++) {
+        size_t n = checkpoints[c];
+        if(n <= added)
+            continue;
+
+        for(; added < n ;added++) {
+            snprintfz(value, sizeof(value) - 1, "value-%zu", added);
+            statsd_hyperloglog_add(registers, value);
+        }
+
+        NETDATA_DOUBLE estimate = statsd_hyperloglog_estimate(registers);
+        if(fabsndd(estimate - (NETDATA_DOUBLE)n) > max_error * (NETDATA_DOUBLE)n + 1.0) {
+            fprintf(stderr, "STATSD HYPERLOGLOG: precision %u, %zu unique values are estimated as %f, more than %0.2f%% off\n",
+                    precision, n, (double)estimate, (double)(max_error * 100.0));
+            errors++;
+        }
+
+        // adding the same values again must not change anything
+        memcpy(copy, registers, m * sizeof(uint8_t));
+        for(size_t i = 0; i < n ;i++) {
+            snprintfz(value, sizeof(value) - 1, "value-%zu", i);
+            statsd_hyperloglog_add(registers, value);
+        }
+
+        if(memcmp(copy, registers, m * sizeof(uint8_t)) != 0 || statsd_hyperloglog_estimate(registers) != estimate) {
+            fprintf(stderr, "STATSD HYPERLOGLOG: precision %u, adding %zu values again changed the estimate from %f to %f\n",
+                    precision, n, (double)estimate, (double)statsd_hyperloglog_estimate(registers));
+            errors++;
+        }
+    }
+
+    freez(copy);
+    freez(registers);
+    return errors;
+}
+
+int statsd_hyperloglog_unittest(void) {
+    int errors = 0;
+    uint8_t precision = statsd.hyperloglog.precision;
+
+    // the lowest, the default and the highest precision accepted in the configuration
+    errors += statsd_hyperloglog_unittest_precision(4);
+    errors += statsd_hyperloglog_unittest_precision(12);
+    errors += statsd_hyperloglog_unittest_precision(18);
+
+    statsd.hyperloglog.precision = precision;
+
+    fprintf(stderr, "STATSD: hyperloglog unittest %s\n", errors ? "FAILED" : "OK");
+    return errors;
+}
@@ -673,6 +673,44 @@ static void global_statistics_charts(void) {
 
     // ----------------------------------------------------------------
 
+    {
+        static RRDSET *st_query_cache = NULL;
+        static RRDDIM *rd_hits = NULL,
+                      *rd_misses = NULL,
+                      *rd_evictions = NULL;
+
+        if (unlikely(!st_query_cache)) {
+            st_query_cache = rrdset_create_localhost(
+                    "netdata"
+                    , "query_cache"
+                    , NULL
+                    , "api"
+                    , NULL
+                    , "Netdata API Query Cache"
+                    , "queries/s"
+                    , "netdata"
+                    , "stats"
+                    , 130700
+                    , localhost->rrd_update_every
+                    , RRDSET_TYPE_LINE
+            );
+
+            rd_hits = rrddim_add(st_query_cache, "hits", NULL, 1, 1, RRD_ALGORITHM_INCREMENTAL);
+            rd_misses = rrddim_add(st_query_cache, "misses", NULL, 1, 1, RRD_ALGORITHM_INCREMENTAL);
+            rd_evictions = rrddim_add(st_query_cache, "evictions", NULL, 1, 1, RRD_ALGORITHM_INCREMENTAL);
+        }
+
+        size_t hits, misses, evictions;
+        query_cache_statistics(&hits, &misses, &evictions);
+
+        rrddim_set_by_pointer(st_query_cache, rd_hits, (collected_number)hits);
+        rrddim_set_by_pointer(st_query_cache, rd_misses, (collected_number)misses);
+        rrddim_set_by_pointer(st_query_cache, rd_evictions, (collected_number)evictions);
+        rrdset_done(st_query_cache);
+    }
+
+    // ----------------------------------------------------------------
+
     {
         static RRDSET *st_queries = NULL;
         static RRDDIM *rd_api_data_queries = NULL;
@@ -1301,6 +1339,12 @@ struct dbengine2_cache_pointers {
     RRDDIM *rd_pgc_waste_delete_spins;
     RRDDIM *rd_pgc_waste_flush_spins;
 
+    RRDSET *st_pgc_clean_queue;
+    RRDDIM *rd_pgc_clean_queue_hits_protected;
+    RRDDIM *rd_pgc_clean_queue_hits_probation;
+    RRDDIM *rd_pgc_clean_queue_promoted;
+    RRDDIM *rd_pgc_clean_queue_probation_evicted;
+
 };
 
 static void dbengine2_cache_statistics_charts(struct dbengine2_cache_pointers *ptrs, struct pgc_statistics *pgc_stats, struct pgc_statistics *pgc_stats_old __maybe_unused, const char *name, int priority) {
@@ -1731,6 +1775,50 @@ static void dbengine2_cache_statistics_charts(struct dbengine2_cache_pointers *p
         rrdset_done(ptrs->st_pgc_waste);
     }
 
+    {
+        if (unlikely(!ptrs->st_pgc_clean_queue)) {
+            BUFFER *id = buffer_create(100, NULL);
+            buffer_sprintf(id, "dbengine_%s_clean_queue", name);
+
+            BUFFER *family = buffer_create(100, NULL);
+            buffer_sprintf(family, "dbengine %s cache", name);
+
+            BUFFER *title = buffer_create(100, NULL);
+            buffer_sprintf(title, "Netdata %s Clean Queue Hits and Eviction Policy Events", name);
+
+            ptrs->st_pgc_clean_queue = rrdset_create_localhost(
+                    "netdata",
+                    buffer_tostring(id),
+                    NULL,
+                    buffer_tostring(family),
+                    NULL,
+                    buffer_tostring(title),
+                    "events/s",
+                    "netdata",
+                    "stats",
+                    priority,
+                    localhost->rrd_update_every,
+                    RRDSET_TYPE_LINE);
+
+            ptrs->rd_pgc_clean_queue_hits_protected    = rrddim_add(ptrs->st_pgc_clean_queue, "protected hits", NULL, 1, 1, RRD_ALGORITHM_INCREMENTAL);
+            ptrs->rd_pgc_clean_queue_hits_probation    = rrddim_add(ptrs->st_pgc_clean_queue, "probation hits", NULL, 1, 1, RRD_ALGORITHM_INCREMENTAL);
+            ptrs->rd_pgc_clean_queue_promoted          = rrddim_add(ptrs->st_pgc_clean_queue, "promoted", NULL, 1, 1, RRD_ALGORITHM_INCREMENTAL);
+            ptrs->rd_pgc_clean_queue_probation_evicted = rrddim_add(ptrs->st_pgc_clean_queue, "evicted from probation", NULL, -1, 1, RRD_ALGORITHM_INCREMENTAL);
+
+            buffer_free(id);
+            buffer_free(family);
+            buffer_free(title);
+            priority++;
+        }
+
+        rrddim_set_by_pointer(ptrs->st_pgc_clean_queue, ptrs->rd_pgc_clean_queue_hits_protected, (collected_number)pgc_stats->clean_hits_protected);
+        rrddim_set_by_pointer(ptrs->st_pgc_clean_queue, ptrs->rd_pgc_clean_queue_hits_probation, (collected_number)pgc_stats->clean_hits_probation);
+        rrddim_set_by_pointer(ptrs->st_pgc_clean_queue, ptrs->rd_pgc_clean_queue_promoted, (collected_number)pgc_stats->probation_promoted);
+        rrddim_set_by_pointer(ptrs->st_pgc_clean_queue, ptrs->rd_pgc_clean_queue_probation_evicted, (collected_number)pgc_stats->probation_evicted);
+
+        rrdset_done(ptrs->st_pgc_clean_queue);
+    }
+
     {
         if (unlikely(!ptrs->st_pgc_workers)) {
             BUFFER *id = buffer_create(100, NULL);
@@ -1812,7 +1900,8 @@ static void dbengine2_statistics_charts(void) {
 
     struct rrdeng_buffer_sizes buffers = rrdeng_get_buffer_sizes();
     size_t buffers_total_size = buffers.handles + buffers.xt_buf + buffers.xt_io + buffers.pdc + buffers.descriptors +
-            buffers.opcodes + buffers.wal + buffers.workers + buffers.epdl + buffers.deol + buffers.pd + buffers.pgc + buffers.mrg;
+            buffers.opcodes + buffers.wal + buffers.workers + buffers.epdl + buffers.deol + buffers.pd + buffers.pgc + buffers.mrg +
+            buffers.journal_filters;
 
 #ifdef PDC_USE_JULYL
     buffers_total_size += buffers.julyl;
@@ -1878,6 +1967,7 @@ static void dbengine2_statistics_charts(void) {
         static RRDDIM *rd_pgc_buffers_epdl = NULL;
         static RRDDIM *rd_pgc_buffers_deol = NULL;
         static RRDDIM *rd_pgc_buffers_pd = NULL;
+        static RRDDIM *rd_pgc_buffers_journal_filters = NULL;
 #ifdef PDC_USE_JULYL
         static RRDDIM *rd_pgc_buffers_julyl = NULL;
 #endif
@@ -1910,6 +2000,7 @@ static void dbengine2_statistics_charts(void) {
             rd_pgc_buffers_xt_buf      = rrddim_add(st_pgc_buffers, "extent buffers", NULL, 1, 1, RRD_ALGORITHM_ABSOLUTE);
             rd_pgc_buffers_epdl        = rrddim_add(st_pgc_buffers, "epdl",           NULL, 1, 1, RRD_ALGORITHM_ABSOLUTE);
             rd_pgc_buffers_deol        = rrddim_add(st_pgc_buffers, "deol",           NULL, 1, 1, RRD_ALGORITHM_ABSOLUTE);
+            rd_pgc_buffers_journal_filters = rrddim_add(st_pgc_buffers, "journal filters", NULL, 1, 1, RRD_ALGORITHM_ABSOLUTE);
 #ifdef PDC_USE_JULYL
             rd_pgc_buffers_julyl       = rrddim_add(st_pgc_buffers, "julyl",          NULL, 1, 1, RRD_ALGORITHM_ABSOLUTE);
 #endif
@@ -1929,6 +2020,7 @@ static void dbengine2_statistics_charts(void) {
         rrddim_set_by_pointer(st_pgc_buffers, rd_pgc_buffers_xt_buf, (collected_number)buffers.xt_buf);
         rrddim_set_by_pointer(st_pgc_buffers, rd_pgc_buffers_epdl, (collected_number)buffers.epdl);
         rrddim_set_by_pointer(st_pgc_buffers, rd_pgc_buffers_deol, (collected_number)buffers.deol);
+        rrddim_set_by_pointer(st_pgc_buffers, rd_pgc_buffers_journal_filters, (collected_number)buffers.journal_filters);
 #ifdef PDC_USE_JULYL
         rrddim_set_by_pointer(st_pgc_buffers, rd_pgc_buffers_julyl, (collected_number)buffers.julyl);
 #endif
@@ -2415,10 +2507,42 @@ static void dbengine2_statistics_charts(void) {
         rrdset_done(st_query_pages_from_disk);
     }
 
+    {
+        static RRDSET *st_query_extent_reads = NULL;
+        static RRDDIM *rd_coalesced = NULL;
+        static RRDDIM *rd_read_ahead = NULL;
+
+        if (unlikely(!st_query_extent_reads)) {
+            st_query_extent_reads = rrdset_create_localhost(
+                    "netdata",
+                    "dbengine_query_extent_reads",
+                    NULL,
+                    "dbengine query router",
+                    NULL,
+                    "Netdata Query Extents Read in Batches",
+                    "extents/s",
+                    "netdata",
+                    "stats",
+                    priority,
+                    localhost->rrd_update_every,
+                    RRDSET_TYPE_LINE);
+
+            rd_coalesced = rrddim_add(st_query_extent_reads, "coalesced", NULL, 1, 1, RRD_ALGORITHM_INCREMENTAL);
+            rd_read_ahead = rrddim_add(st_query_extent_reads, "read ahead", NULL, 1, 1, RRD_ALGORITHM_INCREMENTAL);
+        }
+        priority++;
+
+        rrddim_set_by_pointer(st_query_extent_reads, rd_coalesced, (collected_number)cache_efficiency_stats.extents_coalesced);
+        rrddim_set_by_pointer(st_query_extent_reads, rd_read_ahead, (collected_number)cache_efficiency_stats.extents_read_ahead);
+
+        rrdset_done(st_query_extent_reads);
+    }
+
     {
         static RRDSET *st_events = NULL;
         static RRDDIM *rd_journal_v2_mapped = NULL;
         static RRDDIM *rd_journal_v2_unmapped = NULL;
+        static RRDDIM *rd_journal_v2_skipped = NULL;
         static RRDDIM *rd_datafile_creation = NULL;
         static RRDDIM *rd_datafile_deletion = NULL;
         static RRDDIM *rd_datafile_deletion_spin = NULL;
@@ -2442,6 +2566,7 @@ static void dbengine2_statistics_charts(void) {
 
             rd_journal_v2_mapped = rrddim_add(st_events, "journal v2 mapped", NULL, 1, 1, RRD_ALGORITHM_INCREMENTAL);
             rd_journal_v2_unmapped = rrddim_add(st_events, "journal v2 unmapped", NULL, 1, 1, RRD_ALGORITHM_INCREMENTAL);
+            rd_journal_v2_skipped = rrddim_add(st_events, "journal v2 skipped", NULL, 1, 1, RRD_ALGORITHM_INCREMENTAL);
             rd_datafile_creation = rrddim_add(st_events, "datafile creation", NULL, 1, 1, RRD_ALGORITHM_INCREMENTAL);
             rd_datafile_deletion = rrddim_add(st_events, "datafile deletion", NULL, 1, 1, RRD_ALGORITHM_INCREMENTAL);
             rd_datafile_deletion_spin = rrddim_add(st_events, "datafile deletion spin", NULL, 1, 1, RRD_ALGORITHM_INCREMENTAL);
@@ -2452,6 +2577,7 @@ static void dbengine2_statistics_charts(void) {
 
         rrddim_set_by_pointer(st_events, rd_journal_v2_mapped, (collected_number)cache_efficiency_stats.journal_v2_mapped);
         rrddim_set_by_pointer(st_events, rd_journal_v2_unmapped, (collected_number)cache_efficiency_stats.journal_v2_unmapped);
+        rrddim_set_by_pointer(st_events, rd_journal_v2_skipped, (collected_number)cache_efficiency_stats.journal_v2_skipped_by_filter);
         rrddim_set_by_pointer(st_events, rd_datafile_creation, (collected_number)cache_efficiency_stats.datafile_creation_started);
         rrddim_set_by_pointer(st_events, rd_datafile_deletion, (collected_number)cache_efficiency_stats.datafile_deletion_started);
         rrddim_set_by_pointer(st_events, rd_datafile_deletion_spin, (collected_number)cache_efficiency_stats.datafile_deletion_spin);
@@ -2461,6 +2587,68 @@ static void dbengine2_statistics_charts(void) {
         rrdset_done(st_events);
     }
 
+    {
+        static RRDSET *st_jv2_indexing = NULL;
+        static RRDDIM *rd_pages = NULL;
+        static RRDDIM *rd_written = NULL;
+
+        if (unlikely(!st_jv2_indexing)) {
+            st_jv2_indexing = rrdset_create_localhost(
+                    "netdata",
+                    "dbengine_journal_v2_indexing",
+                    NULL,
+                    "dbengine journal indexing",
+                    NULL,
+                    "Netdata Journal v2 Indexing Throughput",
+                    "pages/s",
+                    "netdata",
+                    "stats",
+                    priority,
+                    localhost->rrd_update_every,
+                    RRDSET_TYPE_LINE);
+
+            rd_pages = rrddim_add(st_jv2_indexing, "indexed", NULL, 1, 1, RRD_ALGORITHM_INCREMENTAL);
+            rd_written = rrddim_add(st_jv2_indexing, "written KiB", NULL, 1, 1024, RRD_ALGORITHM_INCREMENTAL);
+        }
+        priority++;
+
+        rrddim_set_by_pointer(st_jv2_indexing, rd_pages, (collected_number)cache_efficiency_stats.journal_v2_indexing_pages);
+        rrddim_set_by_pointer(st_jv2_indexing, rd_written, (collected_number)cache_efficiency_stats.journal_v2_indexing_bytes);
+
+        rrdset_done(st_jv2_indexing);
+    }
+
+    {
+        static RRDSET *st_jv2_indexing_waits = NULL;
+        static RRDDIM *rd_throttled = NULL;
+        static RRDDIM *rd_memory_wait = NULL;
+
+        if (unlikely(!st_jv2_indexing_waits)) {
+            st_jv2_indexing_waits = rrdset_create_localhost(
+                    "netdata",
+                    "dbengine_journal_v2_indexing_waits",
+                    NULL,
+                    "dbengine journal indexing",
+                    NULL,
+                    "Netdata Journal v2 Indexing Waits",
+                    "milliseconds/s",
+                    "netdata",
+                    "stats",
+                    priority,
+                    localhost->rrd_update_every,
+                    RRDSET_TYPE_STACKED);
+
+            rd_throttled = rrddim_add(st_jv2_indexing_waits, "write rate", NULL, 1, USEC_PER_MS, RRD_ALGORITHM_INCREMENTAL);
+            rd_memory_wait = rrddim_add(st_jv2_indexing_waits, "memory", NULL, 1, USEC_PER_MS, RRD_ALGORITHM_INCREMENTAL);
+        }
+        priority++;
+
+        rrddim_set_by_pointer(st_jv2_indexing_waits, rd_throttled, (collected_number)cache_efficiency_stats.journal_v2_indexing_throttled_ut);
+        rrddim_set_by_pointer(st_jv2_indexing_waits, rd_memory_wait, (collected_number)cache_efficiency_stats.journal_v2_indexing_memory_wait_ut);
+
+        rrdset_done(st_jv2_indexing_waits);
+    }
+
     {
         static RRDSET *st_prep_timings = NULL;
         static RRDDIM *rd_routing = NULL;
@@ -367,6 +367,11 @@ void netdata_cleanup_and_exit(int ret) {
             | SERVICE_STREAMING
             , 3 * USEC_PER_SEC);
 
+    delta_shutdown_time("join streaming pool threads");
+
+    rrdpush_receivers_pool_stop();
+    rrdpush_senders_pool_stop();
+
     delta_shutdown_time("stop replication threads");
 
     timeout = !service_wait_exit(
@@ -394,6 +399,10 @@ void netdata_cleanup_and_exit(int ret) {
             SERVICE_MAINTENANCE
             , 3 * USEC_PER_SEC);
 
+    delta_shutdown_time("stop query helper threads");
+
+    query_parallel_pool_stop();
+
     delta_shutdown_time("clear web client cache");
 
     web_client_cache_destroy();
@@ -548,6 +557,16 @@ void web_server_config_options(void)
 
     respect_web_browser_do_not_track_policy =
         config_get_boolean(CONFIG_SECTION_WEB, "respect do not track policy", respect_web_browser_do_not_track_policy);
+    query_parallel_threads_per_query =
+        (size_t)config_get_number(CONFIG_SECTION_WEB, "max threads per query", (long long)query_parallel_threads_per_query);
+    if(query_parallel_threads_per_query < 1)
+        query_parallel_threads_per_query = 1;
+
+    query_cache_size_mb =
+        (size_t)config_get_number(CONFIG_SECTION_WEB, "query cache size MB", (long long)query_cache_size_mb);
+    query_cache_historical_ttl_s =
+        (time_t)config_get_number(CONFIG_SECTION_WEB, "query cache historical ttl seconds", (long long)query_cache_historical_ttl_s);
+
     web_x_frame_options = config_get(CONFIG_SECTION_WEB, "x-frame-options response header", "");
     if(!*web_x_frame_options)
         web_x_frame_options = NULL;
@@ -816,6 +835,12 @@ int help(int exitcode) {
             "                           time of D seconds for writers, a page cache\n"
             "                           size of E MiB, an optional disk space limit\n"
             "                           of F MiB, G libuv workers (default 16) and exit.\n\n"
+            "  -W dbenginebench=A,B,C,D,E DIR [WORKLOAD]\n"
+            "                           Run a DB engine benchmark in directory DIR,\n"
+            "                           on a dataset of A metrics x B seconds, with\n"
+            "                           C tiers and D MiB of page cache, replaying the\n"
+            "                           queries of file WORKLOAD (when it does not\n"
+            "                           exist, E random queries are saved to it) and exit.\n\n"
 #endif
             "  -W set section option value\n"
             "                           set netdata.conf option from the command line.\n\n"
@@ -1186,12 +1211,48 @@ static void get_netdata_configured_variables() {
         netdata_log_error("Invalid dbengine page type ''%s' given. Defaulting to 'raw'.", page_type);
     }
 
+    const char *tier_page_type_str = config_get(CONFIG_SECTION_DB, "dbengine tier page type", "raw");
+    if (strcmp(tier_page_type_str, "gorilla") == 0) {
+        for (size_t tier = 1; tier < RRD_STORAGE_TIERS; tier++)
+            tier_page_type[tier] = PAGE_GORILLA_TIER;
+    } else if (strcmp(tier_page_type_str, "raw") != 0) {
+        netdata_log_error("Invalid dbengine tier page type '%s' given. Defaulting to 'raw'.", tier_page_type_str);
+    }
+
     // ------------------------------------------------------------------------
     // get default Database Engine page cache size in MiB
 
     default_rrdeng_page_cache_mb = (int) config_get_number(CONFIG_SECTION_DB, "dbengine page cache size MB", default_rrdeng_page_cache_mb);
     default_rrdeng_extent_cache_mb = (int) config_get_number(CONFIG_SECTION_DB, "dbengine extent cache size MB", default_rrdeng_extent_cache_mb);
     db_engine_journal_check = config_get_boolean(CONFIG_SECTION_DB, "dbengine enable journal integrity check", CONFIG_BOOLEAN_NO);
+    db_engine_use_io_uring = config_get_boolean(CONFIG_SECTION_DB, "dbengine use io_uring", CONFIG_BOOLEAN_NO);
+
+    const char *eviction_policy = config_get(CONFIG_SECTION_DB, "dbengine page cache eviction policy", "lru");
+    if(strcmp(eviction_policy, "scan-resistant") == 0)
+        db_engine_scan_resistant_eviction = 1;
+    else {
+        if(strcmp(eviction_policy, "lru") != 0)
+            netdata_log_error("Invalid dbengine page cache eviction policy '%s'. Valid policies are 'lru' and 'scan-resistant'. Proceeding with 'lru'.", eviction_policy);
+
+        db_engine_scan_resistant_eviction = 0;
+    }
+
+    db_engine_compact_clean_pages = config_get_boolean(CONFIG_SECTION_DB, "dbengine page cache compact clean pages", CONFIG_BOOLEAN_NO);
+
+    long long extent_coalescing_max_gap_kb = config_get_number(CONFIG_SECTION_DB, "dbengine extent coalescing max gap KiB", (long long)(db_engine_extent_coalescing_max_gap / 1024));
+    long long extent_coalescing_max_size_kb = config_get_number(CONFIG_SECTION_DB, "dbengine extent coalescing max read KiB", (long long)(db_engine_extent_coalescing_max_size / 1024));
+    long long read_ahead_kb = config_get_number(CONFIG_SECTION_DB, "dbengine read ahead KiB", (long long)(db_engine_read_ahead_size / 1024));
+    db_engine_extent_coalescing_max_gap = (size_t)(extent_coalescing_max_gap_kb > 0 ? extent_coalescing_max_gap_kb : 0) * 1024;
+    db_engine_extent_coalescing_max_size = (size_t)(extent_coalescing_max_size_kb > 0 ? extent_coalescing_max_size_kb : 0) * 1024;
+    db_engine_read_ahead_size = (size_t)(read_ahead_kb > 0 ? read_ahead_kb : 0) * 1024;
+
+    long long warm_start_pages = config_get_number(CONFIG_SECTION_DB, "dbengine page cache warm start pages", (long long)db_engine_warm_start_pages);
+    db_engine_warm_start_pages = (size_t)(warm_start_pages > 0 ? warm_start_pages : 0);
+
+    long long journal_indexing_memory_mb = config_get_number(CONFIG_SECTION_DB, "dbengine journal indexing max memory MiB", (long long)(db_engine_journal_indexing_max_memory / 1024 / 1024));
+    long long journal_indexing_write_kb = config_get_number(CONFIG_SECTION_DB, "dbengine journal indexing max write KiB/s", (long long)(db_engine_journal_indexing_write_rate / 1024));
+    db_engine_journal_indexing_max_memory = (size_t)(journal_indexing_memory_mb > 0 ? journal_indexing_memory_mb : 0) * 1024 * 1024;
+    db_engine_journal_indexing_write_rate = (size_t)(journal_indexing_write_kb > 0 ? journal_indexing_write_kb : 0) * 1024;
 
     if(default_rrdeng_extent_cache_mb < 0)
         default_rrdeng_extent_cache_mb = 0;
@@ -1391,10 +1452,13 @@ int pgc_unittest(void);
 int mrg_unittest(void);
 int julytest(void);
 int pluginsd_parser_unittest(void);
+int pluginsd_binary_unittest(void);
 void replication_initialize(void);
 void bearer_tokens_init(void);
 int unittest_rrdpush_compressions(void);
 int uuid_unittest(void);
+int statsd_sketch_unittest(void);
+int statsd_hyperloglog_unittest(void);
 
 int main(int argc, char **argv) {
     // initialize the system clocks
@@ -1495,6 +1559,7 @@ int main(int argc, char **argv) {
 #ifdef ENABLE_DBENGINE
                         char* createdataset_string = "createdataset=";
                         char* stresstest_string = "stresstest=";
+                        char* dbenginebench_string = "dbenginebench=";
 #endif
 
                         if(strcmp(optarg, "pgd-tests") == 0) {
@@ -1516,6 +1581,8 @@ int main(int argc, char **argv) {
 
                             if (pluginsd_parser_unittest())
                                 return 1;
+                            if (pluginsd_binary_unittest())
+                                return 1;
 
                             if (unit_test_static_threads())
                                 return 1;
@@ -1525,6 +1592,14 @@ int main(int argc, char **argv) {
                                 return 1;
                             if (buffer_unittest())
                                 return 1;
+                            if (query_cache_unittest())
+                                return 1;
+                            if (query_window_unittest())
+                                return 1;
+                            if (statsd_sketch_unittest())
+                                return 1;
+                            if (statsd_hyperloglog_unittest())
+                                return 1;
                             if (unit_test_bitmaps())
                                 return 1;
                             // No call to load the config file on this code-path
@@ -1587,6 +1662,14 @@ int main(int argc, char **argv) {
                             unittest_running = true;
                             return uuid_unittest();
                         }
+                        else if(strcmp(optarg, "sketchtest") == 0) {
+                            unittest_running = true;
+                            return statsd_sketch_unittest();
+                        }
+                        else if(strcmp(optarg, "hyperloglogtest") == 0) {
+                            unittest_running = true;
+                            return statsd_hyperloglog_unittest();
+                        }
 #ifdef ENABLE_DBENGINE
                         else if(strcmp(optarg, "mctest") == 0) {
                             unittest_running = true;
@@ -1616,10 +1699,22 @@ int main(int argc, char **argv) {
                             unittest_running = true;
                             return pluginsd_parser_unittest();
                         }
+                        else if(strcmp(optarg, "binarytest") == 0) {
+                            unittest_running = true;
+                            return pluginsd_binary_unittest();
+                        }
                         else if(strcmp(optarg, "rrdpush_compressions_test") == 0) {
                             unittest_running = true;
                             return unittest_rrdpush_compressions();
                         }
+                        else if(strcmp(optarg, "querycachetest") == 0) {
+                            unittest_running = true;
+                            return query_cache_unittest();
+                        }
+                        else if(strcmp(optarg, "querywindowtest") == 0) {
+                            unittest_running = true;
+                            return query_window_unittest();
+                        }
                         else if(strncmp(optarg, createdataset_string, strlen(createdataset_string)) == 0) {
                             optarg += strlen(createdataset_string);
                             unsigned history_seconds = strtoul(optarg, NULL, 0);
@@ -1664,6 +1759,54 @@ int main(int argc, char **argv) {
                                                  page_cache_mb, disk_space_mb);
                             return 0;
                         }
+                        else if(strncmp(optarg, dbenginebench_string, strlen(dbenginebench_string)) == 0) {
+                            char *endptr;
+                            unsigned metrics = 0, history_seconds = 0, tiers = 1, page_cache_mb = 0, queries = 0;
+
+                            optarg += strlen(dbenginebench_string);
+                            metrics = (unsigned)strtoul(optarg, &endptr, 0);
+                            if (',' == *endptr)
+                                history_seconds = (unsigned)strtoul(endptr + 1, &endptr, 0);
+                            if (',' == *endptr)
+                                tiers = (unsigned)strtoul(endptr + 1, &endptr, 0);
+                            if (',' == *endptr)
+                                page_cache_mb = (unsigned)strtoul(endptr + 1, &endptr, 0);
+                            if (',' == *endptr)
+                                queries = (unsigned)strtoul(endptr + 1, &endptr, 0);
+
+                            if(optind >= argc) {
+                                fprintf(stderr, "%s", "\nUSAGE: -W dbenginebench=METRICS,SECONDS,TIERS,PAGE_CACHE_MB,QUERIES DIR [WORKLOAD]\n\n"
+                                        " DIR is used as the cache directory of netdata - it should not be the\n"
+                                        " cache directory of a running agent.\n\n");
+                                return 1;
+                            }
+                            const char *dir = argv[optind];
+                            const char *workload = (optind + 1 < argc) ? argv[optind + 1] : NULL;
+
+                            if(mkdir(dir, 0775) != 0 && errno != EEXIST) {
+                                fprintf(stderr, "Cannot create directory '%s'\n", dir);
+                                return 1;
+                            }
+
+                            if (page_cache_mb < RRDENG_MIN_PAGE_CACHE_SIZE_MB)
+                                page_cache_mb = RRDENG_MIN_PAGE_CACHE_SIZE_MB;
+
+                            post_conf_load(&user);
+                            config_set(CONFIG_SECTION_DIRECTORIES, "cache", dir);
+                            config_set_number(CONFIG_SECTION_DB, "dbengine page cache size MB", page_cache_mb);
+                            config_set_number(CONFIG_SECTION_DB, "storage tiers", tiers ? tiers : 1);
+                            get_netdata_configured_variables();
+                            default_rrd_update_every = 1;
+                            default_rrd_memory_mode = RRD_MEMORY_MODE_DBENGINE;
+                            default_health_enabled = 0;
+                            default_rrdpush_enabled = 0;
+                            registry_init();
+                            if(rrd_init("dbengine-bench", NULL, false)) {
+                                fprintf(stderr, "rrd_init failed for dbengine benchmark\n");
+                                return 1;
+                            }
+                            return dbengine_bench(metrics, history_seconds, queries, workload);
+                        }
 #endif
                         else if(strcmp(optarg, "simple-pattern") == 0) {
                             if(optind + 2 > argc) {
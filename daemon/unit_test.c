@@ -192,6 +192,13 @@ int check_storage_number(NETDATA_DOUBLE n, int debug) {
         return 5;
     }
 
+    NETDATA_DOUBLE dv;
+    unpack_storage_numbers(&s, &dv, 1);
+    if(dv != d) {
+        fprintf(stderr, "Unpacking arrays of storage numbers gives " NETDATA_DOUBLE_FORMAT " instead of " NETDATA_DOUBLE_FORMAT " for number " NETDATA_DOUBLE_FORMAT "!\n", dv, d, n);
+        return 6;
+    }
+
     NETDATA_DOUBLE ddiff = d - n;
     NETDATA_DOUBLE dcdiff = ddiff * 100.0 / n;
 
@@ -2652,4 +2659,393 @@ void dbengine_stress_test(unsigned TEST_DURATION_SEC, unsigned DSET_CHARTS, unsi
     rrd_unlock();
 }
 
+// ----------------------------------------------------------------------------
+// DB-engine benchmark
+//
+// Generates a synthetic dataset of METRICS x SECONDS on all the configured tiers, flushes it to disk and replays a
+// workload of queries against it, one query at a time, reporting latency percentiles, bytes read from disk, page
+// cache hit ratio and CPU time per query.
+//
+// The workload is a text file with one query per line:
+//
+//     CHART AFTER BEFORE POINTS TIER
+//
+// AFTER and BEFORE are relative to the last point of the dataset (so they are zero or negative), CHART is taken
+// modulo the number of charts of the dataset and a negative TIER lets the query planner select the tier.
+// Lines starting with # are ignored.
+// When the workload file does not exist, a random (but always the same) workload is generated and saved to it,
+// so that it can be replayed against other configurations.
+
+#define DBENGINE_BENCH_DIMS 128
+#define DBENGINE_BENCH_MAX_WRITERS 16
+
+struct dbengine_bench_chart {
+    RRDSET *st;
+    RRDDIM *rd[DBENGINE_BENCH_DIMS];
+};
+
+struct dbengine_bench_writer {
+    netdata_thread_t thread;
+    struct dbengine_bench_chart *charts;
+    size_t first_chart;
+    size_t charts_nr;
+    time_t first_time_s;
+    time_t last_time_s;
+    size_t points;
+};
+
+struct dbengine_bench_query {
+    size_t chart;
+    time_t after;
+    time_t before;
+    size_t points;
+    int tier;
+};
+
+static void *dbengine_bench_writer_thread(void *arg) {
+    struct dbengine_bench_writer *w = arg;
+
+    for(size_t c = 0; c < w->charts_nr ; c++) {
+        struct dbengine_bench_chart *chart = &w->charts[w->first_chart + c];
+        chart->st->last_collected_time.tv_sec = chart->st->last_updated.tv_sec = w->first_time_s - 1;
+        chart->st->last_collected_time.tv_usec = chart->st->last_updated.tv_usec = 0;
+
+        for(size_t d = 0; d < DBENGINE_BENCH_DIMS ; d++) {
+            chart->rd[d]->collector.last_collected_time.tv_sec = w->first_time_s - 1;
+            chart->rd[d]->collector.last_collected_time.tv_usec = 0;
+        }
+    }
+
+    for(time_t now_s = w->first_time_s; now_s <= w->last_time_s ; now_s++) {
+        for(size_t c = 0; c < w->charts_nr ; c++) {
+            struct dbengine_bench_chart *chart = &w->charts[w->first_chart + c];
+            chart->st->usec_since_last_update = USEC_PER_SEC;
+
+            for(size_t d = 0; d < DBENGINE_BENCH_DIMS ; d++) {
+                collected_number value = generate_dbengine_chart_value((int)(w->first_chart + c), (int)d, now_s);
+                rrddim_set_by_pointer_fake_time(chart->rd[d], value, now_s);
+                w->points++;
+            }
+
+            rrdset_done(chart->st);
+        }
+    }
+
+    return NULL;
+}
+
+static inline uint64_t dbengine_bench_random(uint64_t *state) {
+    // xorshift64* - we need the same sequence on all systems, to make the generated workloads comparable
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 0x2545F4914F6CDD1DULL;
+}
+
+static size_t dbengine_bench_workload_generate(struct dbengine_bench_query **queries, size_t queries_nr, time_t history_s) {
+    uint64_t state = 0x5DEECE66DULL;
+
+    *queries = callocz(queries_nr, sizeof(struct dbengine_bench_query));
+    for(size_t i = 0; i < queries_nr ; i++) {
+        struct dbengine_bench_query *q = &(*queries)[i];
+        uint64_t kind = dbengine_bench_random(&state) % 100;
+        time_t duration, offset;
+
+        if(kind < 50) {
+            // dashboards: the last few minutes to a few hours
+            duration = 600 + (time_t)(dbengine_bench_random(&state) % (6 * 3600));
+            offset = (time_t)(dbengine_bench_random(&state) % 600);
+            q->tier = -1;
+        }
+        else if(kind < 80) {
+            // investigations: up to a day, anywhere in the dataset
+            duration = 3600 + (time_t)(dbengine_bench_random(&state) % 86400);
+            offset = (time_t)(dbengine_bench_random(&state) % history_s);
+            q->tier = -1;
+        }
+        else {
+            // long term: anywhere, on a specific tier
+            duration = 1 + (time_t)(dbengine_bench_random(&state) % history_s);
+            offset = (time_t)(dbengine_bench_random(&state) % history_s);
+            q->tier = (int)(dbengine_bench_random(&state) % RRD_STORAGE_TIERS);
+        }
+
+        duration = MIN(duration, history_s);
+        offset = MIN(offset, history_s - duration);
+
+        q->chart = (size_t)dbengine_bench_random(&state);
+        q->before = -offset;
+        q->after = -offset - duration;
+        q->points = 100 + (size_t)(dbengine_bench_random(&state) % 1100);
+    }
+
+    return queries_nr;
+}
+
+static size_t dbengine_bench_workload_load(const char *filename, struct dbengine_bench_query **queries) {
+    FILE *fp = fopen(filename, "r");
+    if(!fp)
+        return 0;
+
+    size_t size = 1024, used = 0;
+    *queries = mallocz(size * sizeof(struct dbengine_bench_query));
+
+    char line[1024 + 1];
+    size_t line_nr = 0;
+    while(fgets(line, 1024, fp)) {
+        line_nr++;
+
+        char *s = line;
+        while(isspace((uint8_t)*s)) s++;
+        if(!*s || *s == '#')
+            continue;
+
+        long long chart, after, before, points, tier;
+        if(sscanf(s, "%lld %lld %lld %lld %lld", &chart, &after, &before, &points, &tier) != 5 ||
+            chart < 0 || after > before || before > 0 || points < 0) {
+            fprintf(stderr, "DB-engine benchmark: ignoring invalid line %zu of workload '%s'\n", line_nr, filename);
+            continue;
+        }
+
+        if(used == size) {
+            size *= 2;
+            *queries = reallocz(*queries, size * sizeof(struct dbengine_bench_query));
+        }
+
+        (*queries)[used++] = (struct dbengine_bench_query) {
+                .chart = (size_t)chart,
+                .after = (time_t)after,
+                .before = (time_t)before,
+                .points = (size_t)points,
+                .tier = (int)tier,
+        };
+    }
+
+    fclose(fp);
+    return used;
+}
+
+static void dbengine_bench_workload_save(const char *filename, struct dbengine_bench_query *queries, size_t queries_nr) {
+    FILE *fp = fopen(filename, "w");
+    if(!fp) {
+        fprintf(stderr, "DB-engine benchmark: cannot save workload to '%s'\n", filename);
+        return;
+    }
+
+    fprintf(fp, "# CHART AFTER BEFORE POINTS TIER\n");
+    for(size_t i = 0; i < queries_nr ; i++)
+        fprintf(fp, "%zu %lld %lld %zu %d\n",
+                queries[i].chart, (long long)queries[i].after, (long long)queries[i].before,
+                queries[i].points, queries[i].tier);
+
+    fclose(fp);
+}
+
+static int dbengine_bench_usec_compar(const void *a, const void *b) {
+    usec_t ua = *(const usec_t *)a, ub = *(const usec_t *)b;
+    return (ua < ub) ? -1 : (ua > ub) ? 1 : 0;
+}
+
+static uint64_t dbengine_bench_disk_read_bytes(void) {
+    uint64_t bytes = 0;
+
+    for(size_t tier = 0; tier < storage_tiers ; tier++)
+        bytes += __atomic_load_n(&multidb_ctx[tier]->stats.io_read_bytes, __ATOMIC_RELAXED);
+
+    return bytes;
+}
+
+static usec_t dbengine_bench_cpu_usec(void) {
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    return ru.ru_utime.tv_sec * USEC_PER_SEC + ru.ru_utime.tv_usec + ru.ru_stime.tv_sec * USEC_PER_SEC + ru.ru_stime.tv_usec;
+}
+
+int dbengine_bench(unsigned METRICS, unsigned HISTORY_SECONDS, unsigned QUERIES, const char *workload_filename) {
+    fprintf(stderr, "%s() running...\n", __FUNCTION__ );
+
+    if(!METRICS)
+        METRICS = DBENGINE_BENCH_DIMS;
+    if(!HISTORY_SECONDS)
+        HISTORY_SECONDS = 86400;
+    if(!QUERIES)
+        QUERIES = 1000;
+
+    nd_log_limits_unlimited();
+
+    if(default_rrd_memory_mode != RRD_MEMORY_MODE_DBENGINE || !multidb_ctx[0]) {
+        fprintf(stderr, "DB-engine benchmark: dbengine is not initialized\n");
+        return 1;
+    }
+
+    // ------------------------------------------------------------------------
+    // the workload
+
+    struct dbengine_bench_query *queries = NULL;
+    size_t queries_nr = 0;
+
+    if(workload_filename && *workload_filename)
+        queries_nr = dbengine_bench_workload_load(workload_filename, &queries);
+
+    if(!queries_nr) {
+        freez(queries);
+        queries_nr = dbengine_bench_workload_generate(&queries, QUERIES, HISTORY_SECONDS);
+
+        if(workload_filename && *workload_filename)
+            dbengine_bench_workload_save(workload_filename, queries, queries_nr);
+    }
+
+    // ------------------------------------------------------------------------
+    // the dataset
+
+    size_t charts_nr = (METRICS + DBENGINE_BENCH_DIMS - 1) / DBENGINE_BENCH_DIMS;
+    struct dbengine_bench_chart *charts = callocz(charts_nr, sizeof(struct dbengine_bench_chart));
+
+    for(size_t c = 0; c < charts_nr ; c++) {
+        char id[RRD_ID_LENGTH_MAX + 1];
+        snprintfz(id, RRD_ID_LENGTH_MAX, "chart%zu", c + 1);
+        charts[c].st = rrdset_create(localhost, "dbengine_bench", id, NULL, "bench", "dbengine_bench.chart",
+                                     "DB-engine Benchmark", "value", "dbengine-bench", NULL, 1, 1, RRDSET_TYPE_LINE);
+
+        for(size_t d = 0; d < DBENGINE_BENCH_DIMS ; d++) {
+            snprintfz(id, RRD_ID_LENGTH_MAX, "dim%zu", d + 1);
+            charts[c].rd[d] = rrddim_add(charts[c].st, id, NULL, 1, 1, RRD_ALGORITHM_ABSOLUTE);
+        }
+    }
+
+    time_t last_time_s = now_realtime_sec();
+    time_t first_time_s = last_time_s - HISTORY_SECONDS + 1;
+
+    fprintf(stderr, "\nDB-engine benchmark: generating %zu metrics (%zu charts) x %u seconds on %zu tiers, "
+                    "%d MiB of page cache...\n",
+            charts_nr * DBENGINE_BENCH_DIMS, charts_nr, HISTORY_SECONDS, storage_tiers, default_rrdeng_page_cache_mb);
+
+    usec_t generate_started_ut = now_monotonic_usec();
+
+    size_t writers_nr = MIN(charts_nr, (size_t)DBENGINE_BENCH_MAX_WRITERS);
+    struct dbengine_bench_writer writers[DBENGINE_BENCH_MAX_WRITERS] = { 0 };
+    for(size_t i = 0, first_chart = 0; i < writers_nr ; i++) {
+        writers[i].charts = charts;
+        writers[i].first_chart = first_chart;
+        writers[i].charts_nr = charts_nr / writers_nr + ((i < charts_nr % writers_nr) ? 1 : 0);
+        writers[i].first_time_s = first_time_s;
+        writers[i].last_time_s = last_time_s;
+        first_chart += writers[i].charts_nr;
+
+        char tag[NETDATA_THREAD_TAG_MAX + 1];
+        snprintfz(tag, NETDATA_THREAD_TAG_MAX, "DBBENCH[%zu]", i);
+        netdata_thread_create(&writers[i].thread, tag, NETDATA_THREAD_OPTION_JOINABLE,
+                              dbengine_bench_writer_thread, &writers[i]);
+    }
+
+    size_t points_stored = 0;
+    for(size_t i = 0; i < writers_nr ; i++) {
+        netdata_thread_join(writers[i].thread, NULL);
+        points_stored += writers[i].points;
+    }
+
+    usec_t flush_started_ut = now_monotonic_usec();
+
+    // send everything to disk, so that the queries find the dataset the way it is after a restart
+    for(size_t c = 0; c < charts_nr ; c++) {
+        for(size_t d = 0; d < DBENGINE_BENCH_DIMS ; d++) {
+            for(size_t tier = 0; tier < storage_tiers ; tier++)
+                storage_engine_store_flush(charts[c].rd[d]->tiers[tier].db_collection_handle);
+        }
+    }
+
+    for(size_t tier = 0; tier < storage_tiers ; tier++)
+        pgc_flush_all_hot_and_dirty_pages(main_cache, (Word_t)multidb_ctx[tier]);
+
+    for(size_t tier = 0; tier < storage_tiers ; tier++) {
+        while(__atomic_load_n(&multidb_ctx[tier]->atomic.extents_currently_being_flushed, __ATOMIC_RELAXED))
+            sleep_usec(10 * USEC_PER_MS);
+    }
+
+    usec_t flush_finished_ut = now_monotonic_usec();
+
+    fprintf(stderr, "DB-engine benchmark: stored %zu points in %0.2f secs (%0.0f points/sec), flushed in %0.2f secs\n",
+            points_stored,
+            (double)(flush_started_ut - generate_started_ut) / USEC_PER_SEC,
+            (double)points_stored * USEC_PER_SEC / (double)MAX(flush_started_ut - generate_started_ut, 1),
+            (double)(flush_finished_ut - flush_started_ut) / USEC_PER_SEC);
+
+    // ------------------------------------------------------------------------
+    // replay the workload
+
+    fprintf(stderr, "DB-engine benchmark: replaying %zu queries...\n", queries_nr);
+
+    usec_t *latencies = mallocz(queries_nr * sizeof(usec_t));
+    size_t points_returned = 0, failed = 0;
+
+    struct rrdeng_cache_efficiency_stats stats_before = rrdeng_get_cache_efficiency_stats();
+    uint64_t disk_read_bytes_before = dbengine_bench_disk_read_bytes();
+    usec_t cpu_before_ut = dbengine_bench_cpu_usec();
+    usec_t replay_started_ut = now_monotonic_usec();
+
+    for(size_t i = 0; i < queries_nr ; i++) {
+        struct dbengine_bench_query *q = &queries[i];
+        RRDSET *st = charts[q->chart % charts_nr].st;
+
+        RRDR_OPTIONS options = RRDR_OPTION_NATURAL_POINTS;
+        size_t tier = 0;
+        if(q->tier >= 0) {
+            tier = MIN((size_t)q->tier, storage_tiers - 1);
+            options |= RRDR_OPTION_SELECTED_TIER;
+        }
+
+        usec_t started_ut = now_monotonic_usec();
+
+        ONEWAYALLOC *owa = onewayalloc_create(0);
+        RRDR *r = rrd2rrdr_legacy(owa, st, q->points, last_time_s + q->after, last_time_s + q->before,
+                                  RRDR_GROUPING_AVERAGE, 0, options, NULL, NULL, 0, tier,
+                                  QUERY_SOURCE_UNITTEST, STORAGE_PRIORITY_NORMAL);
+        if(r) {
+            points_returned += rrdr_rows(r) * r->d;
+            rrdr_free(owa, r);
+        }
+        else
+            failed++;
+        onewayalloc_destroy(owa);
+
+        latencies[i] = now_monotonic_usec() - started_ut;
+    }
+
+    usec_t replay_ut = now_monotonic_usec() - replay_started_ut;
+    usec_t cpu_ut = dbengine_bench_cpu_usec() - cpu_before_ut;
+    uint64_t disk_read_bytes = dbengine_bench_disk_read_bytes() - disk_read_bytes_before;
+    struct rrdeng_cache_efficiency_stats stats_after = rrdeng_get_cache_efficiency_stats();
+
+    size_t pages_from_cache =
+            (stats_after.pages_data_source_main_cache - stats_before.pages_data_source_main_cache) +
+            (stats_after.pages_data_source_main_cache_at_pass4 - stats_before.pages_data_source_main_cache_at_pass4);
+    size_t pages_from_extent_cache = stats_after.pages_data_source_extent_cache - stats_before.pages_data_source_extent_cache;
+    size_t pages_from_disk = stats_after.pages_data_source_disk - stats_before.pages_data_source_disk;
+    size_t pages = pages_from_cache + pages_from_extent_cache + pages_from_disk;
+
+    qsort(latencies, queries_nr, sizeof(usec_t), dbengine_bench_usec_compar);
+
+    fprintf(stderr, "\nDB-engine benchmark finished: %zu queries (%zu failed) returned %zu points in %0.2f secs.\n",
+            queries_nr, failed, points_returned, (double)replay_ut / USEC_PER_SEC);
+    fprintf(stderr, "Latency: p50 %0.3f ms, p90 %0.3f ms, p99 %0.3f ms, max %0.3f ms.\n",
+            (double)latencies[queries_nr * 50 / 100] / USEC_PER_MS,
+            (double)latencies[queries_nr * 90 / 100] / USEC_PER_MS,
+            (double)latencies[queries_nr * 99 / 100] / USEC_PER_MS,
+            (double)latencies[queries_nr - 1] / USEC_PER_MS);
+    fprintf(stderr, "Disk: %0.2f MiB read, %0.2f KiB per query.\n",
+            (double)disk_read_bytes / 1024 / 1024, (double)disk_read_bytes / 1024 / (double)queries_nr);
+    fprintf(stderr, "Pages: %zu, %0.2f%% from the page cache, %0.2f%% from the extent cache, %0.2f%% from disk.\n",
+            pages,
+            pages ? (double)pages_from_cache * 100.0 / (double)pages : 0.0,
+            pages ? (double)pages_from_extent_cache * 100.0 / (double)pages : 0.0,
+            pages ? (double)pages_from_disk * 100.0 / (double)pages : 0.0);
+    fprintf(stderr, "CPU: %0.3f ms per query (all threads of the process, while queries were running one at a time).\n",
+            (double)cpu_ut / USEC_PER_MS / (double)queries_nr);
+
+    freez(latencies);
+    freez(queries);
+    freez(charts);
+    return failed ? 1 : 0;
+}
+
 #endif
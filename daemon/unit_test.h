@@ -18,6 +18,7 @@ int test_dbengine(void);
 void generate_dbengine_dataset(unsigned history_seconds);
 void dbengine_stress_test(unsigned TEST_DURATION_SEC, unsigned DSET_CHARTS, unsigned QUERY_THREADS,
                                  unsigned RAMP_UP_SECONDS, unsigned PAGE_CACHE_MB, unsigned DISK_SPACE_MB);
+int dbengine_bench(unsigned METRICS, unsigned HISTORY_SECONDS, unsigned QUERIES, const char *workload_filename);
 
 #endif
 
@@ -276,6 +276,7 @@ typedef struct query_target_request {
     time_t after;                       // the requested timeframe
     time_t before;                      // the requested timeframe
     size_t points;                      // the requested number of points to be returned
+    time_t since;                       // incremental queries: the timestamp of the last point the caller has
 
     uint32_t format;                    // DATASOURCE_FORMAT
     RRDR_OPTIONS options;
@@ -20,6 +20,13 @@ typedef int32_t REFCOUNT;
 // to use ARAL uncomment the following line:
 #define PGC_WITH_ARAL 1
 
+// the number of reader slots per index partition follows the number of CPUs, within these limits
+#define PGC_INDEX_READER_SLOTS_MIN 16
+#define PGC_INDEX_READER_SLOTS_MAX 256
+
+// the share of the clean pages in probation, with PGC_OPTIONS_EVICT_SCAN_RESISTANT
+#define PGC_PROBATION_PER1000 100
+
 typedef enum __attribute__ ((__packed__)) {
     // mutually exclusive flags
     PGC_PAGE_CLEAN                       = (1 << 0), // none of the following
@@ -31,6 +38,7 @@ typedef enum __attribute__ ((__packed__)) {
     PGC_PAGE_IS_BEING_MIGRATED_TO_V2     = (1 << 4),
     PGC_PAGE_HAS_NO_DATA_IGNORE_ACCESSES = (1 << 5),
     PGC_PAGE_HAS_BEEN_ACCESSED           = (1 << 6),
+    PGC_PAGE_IN_PROBATION                = (1 << 7), // in the probation queue of the clean pages
 } PGC_PAGE_FLAGS;
 
 #define page_flag_check(page, flag) (__atomic_load_n(&((page)->flags), __ATOMIC_ACQUIRE) & (flag))
@@ -86,6 +94,7 @@ struct pgc {
         char name[PGC_NAME_MAX + 1];
 
         size_t partitions;
+        size_t index_reader_slots;
         size_t clean_size;
         size_t max_dirty_pages_per_call;
         size_t max_pages_per_inline_eviction;
@@ -113,9 +122,18 @@ struct pgc {
     PGC_CACHE_LINE_PADDING(0);
 
     struct pgc_index {
-        RW_SPINLOCK rw_spinlock;
+        SPINLOCK writers_spinlock;
+        bool writer;
+        int32_t waiters;                // readers sleeping on wait_cond for the writer to leave
         Pvoid_t sections_judy;
-        PGC_CACHE_LINE_PADDING(0);
+
+        uv_mutex_t wait_mutex;
+        uv_cond_t wait_cond;
+
+        struct pgc_index_readers {
+            int32_t readers;
+            PGC_CACHE_LINE_PADDING(0);
+        } *readers;
     } *index;
 
     PGC_CACHE_LINE_PADDING(1);
@@ -129,6 +147,11 @@ struct pgc {
 
     struct pgc_linked_list clean;       // LRU is applied here to free memory from the cache
 
+    struct {
+        PGC_PAGE *base;                 // clean pages not accessed since they became clean (FIFO), under the clean lock
+        size_t size;
+    } probation;                        // used only with PGC_OPTIONS_EVICT_SCAN_RESISTANT
+
     PGC_CACHE_LINE_PADDING(3);
 
     struct pgc_linked_list dirty;       // in the dirty list, pages are ordered the way they were marked dirty
@@ -223,17 +246,135 @@ static inline size_t pgc_indexing_partition(PGC *cache, Word_t metric_id) {
     return last_partition;
 }
 
+// The index is read by every page lookup, so readers do not share a lock:
+// each thread gets one of the reader counters of the partition (each on its
+// own cache line) and only writes to that. There are as many counters as
+// CPUs, so the threads running lookups at the same time rarely share one.
+// Writers raise the writer flag and sleep until all the reader counters
+// drain; readers that find the flag raised sleep until the writer leaves.
+//
+// The lock is not reentrant: a reader that locks the same partition again
+// while a writer waits would wait for itself. The only reader is
+// page_find_and_acquire() and it does not call back into the index while
+// holding it - internal checks verify this.
+
+static size_t pgc_index_reader_slots_assigned = 0;
+static __thread size_t pgc_index_read_locks_held = 0;
+
+static inline size_t pgc_index_reader_slot(PGC *cache) {
+    static __thread size_t slot = SIZE_MAX;
+
+    if(unlikely(slot == SIZE_MAX))
+        slot = __atomic_fetch_add(&pgc_index_reader_slots_assigned, 1, __ATOMIC_RELAXED);
+
+    return slot % cache->config.index_reader_slots;
+}
+
+static inline void pgc_index_init(PGC *cache, struct pgc_index *index) {
+    spinlock_init(&index->writers_spinlock);
+    index->writer = false;
+    index->waiters = 0;
+    index->sections_judy = NULL;
+    index->readers = callocz(cache->config.index_reader_slots, sizeof(struct pgc_index_readers));
+
+    fatal_assert(0 == uv_mutex_init(&index->wait_mutex));
+    fatal_assert(0 == uv_cond_init(&index->wait_cond));
+}
+
+static inline void pgc_index_destroy(struct pgc_index *index) {
+    uv_cond_destroy(&index->wait_cond);
+    uv_mutex_destroy(&index->wait_mutex);
+    freez(index->readers);
+}
+
+static inline void pgc_index_reader_leave(struct pgc_index *index, int32_t *readers) {
+    int32_t x = __atomic_sub_fetch(readers, 1, __ATOMIC_SEQ_CST);
+    internal_fatal(x < 0, "DBENGINE CACHE: index readers is negative %d", x);
+
+    if(unlikely(!x && __atomic_load_n(&index->writer, __ATOMIC_SEQ_CST))) {
+        // a writer may be sleeping, waiting for this counter to drain
+        uv_mutex_lock(&index->wait_mutex);
+        uv_cond_broadcast(&index->wait_cond);
+        uv_mutex_unlock(&index->wait_mutex);
+    }
+}
+
 static inline void pgc_index_read_lock(PGC *cache, size_t partition) {
-    rw_spinlock_read_lock(&cache->index[partition].rw_spinlock);
+    struct pgc_index *index = &cache->index[partition];
+    int32_t *readers = &index->readers[pgc_index_reader_slot(cache)].readers;
+
+    internal_fatal(pgc_index_read_locks_held, "DBENGINE CACHE: nested index read lock");
+    pgc_index_read_locks_held++;
+
+    netdata_thread_disable_cancelability();
+
+    while(true) {
+        __atomic_add_fetch(readers, 1, __ATOMIC_SEQ_CST);
+
+        if(likely(!__atomic_load_n(&index->writer, __ATOMIC_SEQ_CST)))
+            break;
+
+        // a writer is in, or waiting for us to leave
+        pgc_index_reader_leave(index, readers);
+
+        // register as a waiter before checking the writer again,
+        // so that the writer either sees us or we see it gone
+        uv_mutex_lock(&index->wait_mutex);
+        __atomic_add_fetch(&index->waiters, 1, __ATOMIC_SEQ_CST);
+        while(__atomic_load_n(&index->writer, __ATOMIC_SEQ_CST))
+            uv_cond_wait(&index->wait_cond, &index->wait_mutex);
+        __atomic_sub_fetch(&index->waiters, 1, __ATOMIC_SEQ_CST);
+        uv_mutex_unlock(&index->wait_mutex);
+    }
 }
 static inline void pgc_index_read_unlock(PGC *cache, size_t partition) {
-    rw_spinlock_read_unlock(&cache->index[partition].rw_spinlock);
+    struct pgc_index *index = &cache->index[partition];
+    pgc_index_reader_leave(index, &index->readers[pgc_index_reader_slot(cache)].readers);
+    pgc_index_read_locks_held--;
+
+    netdata_thread_enable_cancelability();
 }
 static inline void pgc_index_write_lock(PGC *cache, size_t partition) {
-    rw_spinlock_write_lock(&cache->index[partition].rw_spinlock);
+    struct pgc_index *index = &cache->index[partition];
+
+    internal_fatal(pgc_index_read_locks_held, "DBENGINE CACHE: index write lock while holding a read lock");
+
+    spinlock_lock(&index->writers_spinlock);
+    __atomic_store_n(&index->writer, true, __ATOMIC_SEQ_CST);
+
+    // no new readers can enter now; wait without the mutex for the ones inside
+    // to leave, and sleep only if one of them is in for long
+    size_t slot = 0, spins = 0;
+    while(slot < cache->config.index_reader_slots && spins < 1000) {
+        if(__atomic_load_n(&index->readers[slot].readers, __ATOMIC_SEQ_CST))
+            spins++;
+        else
+            slot++;
+    }
+
+    if(unlikely(slot < cache->config.index_reader_slots)) {
+        uv_mutex_lock(&index->wait_mutex);
+        for(; slot < cache->config.index_reader_slots; slot++) {
+            while(__atomic_load_n(&index->readers[slot].readers, __ATOMIC_SEQ_CST))
+                uv_cond_wait(&index->wait_cond, &index->wait_mutex);
+        }
+        uv_mutex_unlock(&index->wait_mutex);
+    }
 }
 static inline void pgc_index_write_unlock(PGC *cache, size_t partition) {
-    rw_spinlock_write_unlock(&cache->index[partition].rw_spinlock);
+    struct pgc_index *index = &cache->index[partition];
+
+    __atomic_store_n(&index->writer, false, __ATOMIC_SEQ_CST);
+
+    // readers register as waiters before they check the writer flag,
+    // so when there are none, nobody can be sleeping on the condition
+    if(unlikely(__atomic_load_n(&index->waiters, __ATOMIC_SEQ_CST))) {
+        uv_mutex_lock(&index->wait_mutex);
+        uv_cond_broadcast(&index->wait_cond);
+        uv_mutex_unlock(&index->wait_mutex);
+    }
+
+    spinlock_unlock(&index->writers_spinlock);
 }
 
 static inline bool pgc_ll_trylock(PGC *cache __maybe_unused, struct pgc_linked_list *ll) {
@@ -496,7 +637,16 @@ static void pgc_ll_add(PGC *cache __maybe_unused, struct pgc_linked_list *ll, PG
         // - New pages created as CLEAN, always have 1 access.
         // - DIRTY pages made CLEAN, depending on their accesses may be appended (accesses > 0) or prepended (accesses = 0).
 
-        if(page->accesses || page_flag_check(page, PGC_PAGE_HAS_BEEN_ACCESSED | PGC_PAGE_HAS_NO_DATA_IGNORE_ACCESSES) == PGC_PAGE_HAS_BEEN_ACCESSED) {
+        // - With PGC_OPTIONS_EVICT_SCAN_RESISTANT, pages that have not been accessed twice go to probation,
+        //   so that a big query scanning many pages once cannot push the protected pages out of the cache.
+
+        if((cache->config.options & PGC_OPTIONS_EVICT_SCAN_RESISTANT) && page->accesses < 2 &&
+            !page_flag_check(page, PGC_PAGE_HAS_BEEN_ACCESSED)) {
+            DOUBLE_LINKED_LIST_APPEND_ITEM_UNSAFE(cache->probation.base, page, link.prev, link.next);
+            cache->probation.size += page->assumed_size;
+            page_flag_set(page, PGC_PAGE_IN_PROBATION);
+        }
+        else if(page->accesses || page_flag_check(page, PGC_PAGE_HAS_BEEN_ACCESSED | PGC_PAGE_HAS_NO_DATA_IGNORE_ACCESSES) == PGC_PAGE_HAS_BEEN_ACCESSED) {
             DOUBLE_LINKED_LIST_APPEND_ITEM_UNSAFE(ll->base, page, link.prev, link.next);
             page_flag_clear(page, PGC_PAGE_HAS_BEEN_ACCESSED);
         }
@@ -562,7 +712,14 @@ static void pgc_ll_del(PGC *cache __maybe_unused, struct pgc_linked_list *ll, PG
         }
     }
     else {
-        DOUBLE_LINKED_LIST_REMOVE_ITEM_UNSAFE(ll->base, page, link.prev, link.next);
+        if(page_flag_check(page, PGC_PAGE_IN_PROBATION)) {
+            DOUBLE_LINKED_LIST_REMOVE_ITEM_UNSAFE(cache->probation.base, page, link.prev, link.next);
+            cache->probation.size -= page->assumed_size;
+            page_flag_clear(page, PGC_PAGE_IN_PROBATION);
+        }
+        else
+            DOUBLE_LINKED_LIST_REMOVE_ITEM_UNSAFE(ll->base, page, link.prev, link.next);
+
         ll->version++;
     }
 
@@ -577,9 +734,20 @@ static inline void page_has_been_accessed(PGC *cache, PGC_PAGE *page) {
         __atomic_add_fetch(&page->accesses, 1, __ATOMIC_RELAXED);
 
         if (flags & PGC_PAGE_CLEAN) {
+            if(page_flag_check(page, PGC_PAGE_IN_PROBATION)) {
+                // it will be promoted when eviction reaches it
+                __atomic_add_fetch(&cache->stats.clean_hits_probation, 1, __ATOMIC_RELAXED);
+                return;
+            }
+
+            __atomic_add_fetch(&cache->stats.clean_hits_protected, 1, __ATOMIC_RELAXED);
+
             if(pgc_ll_trylock(cache, &cache->clean)) {
-                DOUBLE_LINKED_LIST_REMOVE_ITEM_UNSAFE(cache->clean.base, page, link.prev, link.next);
-                DOUBLE_LINKED_LIST_APPEND_ITEM_UNSAFE(cache->clean.base, page, link.prev, link.next);
+                // it may have entered probation while we were waiting
+                if(likely(!page_flag_check(page, PGC_PAGE_IN_PROBATION))) {
+                    DOUBLE_LINKED_LIST_REMOVE_ITEM_UNSAFE(cache->clean.base, page, link.prev, link.next);
+                    DOUBLE_LINKED_LIST_APPEND_ITEM_UNSAFE(cache->clean.base, page, link.prev, link.next);
+                }
                 pgc_ll_unlock(cache, &cache->clean);
                 page_flag_clear(page, PGC_PAGE_HAS_BEEN_ACCESSED);
             }
@@ -999,6 +1167,7 @@ static bool evict_pages_with_filter(PGC *cache, size_t max_skip, size_t max_evic
     size_t total_pages_evicted = 0;
     size_t total_pages_skipped = 0;
     bool stopped_before_finishing = false;
+    bool probation_exhausted = false;
     size_t spins = 0;
 
     do {
@@ -1040,17 +1209,37 @@ static bool evict_pages_with_filter(PGC *cache, size_t max_skip, size_t max_evic
         else
             pgc_ll_lock(cache, &cache->clean);
 
+        // with the scan resistant policy, evict from probation while it is above its share
+        bool from_probation = false;
+        if(cache->probation.base && !probation_exhausted) {
+            size_t clean_size = __atomic_load_n(&cache->clean.stats->size, __ATOMIC_RELAXED);
+            from_probation = all_of_them || !cache->clean.base ||
+                             cache->probation.size * 1000 > clean_size * PGC_PROBATION_PER1000;
+        }
+        PGC_PAGE **base = from_probation ? &cache->probation.base : &cache->clean.base;
+
         // find a page to evict
         PGC_PAGE *pages_to_evict = NULL;
         size_t pages_to_evict_size = 0;
-        for(PGC_PAGE *page = cache->clean.base, *next = NULL, *first_page_we_relocated = NULL; page ; page = next) {
+        for(PGC_PAGE *page = *base, *next = NULL, *first_page_we_relocated = NULL; page ; page = next) {
             next = page->link.next;
 
             if(unlikely(page == first_page_we_relocated))
                 // we did a complete loop on all pages
                 break;
 
-            if(unlikely(page_flag_check(page, PGC_PAGE_HAS_BEEN_ACCESSED | PGC_PAGE_HAS_NO_DATA_IGNORE_ACCESSES) == PGC_PAGE_HAS_BEEN_ACCESSED)) {
+            if(from_probation) {
+                if(unlikely(page->accesses >= 2 && !page_flag_check(page, PGC_PAGE_HAS_NO_DATA_IGNORE_ACCESSES))) {
+                    // accessed again while in probation - promote it
+                    DOUBLE_LINKED_LIST_REMOVE_ITEM_UNSAFE(cache->probation.base, page, link.prev, link.next);
+                    cache->probation.size -= page->assumed_size;
+                    page_flag_clear(page, PGC_PAGE_IN_PROBATION | PGC_PAGE_HAS_BEEN_ACCESSED);
+                    DOUBLE_LINKED_LIST_APPEND_ITEM_UNSAFE(cache->clean.base, page, link.prev, link.next);
+                    __atomic_add_fetch(&cache->stats.probation_promoted, 1, __ATOMIC_RELAXED);
+                    continue;
+                }
+            }
+            else if(unlikely(page_flag_check(page, PGC_PAGE_HAS_BEEN_ACCESSED | PGC_PAGE_HAS_NO_DATA_IGNORE_ACCESSES) == PGC_PAGE_HAS_BEEN_ACCESSED)) {
                 DOUBLE_LINKED_LIST_REMOVE_ITEM_UNSAFE(cache->clean.base, page, link.prev, link.next);
                 DOUBLE_LINKED_LIST_APPEND_ITEM_UNSAFE(cache->clean.base, page, link.prev, link.next);
                 page_flag_clear(page, PGC_PAGE_HAS_BEEN_ACCESSED);
@@ -1063,6 +1252,9 @@ static bool evict_pages_with_filter(PGC *cache, size_t max_skip, size_t max_evic
             if(non_acquired_page_get_for_deletion___while_having_clean_locked(cache, page)) {
                 // we can delete this page
 
+                if(from_probation)
+                    __atomic_add_fetch(&cache->stats.probation_evicted, 1, __ATOMIC_RELAXED);
+
                 // remove it from the clean list
                 pgc_ll_del(cache, &cache->clean, page, true);
 
@@ -1086,8 +1278,8 @@ static bool evict_pages_with_filter(PGC *cache, size_t max_skip, size_t max_evic
                 if(!first_page_we_relocated)
                     first_page_we_relocated = page;
 
-                DOUBLE_LINKED_LIST_REMOVE_ITEM_UNSAFE(cache->clean.base, page, link.prev, link.next);
-                DOUBLE_LINKED_LIST_APPEND_ITEM_UNSAFE(cache->clean.base, page, link.prev, link.next);
+                DOUBLE_LINKED_LIST_REMOVE_ITEM_UNSAFE(*base, page, link.prev, link.next);
+                DOUBLE_LINKED_LIST_APPEND_ITEM_UNSAFE(*base, page, link.prev, link.next);
 
                 // check if we have to stop
                 if(unlikely(++total_pages_skipped >= max_skip && !all_of_them)) {
@@ -1163,6 +1355,9 @@ static bool evict_pages_with_filter(PGC *cache, size_t max_skip, size_t max_evic
                 total_pages_evicted++;
             }
         }
+        else if(from_probation)
+            // nothing could be evicted from probation, try the protected pages
+            probation_exhausted = true;
         else
             break;
 
@@ -1776,10 +1971,13 @@ PGC *pgc_create(const char *name,
     cache->config.healthy_size_per1000        =  980;
     cache->config.evict_low_threshold_per1000 =  970;
 
+    size_t cpus = (size_t)get_netdata_cpus();
+    cache->config.index_reader_slots = MIN(MAX(cpus, PGC_INDEX_READER_SLOTS_MIN), PGC_INDEX_READER_SLOTS_MAX);
+
     cache->index = callocz(cache->config.partitions, sizeof(struct pgc_index));
 
     for(size_t part = 0; part < cache->config.partitions ; part++)
-        rw_spinlock_init(&cache->index[part].rw_spinlock);
+        pgc_index_init(cache, &cache->index[part]);
 
     spinlock_init(&cache->hot.spinlock);
     spinlock_init(&cache->dirty.spinlock);
@@ -1853,15 +2051,15 @@ void pgc_destroy(PGC *cache) {
     else {
         pointer_destroy_index(cache);
 
-//        for(size_t part = 0; part < cache->config.partitions ; part++)
-//            netdata_rwlock_destroy(&cache->index[part].rw_spinlock);
-
 #ifdef PGC_WITH_ARAL
         for(size_t part = 0; part < cache->config.partitions ; part++)
             aral_destroy(cache->aral[part]);
 
         freez(cache->aral);
 #endif
+        for(size_t part = 0; part < cache->config.partitions ; part++)
+            pgc_index_destroy(&cache->index[part]);
+
         freez(cache->index);
         freez(cache);
     }
@@ -2069,10 +2267,80 @@ size_t pgc_hot_and_dirty_entries(PGC *cache) {
     return entries;
 }
 
+// ----------------------------------------------------------------------------
+// journal v2 indexing memory budget
+
+// the temporary indexes of a page being migrated to journal v2:
+// its page info, its share of metric and extent info, and the JudyL entries pointing to them
+#define JV2_INDEXING_MEMORY_PER_PAGE (sizeof(struct jv2_page_info) + sizeof(struct jv2_metrics_info) + sizeof(struct jv2_extents_info) + 3 * 16)
+
+static struct {
+    netdata_mutex_t mutex;
+    pthread_cond_t cond;
+    size_t memory;
+} jv2_indexing_budget = {
+        .mutex = NETDATA_MUTEX_INITIALIZER,
+        .cond = PTHREAD_COND_INITIALIZER,
+        .memory = 0,
+};
+
+// wait until the memory of the indexers already running plus ours fits in the budget -
+// an indexer is always allowed to run when it is alone, no matter how big it is
+static void jv2_indexing_memory_reserve(size_t memory) {
+    usec_t started_ut = 0;
+
+    netdata_mutex_lock(&jv2_indexing_budget.mutex);
+    while(db_engine_journal_indexing_max_memory &&
+          jv2_indexing_budget.memory &&
+          jv2_indexing_budget.memory + memory > db_engine_journal_indexing_max_memory) {
+
+        if(!started_ut)
+            started_ut = now_monotonic_usec();
+
+        pthread_cond_wait(&jv2_indexing_budget.cond, &jv2_indexing_budget.mutex);
+    }
+    jv2_indexing_budget.memory += memory;
+    netdata_mutex_unlock(&jv2_indexing_budget.mutex);
+
+    if(started_ut)
+        __atomic_add_fetch(&rrdeng_cache_efficiency_stats.journal_v2_indexing_memory_wait_ut, now_monotonic_usec() - started_ut, __ATOMIC_RELAXED);
+}
+
+static void jv2_indexing_memory_release(size_t memory) {
+    netdata_mutex_lock(&jv2_indexing_budget.mutex);
+    jv2_indexing_budget.memory -= memory;
+    pthread_cond_broadcast(&jv2_indexing_budget.cond);
+    netdata_mutex_unlock(&jv2_indexing_budget.mutex);
+}
+
+static size_t pgc_open_cache_pages_of_datafile(PGC *cache, Word_t section, unsigned datafile_fileno) {
+    size_t pages = 0;
+
+    pgc_ll_lock(cache, &cache->hot);
+    Pvoid_t *section_pages_pptr = JudyLGet(cache->hot.sections_judy, section, PJE0);
+    if(section_pages_pptr) {
+        struct section_pages *sp = *section_pages_pptr;
+        for(PGC_PAGE *page = sp->base; page ; page = page->link.next) {
+            struct extent_io_data *xio = (struct extent_io_data *)page->custom_data;
+            if(xio->fileno == datafile_fileno)
+                pages++;
+        }
+    }
+    pgc_ll_unlock(cache, &cache->hot);
+
+    return pages;
+}
+
 void pgc_open_cache_to_journal_v2(PGC *cache, Word_t section, unsigned datafile_fileno, uint8_t type, migrate_to_v2_callback cb, void *data) {
     __atomic_add_fetch(&rrdeng_cache_efficiency_stats.journal_v2_indexing_started, 1, __ATOMIC_RELAXED);
     __atomic_add_fetch(&cache->stats.workers_jv2_flush, 1, __ATOMIC_RELAXED);
 
+    size_t reserved_memory = 0;
+    if(db_engine_journal_indexing_max_memory) {
+        reserved_memory = pgc_open_cache_pages_of_datafile(cache, section, datafile_fileno) * JV2_INDEXING_MEMORY_PER_PAGE;
+        jv2_indexing_memory_reserve(reserved_memory);
+    }
+
     pgc_ll_lock(cache, &cache->hot);
 
     Pvoid_t JudyL_metrics = NULL;
@@ -2087,6 +2355,8 @@ void pgc_open_cache_to_journal_v2(PGC *cache, Word_t section, unsigned datafile_
     Pvoid_t *section_pages_pptr = JudyLGet(cache->hot.sections_judy, section, PJE0);
     if(!section_pages_pptr) {
         pgc_ll_unlock(cache, &cache->hot);
+        jv2_indexing_memory_release(reserved_memory);
+        __atomic_sub_fetch(&cache->stats.workers_jv2_flush, 1, __ATOMIC_RELAXED);
         return;
     }
 
@@ -2094,6 +2364,8 @@ void pgc_open_cache_to_journal_v2(PGC *cache, Word_t section, unsigned datafile_
     if(!spinlock_trylock(&sp->migration_to_v2_spinlock)) {
         netdata_log_info("DBENGINE: migration to journal v2 for datafile %u is postponed, another jv2 indexer is already running for this section", datafile_fileno);
         pgc_ll_unlock(cache, &cache->hot);
+        jv2_indexing_memory_release(reserved_memory);
+        __atomic_sub_fetch(&cache->stats.workers_jv2_flush, 1, __ATOMIC_RELAXED);
         return;
     }
 
@@ -2208,6 +2480,8 @@ void pgc_open_cache_to_journal_v2(PGC *cache, Word_t section, unsigned datafile_
     spinlock_unlock(&sp->migration_to_v2_spinlock);
     pgc_ll_unlock(cache, &cache->hot);
 
+    __atomic_add_fetch(&rrdeng_cache_efficiency_stats.journal_v2_indexing_pages, count_of_unique_pages, __ATOMIC_RELAXED);
+
     // callback
     cb(section, datafile_fileno, type, JudyL_metrics, JudyL_extents_pos, count_of_unique_extents, count_of_unique_metrics, count_of_unique_pages, data);
 
@@ -2250,6 +2524,8 @@ void pgc_open_cache_to_journal_v2(PGC *cache, Word_t section, unsigned datafile_
     aral_by_size_release(ar_pi);
     aral_by_size_release(ar_mi);
 
+    jv2_indexing_memory_release(reserved_memory);
+
     __atomic_sub_fetch(&cache->stats.workers_jv2_flush, 1, __ATOMIC_RELAXED);
 }
 
@@ -2267,6 +2543,41 @@ size_t pgc_count_clean_pages_having_data_ptr(PGC *cache, Word_t section, void *p
     pgc_ll_lock(cache, &cache->clean);
     for(PGC_PAGE *page = cache->clean.base; page ;page = page->link.next)
         found += (page->data == ptr && page->section == section) ? 1 : 0;
+
+    for(PGC_PAGE *page = cache->probation.base; page ;page = page->link.next)
+        found += (page->data == ptr && page->section == section) ? 1 : 0;
+    pgc_ll_unlock(cache, &cache->clean);
+
+    return found;
+}
+
+// copy the index of the clean pages of a section, most recently used first
+// (the protected clean queue first, then probation) - data and custom data are not copied
+size_t pgc_clean_pages_of_section_mru(PGC *cache, Word_t section, PGC_ENTRY *entries, size_t max_entries) {
+    size_t found = 0;
+
+    pgc_ll_lock(cache, &cache->clean);
+    PGC_PAGE *bases[] = { cache->clean.base, cache->probation.base };
+    for(size_t b = 0; b < sizeof(bases) / sizeof(bases[0]) && found < max_entries ; b++) {
+        PGC_PAGE *base = bases[b];
+        if(!base)
+            continue;
+
+        // base->link.prev is the last (most recently used) page of the queue
+        for(PGC_PAGE *page = base->link.prev; page && found < max_entries ; page = (page == base) ? NULL : page->link.prev) {
+            if(page->section != section)
+                continue;
+
+            entries[found++] = (PGC_ENTRY) {
+                    .section = page->section,
+                    .metric_id = page->metric_id,
+                    .start_time_s = page->start_time_s,
+                    .end_time_s = page->end_time_s,
+                    .update_every_s = page->update_every_s,
+                    .size = page_size_from_assumed_size(cache, page->assumed_size),
+            };
+        }
+    }
     pgc_ll_unlock(cache, &cache->clean);
 
     return found;
@@ -2667,6 +2978,106 @@ void unittest_stress_test(void) {
     freez(pgc_uts.metrics);
     freez(pgc_uts.random_data);
 }
+// ----------------------------------------------------------------------------
+// index contention benchmark: many threads looking up clean pages, nothing else
+
+struct {
+    bool stop;
+    PGC *cache;
+    size_t metrics;
+    size_t pages_per_metric;
+    size_t seconds;
+} pgc_uts_index = {
+        .stop             = false,
+        .cache            = NULL,
+        .metrics          = 50000,
+        .pages_per_metric = 10,
+        .seconds          = 5,
+};
+
+struct unittest_stress_test_index_thread {
+    pthread_t thread;
+    unsigned int seed;
+    size_t lookups;
+};
+
+void *unittest_stress_test_index_lookups(void *ptr) {
+    struct unittest_stress_test_index_thread *t = ptr;
+    size_t lookups = 0;
+
+    while(!__atomic_load_n(&pgc_uts_index.stop, __ATOMIC_RELAXED)) {
+        for(size_t i = 0; i < 1000 ; i++) {
+            Word_t metric_id = rand_r(&t->seed) % pgc_uts_index.metrics + 1;
+            time_t start_time_s = (time_t)(rand_r(&t->seed) % pgc_uts_index.pages_per_metric) * 100 + 1;
+
+            PGC_PAGE *page = pgc_page_get_and_acquire(pgc_uts_index.cache, 1, metric_id, start_time_s, PGC_SEARCH_EXACT);
+            if(page)
+                pgc_page_release(pgc_uts_index.cache, page);
+        }
+        lookups += 1000;
+    }
+
+    t->lookups = lookups;
+    return ptr;
+}
+
+void unittest_stress_test_index_contention(void) {
+    pgc_uts_index.cache = pgc_create("index-contention",
+                                     1024 * 1024 * 1024, unittest_free_clean_page_callback,
+                                     64, NULL, unittest_save_dirty_page_callback,
+                                     10, 10, 1000, 10,
+                                     PGC_OPTIONS_DEFAULT, 0, 0);
+
+    for(size_t m = 1; m <= pgc_uts_index.metrics ; m++) {
+        for(size_t p = 0; p < pgc_uts_index.pages_per_metric ; p++) {
+            PGC_PAGE *page = pgc_page_add_and_acquire(pgc_uts_index.cache, (PGC_ENTRY) {
+                    .section = 1,
+                    .metric_id = m,
+                    .start_time_s = (time_t)p * 100 + 1,
+                    .end_time_s = (time_t)p * 100 + 100,
+                    .update_every_s = 1,
+                    .size = 1024,
+                    .data = NULL,
+                    .hot = false,
+            }, NULL);
+            pgc_page_release(pgc_uts_index.cache, page);
+        }
+    }
+
+    size_t threads_list[] = { 1, 4, 16, 64, 128 };
+    for(size_t i = 0; i < sizeof(threads_list) / sizeof(threads_list[0]) ; i++) {
+        size_t threads = threads_list[i];
+        struct unittest_stress_test_index_thread *t = callocz(threads, sizeof(*t));
+
+        __atomic_store_n(&pgc_uts_index.stop, false, __ATOMIC_RELAXED);
+        for(size_t n = 0; n < threads ; n++) {
+            char buffer[100 + 1];
+            snprintfz(buffer, sizeof(buffer) - 1, "LOOKUP_%zu", n);
+            t[n].seed = (unsigned int)(n + 1);
+            netdata_thread_create(&t[n].thread, buffer,
+                                  NETDATA_THREAD_OPTION_JOINABLE | NETDATA_THREAD_OPTION_DONT_LOG,
+                                  unittest_stress_test_index_lookups, &t[n]);
+        }
+
+        sleep_usec(pgc_uts_index.seconds * USEC_PER_SEC);
+        __atomic_store_n(&pgc_uts_index.stop, true, __ATOMIC_RELAXED);
+
+        size_t lookups = 0;
+        for(size_t n = 0; n < threads ; n++) {
+            netdata_thread_join(t[n].thread, NULL);
+            lookups += t[n].lookups;
+        }
+
+        netdata_log_info("PGC INDEX: %3zu threads, %8.2f M lookups/s total, %6.2f M lookups/s per thread",
+                         threads,
+                         (double)lookups / (double)pgc_uts_index.seconds / 1000000.0,
+                         (double)lookups / (double)pgc_uts_index.seconds / 1000000.0 / (double)threads);
+
+        freez(t);
+    }
+
+    pgc_destroy(pgc_uts_index.cache);
+}
 #endif
 
 int pgc_unittest(void) {
@@ -2739,6 +3150,7 @@ int pgc_unittest(void) {
     pgc_destroy(cache);
 
 #ifdef PGC_STRESS_TEST
+    unittest_stress_test_index_contention();
     unittest_stress_test();
 #endif
 
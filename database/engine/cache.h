@@ -17,6 +17,7 @@ typedef enum __attribute__ ((__packed__)) {
     PGC_OPTIONS_EVICT_PAGES_INLINE = (1 << 0),
     PGC_OPTIONS_FLUSH_PAGES_INLINE = (1 << 1),
     PGC_OPTIONS_AUTOSCALE          = (1 << 2),
+    PGC_OPTIONS_EVICT_SCAN_RESISTANT = (1 << 3), // clean pages have to be accessed twice to be protected from eviction
 } PGC_OPTIONS;
 
 #define PGC_OPTIONS_DEFAULT (PGC_OPTIONS_EVICT_PAGES_INLINE | PGC_OPTIONS_FLUSH_PAGES_INLINE | PGC_OPTIONS_AUTOSCALE)
@@ -152,6 +153,14 @@ struct pgc_statistics {
 
     PGC_CACHE_LINE_PADDING(12);
 
+    // clean queue
+    size_t clean_hits_probation;    // clean pages found while in probation (scan resistant eviction)
+    size_t clean_hits_protected;    // clean pages found in the protected clean queue
+    size_t probation_promoted;      // pages accessed again while in probation, moved to the protected queue
+    size_t probation_evicted;       // pages evicted from probation, without being accessed again
+
+    PGC_CACHE_LINE_PADDING(13);
+
     struct {
         PGC_CACHE_LINE_PADDING(0);
         struct pgc_queue_statistics hot;
@@ -233,6 +242,7 @@ void pgc_open_cache_to_journal_v2(PGC *cache, Word_t section, unsigned datafile_
 void pgc_open_evict_clean_pages_of_datafile(PGC *cache, struct rrdengine_datafile *datafile);
 size_t pgc_count_clean_pages_having_data_ptr(PGC *cache, Word_t section, void *ptr);
 size_t pgc_count_hot_pages_having_data_ptr(PGC *cache, Word_t section, void *ptr);
+size_t pgc_clean_pages_of_section_mru(PGC *cache, Word_t section, PGC_ENTRY *entries, size_t max_entries);
 
 typedef size_t (*dynamic_target_cache_size_callback)(void);
 void pgc_set_dynamic_target_cache_size_callback(PGC *cache, dynamic_target_cache_size_callback callback);
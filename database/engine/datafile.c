@@ -382,6 +382,69 @@ static int scan_data_files_cmp(const void *a, const void *b)
     return strcmp(path1, path2);
 }
 
+// opening the datafiles and loading (mmap and validation of) their journals v2
+// is independent for each datafile, so it is spread over a few threads
+struct scan_data_files_loader {
+    struct rrdengine_instance *ctx;
+    struct rrdengine_datafile **datafiles;
+    struct rrdengine_journalfile **journalfiles;
+    int *datafile_ret;
+    bool *loaded_v2;
+    size_t count;
+    size_t next;
+};
+
+static void *scan_data_files_loader_worker(void *ptr)
+{
+    struct scan_data_files_loader *loader = ptr;
+    size_t i;
+
+    while ((i = __atomic_fetch_add(&loader->next, 1, __ATOMIC_RELAXED)) < loader->count) {
+        struct rrdengine_datafile *datafile = loader->datafiles[i];
+
+        loader->datafile_ret[i] = load_data_file(datafile);
+        loader->journalfiles[i] = journalfile_alloc_and_init(datafile);
+
+        // do not try to load jv2 of the latest file
+        if (!loader->datafile_ret[i] && datafile->fileno != ctx_last_fileno_get(loader->ctx))
+            loader->loaded_v2[i] = journalfile_v2_load(loader->ctx, loader->journalfiles[i], datafile) == 0;
+    }
+
+    return NULL;
+}
+
+static void scan_data_files_load_in_parallel(struct scan_data_files_loader *loader)
+{
+    size_t threads = get_netdata_cpus() / storage_tiers;
+    if (threads > loader->count)
+        threads = loader->count;
+    if (threads > DATAFILE_MAX_LOADING_THREADS)
+        threads = DATAFILE_MAX_LOADING_THREADS;
+    if (threads < 1)
+        threads = 1;
+
+    netdata_log_info("DBENGINE: opening %zu data/journal files of tier %d, using %zu threads...",
+                     loader->count, loader->ctx->config.tier, threads);
+
+    if (threads == 1) {
+        scan_data_files_loader_worker(loader);
+        return;
+    }
+
+    netdata_thread_t *th = callocz(threads, sizeof(netdata_thread_t));
+    for (size_t t = 0; t < threads; t++) {
+        char tag[NETDATA_THREAD_TAG_MAX + 1];
+        snprintfz(tag, NETDATA_THREAD_TAG_MAX, "DBENGLOAD[%d]", loader->ctx->config.tier);
+        netdata_thread_create(&th[t], tag, NETDATA_THREAD_OPTION_JOINABLE | NETDATA_THREAD_OPTION_DONT_LOG,
+                              scan_data_files_loader_worker, loader);
+    }
+
+    for (size_t t = 0; t < threads; t++)
+        netdata_thread_join(th[t], NULL);
+
+    freez(th);
+}
+
 /* Returns number of datafiles that were loaded or < 0 on error */
 static int scan_data_files(struct rrdengine_instance *ctx)
 {
@@ -424,17 +487,31 @@ static int scan_data_files(struct rrdengine_instance *ctx)
 
     ctx->atomic.last_fileno = datafiles[matched_files - 1]->fileno;
 
+    struct scan_data_files_loader loader = {
+        .ctx = ctx,
+        .datafiles = datafiles,
+        .journalfiles = callocz(matched_files, sizeof(struct rrdengine_journalfile *)),
+        .datafile_ret = callocz(matched_files, sizeof(int)),
+        .loaded_v2 = callocz(matched_files, sizeof(bool)),
+        .count = matched_files,
+        .next = 0,
+    };
+
+    usec_t started_ut = now_monotonic_usec();
+    scan_data_files_load_in_parallel(&loader);
+    usec_t opened_ut = now_monotonic_usec();
+
+    // the journals without a v2 are replayed in order, and the last one may create a new datafile pair
     netdata_log_info("DBENGINE: loading %d data/journal of tier %d...", matched_files, ctx->config.tier);
     for (failed_to_load = 0, i = 0 ; i < matched_files ; ++i) {
         uint8_t must_delete_pair = 0;
 
         datafile = datafiles[i];
-        ret = load_data_file(datafile);
-        if (0 != ret)
+        if (0 != loader.datafile_ret[i])
             must_delete_pair = 1;
 
-        journalfile = journalfile_alloc_and_init(datafile);
-        ret = journalfile_load(ctx, journalfile, datafile);
+        journalfile = loader.journalfiles[i];
+        ret = journalfile_load(ctx, journalfile, datafile, loader.loaded_v2[i]);
         if (0 != ret) {
             if (!must_delete_pair) /* If datafile is still open close it */
                 close_data_file(datafile);
@@ -465,7 +542,18 @@ static int scan_data_files(struct rrdengine_instance *ctx)
         datafile_list_insert(ctx, datafile, false);
     }
 
+    usec_t finished_ut = now_monotonic_usec();
+    netdata_log_info("DBENGINE: tier %d loaded %d data/journal files in %0.2f ms "
+                     "(open and journal v2 validation: %0.2f ms, journal v1 replay: %0.2f ms)",
+                     ctx->config.tier, matched_files - failed_to_load,
+                     (double)(finished_ut - started_ut) / USEC_PER_MS,
+                     (double)(opened_ut - started_ut) / USEC_PER_MS,
+                     (double)(finished_ut - opened_ut) / USEC_PER_MS);
+
     matched_files -= failed_to_load;
+    freez(loader.loaded_v2);
+    freez(loader.datafile_ret);
+    freez(loader.journalfiles);
     freez(datafiles);
 
     return matched_files;
@@ -71,6 +71,80 @@ void journalfile_v1_generate_path(struct rrdengine_datafile *datafile, char *str
                     datafile->ctx->config.dbfiles_path, datafile->tier, datafile->fileno);
 }
 
+// ----------------------------------------------------------------------------
+// in-memory bloom filter of the metrics of each journal v2
+// it allows queries to skip journals that certainly don't have a metric, without touching their mmap pages
+
+static inline uint64_t journalfile_v2_filter_mix(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+static inline void journalfile_v2_filter_hashes(const uuid_t *uuid, uint64_t *h1, uint64_t *h2) {
+    uint64_t words[2];
+    memcpy(words, uuid, sizeof(words));
+
+    *h1 = journalfile_v2_filter_mix(words[0] ^ journalfile_v2_filter_mix(words[1]));
+    *h2 = journalfile_v2_filter_mix(words[1] + 0x9e3779b97f4a7c15ULL) | 1;
+}
+
+static size_t journalfile_v2_filters_memory = 0;
+
+size_t journalfile_v2_filters_size(void) {
+    return __atomic_load_n(&journalfile_v2_filters_memory, __ATOMIC_RELAXED);
+}
+
+static uint64_t *journalfile_v2_filter_build(struct journal_v2_header *j2_header, uint64_t *size) {
+    size_t entries = j2_header->metric_count;
+    if(!entries) {
+        *size = 0;
+        return NULL;
+    }
+
+    // bits are indexed modulo the size of the filter, so it does not need to be a power of 2
+    uint64_t bits = (entries * JOURNALFILE_V2_FILTER_BITS_PER_METRIC + 63) / 64 * 64;
+
+    uint64_t *filter = callocz(bits / 64, sizeof(uint64_t));
+    __atomic_add_fetch(&journalfile_v2_filters_memory, bits / 8, __ATOMIC_RELAXED);
+
+    struct journal_metric_list *metric = (void *)((uint8_t *)j2_header + j2_header->metric_offset);
+    for(size_t i = 0; i < entries ; i++) {
+        uint64_t h1, h2;
+        journalfile_v2_filter_hashes(&metric[i].uuid, &h1, &h2);
+
+        for(size_t k = 0; k < JOURNALFILE_V2_FILTER_HASHES ; k++) {
+            uint64_t bit = (h1 + k * h2) % bits;
+            filter[bit / 64] |= 1ULL << (bit % 64);
+        }
+    }
+
+    *size = bits;
+    return filter;
+}
+
+// the caller must prevent the journal from being unmapped permanently while calling this
+// (e.g. by holding the NJFV2IDX lock)
+static bool journalfile_v2_filter_may_have_metric(struct rrdengine_journalfile *journalfile, uuid_t *uuid) {
+    uint64_t *filter = journalfile->filter.bits;
+    if(unlikely(!filter))
+        return true;
+
+    uint64_t h1, h2;
+    journalfile_v2_filter_hashes(uuid, &h1, &h2);
+
+    for(size_t k = 0; k < JOURNALFILE_V2_FILTER_HASHES ; k++) {
+        uint64_t bit = (h1 + k * h2) % journalfile->filter.size;
+        if(!(filter[bit / 64] & (1ULL << (bit % 64))))
+            return false;
+    }
+
+    return true;
+}
+
 // ----------------------------------------------------------------------------
 
 struct rrdengine_datafile *njfv2idx_find_and_acquire_j2_header(NJFV2IDX_FIND_STATE *s) {
@@ -119,6 +193,14 @@ struct rrdengine_datafile *njfv2idx_find_and_acquire_j2_header(NJFV2IDX_FIND_STA
                                                       s->wanted_end_time_s);
 
         if(rc == PAGE_IS_IN_RANGE) {
+            if(s->uuid && !journalfile_v2_filter_may_have_metric(datafile->journalfile, s->uuid)) {
+                // the metric is certainly not in this journal - skip it without mounting it
+                __atomic_add_fetch(&rrdeng_cache_efficiency_stats.journal_v2_skipped_by_filter, 1, __ATOMIC_RELAXED);
+                datafile = NULL;
+                PValue = NULL;
+                continue;
+            }
+
             // this is good to return
             break;
         }
@@ -402,6 +484,9 @@ size_t journalfile_v2_data_size_get(struct rrdengine_journalfile *journalfile) {
 }
 
 void journalfile_v2_data_set(struct rrdengine_journalfile *journalfile, int fd, void *journal_data, uint32_t journal_data_size) {
+    uint64_t filter_size;
+    uint64_t *filter = journalfile_v2_filter_build(journal_data, &filter_size);
+
     spinlock_lock(&journalfile->mmap.spinlock);
     spinlock_lock(&journalfile->v2.spinlock);
 
@@ -420,6 +505,10 @@ void journalfile_v2_data_set(struct rrdengine_journalfile *journalfile, int fd,
     journalfile->v2.last_time_s = (time_t)(j2_header->end_time_ut / USEC_PER_SEC);
     journalfile->v2.size_of_directory = j2_header->metric_offset + j2_header->metric_count * sizeof(struct journal_metric_list);
 
+    internal_fatal(journalfile->filter.bits, "DBENGINE JOURNALFILE: trying to re-set journal filter");
+    journalfile->filter.bits = filter;
+    journalfile->filter.size = filter_size;
+
     journalfile_v2_mounted_data_unmount(journalfile, true, true);
 
     spinlock_unlock(&journalfile->v2.spinlock);
@@ -431,6 +520,12 @@ void journalfile_v2_data_set(struct rrdengine_journalfile *journalfile, int fd,
 static void journalfile_v2_data_unmap_permanently(struct rrdengine_journalfile *journalfile) {
     njfv2idx_remove(journalfile->datafile);
 
+    // no query can find this journal anymore, so nobody is using its filter
+    __atomic_sub_fetch(&journalfile_v2_filters_memory, journalfile->filter.size / 8, __ATOMIC_RELAXED);
+    freez(journalfile->filter.bits);
+    journalfile->filter.bits = NULL;
+    journalfile->filter.size = 0;
+
     bool has_references = false;
 
     do {
@@ -1003,16 +1098,34 @@ void journalfile_v2_populate_retention_to_mrg(struct rrdengine_instance *ctx, st
     time_t header_start_time_s  = (time_t) (j2_header->start_time_ut / USEC_PER_SEC);
     time_t global_first_time_s = header_start_time_s;
     time_t now_s = max_acceptable_collected_time();
-    for (size_t i=0; i < entries; i++) {
-        time_t start_time_s = header_start_time_s + metric->delta_start_s;
-        time_t end_time_s = header_start_time_s + metric->delta_end_s;
 
-        mrg_update_metric_retention_and_granularity_by_uuid(
-                main_mrg, (Word_t)ctx, &metric->uuid, start_time_s, end_time_s, metric->update_every_s, now_s);
+    // the metrics are pushed to the MRG in batches, so that each MRG partition is locked once per batch
+    size_t batch_size = MIN(entries, JOURNALFILE_V2_MRG_BATCH);
+    MRG_ENTRY *batch = mallocz(MAX(batch_size, 1) * sizeof(MRG_ENTRY));
+    size_t used = 0;
+
+    for (size_t i=0; i < entries; i++) {
+        batch[used++] = (MRG_ENTRY) {
+                .uuid = &metric->uuid,
+                .section = (Word_t)ctx,
+                .first_time_s = header_start_time_s + metric->delta_start_s,
+                .last_time_s = header_start_time_s + metric->delta_end_s,
+                .latest_update_every_s = metric->update_every_s,
+        };
+
+        if(used == batch_size) {
+            mrg_update_metrics_retention_and_granularity_batch(main_mrg, batch, used, now_s);
+            used = 0;
+        }
 
         metric++;
     }
 
+    if(used)
+        mrg_update_metrics_retention_and_granularity_batch(main_mrg, batch, used, now_s);
+
+    freez(batch);
+
     journalfile_v2_data_release(journalfile);
     usec_t ended_ut = now_monotonic_usec();
 
@@ -1269,6 +1382,36 @@ static void *journalfile_v2_write_descriptors(struct journal_v2_header *j2_heade
 // startup  : if the migration is done during agent startup
 //            this will allow us to optimize certain things
 
+// when an indexing write rate is configured, the new journal v2 is flushed to disk in chunks,
+// while it is being written, and the indexer sleeps so that it does not exceed the rate
+struct jv2_indexing_throttle {
+    usec_t started_ut;
+    size_t bytes;
+    size_t synced;
+};
+
+static void journalfile_v2_indexing_throttle(struct jv2_indexing_throttle *t, uint8_t *data_start, size_t file_size, size_t bytes) {
+    t->bytes += bytes;
+
+    if(!db_engine_journal_indexing_write_rate)
+        return;
+
+    if(t->bytes - t->synced < JOURNALFILE_V2_INDEXING_SYNC_BYTES)
+        return;
+
+    // only the pages that have been dirtied are written
+    msync(data_start, file_size, MS_SYNC);
+    t->synced = t->bytes;
+
+    // a single sleep per chunk, for as long as the chunk is ahead of the rate
+    usec_t expected_ut = t->started_ut + (usec_t)t->bytes * USEC_PER_SEC / db_engine_journal_indexing_write_rate;
+    usec_t now_ut = now_monotonic_usec();
+    if(expected_ut > now_ut) {
+        sleep_usec(expected_ut - now_ut);
+        __atomic_add_fetch(&rrdeng_cache_efficiency_stats.journal_v2_indexing_throttled_ut, expected_ut - now_ut, __ATOMIC_RELAXED);
+    }
+}
+
 void journalfile_migrate_to_v2_callback(Word_t section, unsigned datafile_fileno __maybe_unused, uint8_t type __maybe_unused,
                                         Pvoid_t JudyL_metrics, Pvoid_t JudyL_extents_pos,
                                         size_t number_of_extents, size_t number_of_metrics, size_t number_of_pages, void *user_data)
@@ -1390,6 +1533,13 @@ void journalfile_migrate_to_v2_callback(Word_t section, unsigned datafile_fileno
 
     uint32_t resize_file_to = total_file_size;
 
+    struct jv2_indexing_throttle throttle = {
+        .started_ut = now_monotonic_usec(),
+        .bytes = 0,
+        .synced = 0,
+    };
+    journalfile_v2_indexing_throttle(&throttle, data_start, total_file_size, metrics_offset);
+
     for (Index = 0; Index < number_of_metrics; Index++) {
         metric_info = uuid_list[Index].metric_info;
 
@@ -1423,15 +1573,20 @@ void journalfile_migrate_to_v2_callback(Word_t section, unsigned datafile_fileno
                                                                             data_start + pages_offset);
 
         // Calculate start of the pages start for next descriptor
-        pages_offset += (metric_info->number_of_pages * (sizeof(struct journal_page_list)) + sizeof(struct journal_page_header) + sizeof(struct journal_v2_block_trailer));
+        size_t metric_pages_size = (metric_info->number_of_pages * (sizeof(struct journal_page_list)) + sizeof(struct journal_page_header) + sizeof(struct journal_v2_block_trailer));
+        pages_offset += metric_pages_size;
         // Verify we are at the right location
         if (pages_offset != (uint32_t)(next_page_address - data_start)) {
             // make sure checks fail so that we abort
             data = data_start;
             break;
         }
+
+        journalfile_v2_indexing_throttle(&throttle, data_start, total_file_size, sizeof(struct journal_metric_list) + metric_pages_size);
     }
 
+    __atomic_add_fetch(&rrdeng_cache_efficiency_stats.journal_v2_indexing_bytes, throttle.bytes, __ATOMIC_RELAXED);
+
     if (data == data_start + metric_offset_trailer) {
         internal_error(true, "DBENGINE: WRITE METRICS AND PAGES  %llu", (now_monotonic_usec() - start_loading) / USEC_PER_MS);
 
@@ -1489,19 +1644,16 @@ void journalfile_migrate_to_v2_callback(Word_t section, unsigned datafile_fileno
         ctx_current_disk_space_increase(ctx, resize_file_to);
 }
 
+// loaded_v2 is true when the caller has already loaded the journal v2 of the datafile,
+// with journalfile_v2_load() - this is never done for the latest datafile
 int journalfile_load(struct rrdengine_instance *ctx, struct rrdengine_journalfile *journalfile,
-                     struct rrdengine_datafile *datafile)
+                     struct rrdengine_datafile *datafile, bool loaded_v2)
 {
     uv_fs_t req;
     uv_file file;
     int ret, fd, error;
     uint64_t file_size, max_id;
     char path[RRDENG_PATH_MAX];
-    bool loaded_v2 = false;
-
-    // Do not try to load jv2 of the latest file
-    if (datafile->fileno != ctx_last_fileno_get(ctx))
-        loaded_v2 = journalfile_v2_load(ctx, journalfile, datafile) == 0;
 
     journalfile_v1_generate_path(datafile, path, sizeof(path));
 
@@ -42,6 +42,11 @@ struct rrdengine_journalfile {
         uint32_t size_of_directory;
     } v2;
 
+    struct {
+        uint64_t *bits;                // bloom filter of the metric UUIDs of journal v2
+        uint64_t size;                 // number of bits (a multiple of 64)
+    } filter;
+
     struct {
         Word_t indexed_as;
     } njfv2idx;
@@ -136,6 +141,17 @@ struct journal_v2_header {
 
 #define JOURNAL_V2_HEADER_PADDING_SZ (RRDENG_BLOCK_SIZE - (sizeof(struct journal_v2_header)))
 
+// the number of metrics pushed to the MRG at once, when populating retention
+#define JOURNALFILE_V2_MRG_BATCH 4096
+
+// when the indexing write rate is limited, the journal v2 being built is flushed to disk every that many bytes
+#define JOURNALFILE_V2_INDEXING_SYNC_BYTES (4 * 1024 * 1024)
+
+// the in-memory bloom filter of each journal v2 gets that many bits per metric and probes that many bits per lookup
+// (~1% false positives)
+#define JOURNALFILE_V2_FILTER_BITS_PER_METRIC 10
+#define JOURNALFILE_V2_FILTER_HASHES 4
+
 struct wal;
 
 void journalfile_v1_generate_path(struct rrdengine_datafile *datafile, char *str, size_t maxlen);
@@ -146,8 +162,9 @@ int journalfile_close(struct rrdengine_journalfile *journalfile, struct rrdengin
 int journalfile_unlink(struct rrdengine_journalfile *journalfile);
 int journalfile_destroy_unsafe(struct rrdengine_journalfile *journalfile, struct rrdengine_datafile *datafile);
 int journalfile_create(struct rrdengine_journalfile *journalfile, struct rrdengine_datafile *datafile);
+int journalfile_v2_load(struct rrdengine_instance *ctx, struct rrdengine_journalfile *journalfile, struct rrdengine_datafile *datafile);
 int journalfile_load(struct rrdengine_instance *ctx, struct rrdengine_journalfile *journalfile,
-                     struct rrdengine_datafile *datafile);
+                     struct rrdengine_datafile *datafile, bool loaded_v2);
 void journalfile_v2_populate_retention_to_mrg(struct rrdengine_instance *ctx, struct rrdengine_journalfile *journalfile);
 
 void journalfile_migrate_to_v2_callback(Word_t section, unsigned datafile_fileno __maybe_unused, uint8_t type __maybe_unused,
@@ -157,6 +174,7 @@ void journalfile_migrate_to_v2_callback(Word_t section, unsigned datafile_fileno
 
 bool journalfile_v2_data_available(struct rrdengine_journalfile *journalfile);
 size_t journalfile_v2_data_size_get(struct rrdengine_journalfile *journalfile);
+size_t journalfile_v2_filters_size(void);
 void journalfile_v2_data_set(struct rrdengine_journalfile *journalfile, int fd, void *journal_data, uint32_t journal_data_size);
 struct journal_v2_header *journalfile_v2_data_acquire(struct rrdengine_journalfile *journalfile, size_t *data_size, time_t wanted_first_time_s, time_t wanted_last_time_s);
 void journalfile_v2_data_release(struct rrdengine_journalfile *journalfile);
@@ -168,6 +186,7 @@ typedef struct {
     time_t wanted_start_time_s;
     time_t wanted_end_time_s;
     struct rrdengine_instance *ctx;
+    uuid_t *uuid;                           // when set, skip journals that certainly don't have this metric
     struct journal_v2_header *j2_header_acquired;
 } NJFV2IDX_FIND_STATE;
 
@@ -169,13 +169,9 @@ static inline bool metric_release_and_can_be_deleted(MRG *mrg __maybe_unused, ME
     return (!first || !last || first > last);
 }
 
-static inline METRIC *metric_add_and_acquire(MRG *mrg, MRG_ENTRY *entry, bool *ret) {
-    size_t partition = uuid_partition(mrg, entry->uuid);
-
-    METRIC *allocation = aral_mallocz(mrg->index[partition].aral);
-
-    mrg_index_write_lock(mrg, partition);
-
+// the partition has to be write locked
+// when the metric is added, *allocation is consumed and set to NULL
+static inline METRIC *metric_add_unsafe(MRG *mrg, size_t partition, MRG_ENTRY *entry, METRIC **allocation, bool *added) {
     size_t mem_before_judyl, mem_after_judyl;
 
     Pvoid_t *sections_judy_pptr = JudyHSIns(&mrg->index[partition].uuid_judy, entry->uuid, sizeof(uuid_t), PJE0);
@@ -194,23 +190,13 @@ static inline METRIC *metric_add_and_acquire(MRG *mrg, MRG_ENTRY *entry, bool *r
         fatal("DBENGINE METRIC: corrupted section JudyL array");
 
     if(unlikely(*PValue != NULL)) {
-        METRIC *metric = *PValue;
-
-        metric_acquire(mrg, metric);
-
-        MRG_STATS_DUPLICATE_ADD(mrg, partition);
-
-        mrg_index_write_unlock(mrg, partition);
-
-        if(ret)
-            *ret = false;
-
-        aral_freez(mrg->index[partition].aral, allocation);
-
-        return metric;
+        *added = false;
+        return *PValue;
     }
 
-    METRIC *metric = allocation;
+    METRIC *metric = *allocation;
+    *allocation = NULL;
+
     uuid_copy(metric->uuid, *entry->uuid);
     metric->section = entry->section;
     metric->first_time_s = MAX(0, entry->first_time_s);
@@ -220,15 +206,35 @@ static inline METRIC *metric_add_and_acquire(MRG *mrg, MRG_ENTRY *entry, bool *r
     metric->writer = 0;
     metric->refcount = 0;
     metric->partition = partition;
-    metric_acquire(mrg, metric);
     *PValue = metric;
 
     MRG_STATS_ADDED_METRIC(mrg, partition);
 
+    *added = true;
+    return metric;
+}
+
+static inline METRIC *metric_add_and_acquire(MRG *mrg, MRG_ENTRY *entry, bool *ret) {
+    size_t partition = uuid_partition(mrg, entry->uuid);
+
+    METRIC *allocation = aral_mallocz(mrg->index[partition].aral);
+
+    mrg_index_write_lock(mrg, partition);
+
+    bool added;
+    METRIC *metric = metric_add_unsafe(mrg, partition, entry, &allocation, &added);
+    metric_acquire(mrg, metric);
+
+    if(!added)
+        MRG_STATS_DUPLICATE_ADD(mrg, partition);
+
     mrg_index_write_unlock(mrg, partition);
 
     if(ret)
-        *ret = true;
+        *ret = added;
+
+    if(allocation)
+        aral_freez(mrg->index[partition].aral, allocation);
 
     return metric;
 }
@@ -585,37 +591,41 @@ inline bool mrg_metric_clear_writer(MRG *mrg, METRIC *metric) {
     return done;
 }
 
-inline void mrg_update_metric_retention_and_granularity_by_uuid(
-        MRG *mrg, Word_t section, uuid_t *uuid,
-        time_t first_time_s, time_t last_time_s,
-        uint32_t update_every_s, time_t now_s)
-{
-    if(unlikely(last_time_s > now_s)) {
+static inline void mrg_sanitize_retention(time_t *first_time_s, time_t *last_time_s, time_t now_s) {
+    if(unlikely(*last_time_s > now_s)) {
         nd_log_limit_static_global_var(erl, 1, 0);
         nd_log_limit(&erl, NDLS_DAEMON, NDLP_WARNING,
                      "DBENGINE JV2: wrong last time on-disk (%ld - %ld, now %ld), "
                      "fixing last time to now",
-                     first_time_s, last_time_s, now_s);
-        last_time_s = now_s;
+                     *first_time_s, *last_time_s, now_s);
+        *last_time_s = now_s;
     }
 
-    if (unlikely(first_time_s > last_time_s)) {
+    if (unlikely(*first_time_s > *last_time_s)) {
         nd_log_limit_static_global_var(erl, 1, 0);
         nd_log_limit(&erl, NDLS_DAEMON, NDLP_WARNING,
                      "DBENGINE JV2: wrong first time on-disk (%ld - %ld, now %ld), "
                      "fixing first time to last time",
-                     first_time_s, last_time_s, now_s);
+                     *first_time_s, *last_time_s, now_s);
 
-        first_time_s = last_time_s;
+        *first_time_s = *last_time_s;
     }
 
-    if (unlikely(first_time_s == 0 || last_time_s == 0)) {
+    if (unlikely(*first_time_s == 0 || *last_time_s == 0)) {
         nd_log_limit_static_global_var(erl, 1, 0);
         nd_log_limit(&erl, NDLS_DAEMON, NDLP_WARNING,
                      "DBENGINE JV2: zero on-disk timestamps (%ld - %ld, now %ld), "
                      "using them as-is",
-                     first_time_s, last_time_s, now_s);
+                     *first_time_s, *last_time_s, now_s);
     }
+}
+
+inline void mrg_update_metric_retention_and_granularity_by_uuid(
+        MRG *mrg, Word_t section, uuid_t *uuid,
+        time_t first_time_s, time_t last_time_s,
+        uint32_t update_every_s, time_t now_s)
+{
+    mrg_sanitize_retention(&first_time_s, &last_time_s, now_s);
 
     bool added = false;
     METRIC *metric = mrg_metric_get_and_acquire(mrg, uuid, section);
@@ -636,6 +646,66 @@ inline void mrg_update_metric_retention_and_granularity_by_uuid(
     mrg_metric_release(mrg, metric);
 }
 
+// the same as calling mrg_update_metric_retention_and_granularity_by_uuid() for each entry,
+// but the entries are grouped by partition and each partition is write locked only once
+void mrg_update_metrics_retention_and_granularity_batch(MRG *mrg, MRG_ENTRY *entries, size_t count, time_t now_s) {
+    if(!count)
+        return;
+
+    size_t *partition_of = mallocz(count * sizeof(size_t));
+    size_t *order = mallocz(count * sizeof(size_t));
+    size_t *offsets = callocz(mrg->partitions + 1, sizeof(size_t));
+
+    for(size_t i = 0; i < count ;i++) {
+        mrg_sanitize_retention(&entries[i].first_time_s, &entries[i].last_time_s, now_s);
+        partition_of[i] = uuid_partition(mrg, entries[i].uuid);
+        offsets[partition_of[i] + 1]++;
+    }
+
+    for(size_t p = 1; p <= mrg->partitions ;p++)
+        offsets[p] += offsets[p - 1];
+
+    for(size_t i = 0; i < count ;i++)
+        order[offsets[partition_of[i]]++] = i;
+
+    // offsets[p] is now the end of partition p
+    size_t start = 0;
+    for(size_t partition = 0; partition < mrg->partitions ;partition++) {
+        size_t end = offsets[partition];
+        if(start == end)
+            continue;
+
+        METRIC *allocation = NULL;
+
+        mrg_index_write_lock(mrg, partition);
+
+        for(size_t o = start; o < end ;o++) {
+            MRG_ENTRY *entry = &entries[order[o]];
+
+            if(!allocation)
+                allocation = aral_mallocz(mrg->index[partition].aral);
+
+            // metrics are deleted only under the write lock we hold,
+            // so there is no need to acquire them
+            bool added;
+            METRIC *metric = metric_add_unsafe(mrg, partition, entry, &allocation, &added);
+            if(likely(!added))
+                mrg_metric_expand_retention(mrg, metric, entry->first_time_s, entry->last_time_s, entry->latest_update_every_s);
+        }
+
+        mrg_index_write_unlock(mrg, partition);
+
+        if(allocation)
+            aral_freez(mrg->index[partition].aral, allocation);
+
+        start = end;
+    }
+
+    freez(offsets);
+    freez(order);
+    freez(partition_of);
+}
+
 inline void mrg_get_statistics(MRG *mrg, struct mrg_statistics *s) {
     memset(s, 0, sizeof(struct mrg_statistics));
 
@@ -90,5 +90,6 @@ void mrg_update_metric_retention_and_granularity_by_uuid(
         MRG *mrg, Word_t section, uuid_t *uuid,
         time_t first_time_s, time_t last_time_s,
         uint32_t update_every_s, time_t now_s);
+void mrg_update_metrics_retention_and_granularity_batch(MRG *mrg, MRG_ENTRY *entries, size_t count, time_t now_s);
 
 #endif // DBENGINE_METRIC_H
@@ -13,6 +13,7 @@ typedef enum __attribute__((packed)) {
     PGD_STATE_CREATED_FROM_DISK             = (1 << 1),
     PGD_STATE_SCHEDULED_FOR_FLUSHING        = (1 << 2),
     PGD_STATE_FLUSHED_TO_DISK               = (1 << 3),
+    PGD_STATE_COMPACT                       = (1 << 4),
 } PGD_STATES;
 
 typedef struct {
@@ -27,6 +28,22 @@ typedef struct {
     int aral_index;
 } page_gorilla_t;
 
+typedef struct {
+    // the points, as collected (shares its layout with page_raw_t)
+    uint8_t *data;
+    uint32_t size;
+
+    // the column-wise encoding of the points, created when flushing
+    uint8_t *encoded;
+    uint32_t encoded_size;
+} page_gorilla_tier_t;
+
+typedef struct {
+    // the gorilla buffers of the columns, back to back
+    uint8_t *data;
+    uint32_t size;
+} page_compact_t;
+
 struct pgd {
     // the page type
     uint8_t type;
@@ -45,6 +62,8 @@ struct pgd {
     union {
         page_raw_t raw;
         page_gorilla_t gorilla;
+        page_gorilla_tier_t gorilla_tier;
+        page_compact_t compact;
     };
 };
 
@@ -152,6 +171,245 @@ static void pgd_data_aral_free(void *page, size_t size)
         aral_freez(ar, page);
 }
 
+// ----------------------------------------------------------------------------
+// gorilla tier pages
+
+// PAGE_GORILLA_TIER pages are collected in a raw array, exactly like PAGE_TIER
+// pages. When they are flushed, each field of the points is encoded as an
+// independent gorilla stream (xor with the previous value), so that slowly
+// changing floats and constant counts take just a few bits per point.
+
+// worst case: the same-number bit, the same-lzc bit, the lzc and the value
+#define GORILLA_TIER_MAX_BITS_PER_POINT (1 + 1 + 5 + 32)
+
+static inline uint32_t gorilla_tier_column_value(const storage_number_tier1_t *sn, size_t column)
+{
+    uint32_t value;
+
+    switch (column) {
+        case 0:
+            memcpy(&value, &sn->sum_value, sizeof(value));
+            break;
+        case 1:
+            memcpy(&value, &sn->min_value, sizeof(value));
+            break;
+        case 2:
+            memcpy(&value, &sn->max_value, sizeof(value));
+            break;
+        default:
+            value = (uint32_t) sn->count | ((uint32_t) sn->anomaly_count << 16);
+            break;
+    }
+
+    return value;
+}
+
+static inline void gorilla_tier_column_set_value(storage_number_tier1_t *sn, size_t column, uint32_t value)
+{
+    switch (column) {
+        case 0:
+            memcpy(&sn->sum_value, &value, sizeof(value));
+            break;
+        case 1:
+            memcpy(&sn->min_value, &value, sizeof(value));
+            break;
+        case 2:
+            memcpy(&sn->max_value, &value, sizeof(value));
+            break;
+        default:
+            sn->count = (uint16_t) (value & 0xFFFF);
+            sn->anomaly_count = (uint16_t) (value >> 16);
+            break;
+    }
+}
+
+static size_t gorilla_tier_buffer_words(uint32_t entries)
+{
+    return (sizeof(gorilla_header_t) / sizeof(uint32_t)) +
+           ((entries * GORILLA_TIER_MAX_BITS_PER_POINT + 31) / 32) + 2;
+}
+
+static void pgd_gorilla_tier_encode(PGD *pg)
+{
+    const storage_number_tier1_t *array = (const storage_number_tier1_t *) pg->gorilla_tier.data;
+
+    size_t words = gorilla_tier_buffer_words(pg->used);
+    uint32_t *columns[RRDENG_GORILLA_TIER_COLUMNS];
+    struct rrdeng_page_gorilla_tier_header header = {
+            .entries = pg->used,
+    };
+
+    size_t encoded_size = sizeof(header);
+    for (size_t c = 0; c != RRDENG_GORILLA_TIER_COLUMNS; c++) {
+        columns[c] = callocz(words, sizeof(uint32_t));
+
+        gorilla_buffer_t *gbuf = (gorilla_buffer_t *) columns[c];
+        gorilla_writer_t gw = gorilla_writer_init(gbuf, words);
+
+        for (uint32_t i = 0; i != pg->used; i++) {
+            bool ok = gorilla_writer_write(&gw, gorilla_tier_column_value(&array[i], c));
+            UNUSED(ok);
+            internal_fatal(!ok, "DBENGINE: gorilla tier column buffer is too small");
+        }
+
+        header.nbits[c] = gbuf->header.nbits;
+        encoded_size += ((header.nbits[c] + 31) / 32) * sizeof(uint32_t);
+    }
+
+    uint8_t *encoded = mallocz(encoded_size);
+    memcpy(encoded, &header, sizeof(header));
+
+    size_t pos = sizeof(header);
+    for (size_t c = 0; c != RRDENG_GORILLA_TIER_COLUMNS; c++) {
+        size_t bytes = ((header.nbits[c] + 31) / 32) * sizeof(uint32_t);
+        memcpy(&encoded[pos], ((gorilla_buffer_t *) columns[c])->data, bytes);
+        pos += bytes;
+
+        freez(columns[c]);
+    }
+
+    pg->gorilla_tier.encoded = encoded;
+    pg->gorilla_tier.encoded_size = encoded_size;
+}
+
+static void pgd_gorilla_tier_free_encoded(PGD *pg)
+{
+    freez(pg->gorilla_tier.encoded);
+    pg->gorilla_tier.encoded = NULL;
+    pg->gorilla_tier.encoded_size = 0;
+}
+
+static bool pgd_gorilla_tier_decode(storage_number_tier1_t *array, uint32_t entries, const uint8_t *base, uint32_t size)
+{
+    const struct rrdeng_page_gorilla_tier_header *header = (const struct rrdeng_page_gorilla_tier_header *) base;
+
+    size_t expected_size = sizeof(*header);
+    for (size_t c = 0; c != RRDENG_GORILLA_TIER_COLUMNS; c++) {
+        if (header->nbits[c] > entries * GORILLA_TIER_MAX_BITS_PER_POINT)
+            return false;
+
+        expected_size += ((header->nbits[c] + 31) / 32) * sizeof(uint32_t);
+    }
+
+    if (expected_size != size)
+        return false;
+
+    // sized for the worst case, so that a corrupted stream cannot make
+    // the reader go beyond the end of the buffer
+    size_t column_words = gorilla_tier_buffer_words(entries);
+    uint32_t *column = mallocz(column_words * sizeof(uint32_t));
+    uint32_t *values = mallocz(entries * sizeof(uint32_t));
+
+    bool ok = true;
+    size_t pos = sizeof(*header);
+    for (size_t c = 0; ok && c != RRDENG_GORILLA_TIER_COLUMNS; c++) {
+        size_t words = (header->nbits[c] + 31) / 32;
+
+        memset(column, 0, column_words * sizeof(uint32_t));
+
+        gorilla_buffer_t *gbuf = (gorilla_buffer_t *) column;
+        gbuf->header.next = NULL;
+        gbuf->header.entries = entries;
+        gbuf->header.nbits = header->nbits[c];
+        memcpy(gbuf->data, &base[pos], words * sizeof(uint32_t));
+        pos += words * sizeof(uint32_t);
+
+        gorilla_reader_t gr = gorilla_reader_init(gbuf);
+        if (gorilla_reader_read_batch(&gr, values, entries) != entries || gr.position > header->nbits[c]) {
+            ok = false;
+            break;
+        }
+
+        for (uint32_t i = 0; i != entries; i++)
+            gorilla_tier_column_set_value(&array[i], c, values[i]);
+    }
+
+    freez(values);
+    freez(column);
+
+    return ok;
+}
+
+// ----------------------------------------------------------------------------
+// compact clean pages
+
+// When enabled, PAGE_METRICS and PAGE_TIER pages loaded from disk are kept in
+// memory as gorilla streams (one for tier0 pages, one per field for tier pages),
+// instead of raw arrays. The query cursor decodes them one block at a time.
+
+#if PGDC_MAX_COLUMNS < RRDENG_GORILLA_TIER_COLUMNS
+#error "PGDC_MAX_COLUMNS cannot hold the columns of tier pages"
+#endif
+
+static inline size_t pgd_compact_columns(uint8_t type)
+{
+    return (type == PAGE_TIER) ? RRDENG_GORILLA_TIER_COLUMNS : 1;
+}
+
+static inline uint32_t pgd_compact_point_value(uint8_t type, const void *base, uint32_t slot, size_t column)
+{
+    if (type == PAGE_TIER)
+        return gorilla_tier_column_value(&((const storage_number_tier1_t *) base)[slot], column);
+
+    return ((const storage_number *) base)[slot];
+}
+
+// the words of a column, rounded up so that the next column is pointer aligned
+static inline size_t pgd_compact_column_words(const gorilla_buffer_t *gbuf)
+{
+    size_t words = (sizeof(gorilla_header_t) / sizeof(uint32_t)) + ((gbuf->header.nbits + 31) / 32);
+    return (words + 1) & ~((size_t) 1);
+}
+
+static inline gorilla_buffer_t *pgd_compact_next_column(gorilla_buffer_t *gbuf)
+{
+    return (gorilla_buffer_t *) &((uint32_t *) gbuf)[pgd_compact_column_words(gbuf)];
+}
+
+// returns false when the page does not compress, in which case it should be kept raw
+static bool pgd_compact_encode(PGD *pg, const void *base, uint32_t size)
+{
+    size_t columns_count = pgd_compact_columns(pg->type);
+    size_t words = gorilla_tier_buffer_words(pg->used);
+    uint32_t *columns[RRDENG_GORILLA_TIER_COLUMNS];
+
+    size_t compact_size = 0;
+    for (size_t c = 0; c != columns_count; c++) {
+        columns[c] = callocz(words, sizeof(uint32_t));
+
+        gorilla_buffer_t *gbuf = (gorilla_buffer_t *) columns[c];
+        gorilla_writer_t gw = gorilla_writer_init(gbuf, words);
+
+        for (uint32_t i = 0; i != pg->used; i++) {
+            bool ok = gorilla_writer_write(&gw, pgd_compact_point_value(pg->type, base, i, c));
+            UNUSED(ok);
+            internal_fatal(!ok, "DBENGINE: compact page column buffer is too small");
+        }
+
+        compact_size += pgd_compact_column_words(gbuf) * sizeof(uint32_t);
+    }
+
+    bool compact = compact_size < size;
+    if (compact) {
+        pg->compact.data = mallocz(compact_size);
+        pg->compact.size = compact_size;
+
+        size_t pos = 0;
+        for (size_t c = 0; c != columns_count; c++) {
+            size_t bytes = pgd_compact_column_words((gorilla_buffer_t *) columns[c]) * sizeof(uint32_t);
+            memcpy(&pg->compact.data[pos], columns[c], bytes);
+            pos += bytes;
+        }
+
+        pg->states |= PGD_STATE_COMPACT;
+    }
+
+    for (size_t c = 0; c != columns_count; c++)
+        freez(columns[c]);
+
+    return compact;
+}
+
 // ----------------------------------------------------------------------------
 // management api
 
@@ -166,7 +424,8 @@ PGD *pgd_create(uint8_t type, uint32_t slots)
 
     switch (type) {
         case PAGE_METRICS:
-        case PAGE_TIER: {
+        case PAGE_TIER:
+        case PAGE_GORILLA_TIER: {
             uint32_t size = slots * page_type_size[type];
 
             internal_fatal(!size || slots == 1,
@@ -174,6 +433,11 @@ PGD *pgd_create(uint8_t type, uint32_t slots)
 
             pg->raw.size = size;
             pg->raw.data = pgd_data_aral_alloc(size);
+
+            if (type == PAGE_GORILLA_TIER) {
+                pg->gorilla_tier.encoded = NULL;
+                pg->gorilla_tier.encoded_size = 0;
+            }
             break;
         }
         case PAGE_GORILLA_METRICS: {
@@ -221,10 +485,13 @@ PGD *pgd_create_from_disk_data(uint8_t type, void *base, uint32_t size)
     {
         case PAGE_METRICS:
         case PAGE_TIER:
-            pg->raw.size = size;
             pg->used = size / page_type_size[type];
             pg->slots = pg->used;
 
+            if (db_engine_compact_clean_pages && pgd_compact_encode(pg, base, size))
+                break;
+
+            pg->raw.size = size;
             pg->raw.data = pgd_data_aral_alloc(size);
             memcpy(pg->raw.data, base, size);
             break;
@@ -245,6 +512,29 @@ PGD *pgd_create_from_disk_data(uint8_t type, void *base, uint32_t size)
             pg->used = total_entries;
             pg->slots = pg->used;
             break;
+        case PAGE_GORILLA_TIER: {
+            const struct rrdeng_page_gorilla_tier_header *header = base;
+            if (size < sizeof(*header) || !header->entries ||
+                header->entries > RRDENG_BLOCK_SIZE / page_type_size[type]) {
+                aral_freez(pgd_alloc_globals.aral_pgd, pg);
+                return PGD_EMPTY;
+            }
+
+            pg->used = header->entries;
+            pg->slots = pg->used;
+
+            pg->gorilla_tier.size = pg->used * page_type_size[type];
+            pg->gorilla_tier.data = pgd_data_aral_alloc(pg->gorilla_tier.size);
+            pg->gorilla_tier.encoded = NULL;
+            pg->gorilla_tier.encoded_size = 0;
+
+            if (!pgd_gorilla_tier_decode((storage_number_tier1_t *) pg->gorilla_tier.data, pg->used, base, size)) {
+                pgd_data_aral_free(pg->gorilla_tier.data, pg->gorilla_tier.size);
+                aral_freez(pgd_alloc_globals.aral_pgd, pg);
+                return PGD_EMPTY;
+            }
+            break;
+        }
         default:
             fatal("Unknown page type: %uc", type);
     }
@@ -264,7 +554,14 @@ void pgd_free(PGD *pg)
     {
         case PAGE_METRICS:
         case PAGE_TIER:
-            pgd_data_aral_free(pg->raw.data, pg->raw.size);
+            if (pg->states & PGD_STATE_COMPACT)
+                freez(pg->compact.data);
+            else
+                pgd_data_aral_free(pg->raw.data, pg->raw.size);
+            break;
+        case PAGE_GORILLA_TIER:
+            pgd_gorilla_tier_free_encoded(pg);
+            pgd_data_aral_free(pg->gorilla_tier.data, pg->gorilla_tier.size);
             break;
         case PAGE_GORILLA_METRICS: {
             if (pg->states & PGD_STATE_CREATED_FROM_DISK)
@@ -360,7 +657,15 @@ uint32_t pgd_memory_footprint(PGD *pg)
     switch (pg->type) {
         case PAGE_METRICS:
         case PAGE_TIER:
-            footprint = sizeof(PGD) + pg->raw.size;
+            if (pg->states & PGD_STATE_COMPACT)
+                footprint = sizeof(PGD) + pg->compact.size;
+            else
+                footprint = sizeof(PGD) + pg->raw.size;
+            break;
+        case PAGE_GORILLA_TIER:
+            // the encoded points exist only while the page is being flushed,
+            // they are not part of the size of the page in the cache
+            footprint = sizeof(PGD) + pg->gorilla_tier.size;
             break;
         case PAGE_GORILLA_METRICS: {
             if (pg->states & PGD_STATE_CREATED_FROM_DISK)
@@ -377,6 +682,21 @@ uint32_t pgd_memory_footprint(PGD *pg)
     return footprint;
 }
 
+// Encodes gorilla tier pages that are about to be written to disk. Pages whose
+// points do not compress are converted to plain tier pages and stored as such.
+void pgd_prepare_for_flushing(PGD *pg)
+{
+    if (!pgd_slots_used(pg) || pg->type != PAGE_GORILLA_TIER || pg->gorilla_tier.encoded)
+        return;
+
+    pgd_gorilla_tier_encode(pg);
+
+    if (pg->gorilla_tier.encoded_size >= pg->used * page_type_size[PAGE_GORILLA_TIER]) {
+        pgd_gorilla_tier_free_encoded(pg);
+        pg->type = PAGE_TIER;
+    }
+}
+
 uint32_t pgd_disk_footprint(PGD *pg)
 {
     if (!pgd_slots_used(pg))
@@ -393,6 +713,12 @@ uint32_t pgd_disk_footprint(PGD *pg)
 
             break;
         }
+        case PAGE_GORILLA_TIER:
+            internal_fatal(!pg->gorilla_tier.encoded,
+                           "pgd_disk_footprint() gorilla tier page has not been prepared for flushing");
+
+            size = pg->gorilla_tier.encoded_size;
+            break;
         case PAGE_GORILLA_METRICS: {
             if (pg->states & PGD_STATE_CREATED_FROM_COLLECTOR ||
                 pg->states & PGD_STATE_SCHEDULED_FOR_FLUSHING ||
@@ -438,6 +764,15 @@ void pgd_copy_to_extent(PGD *pg, uint8_t *dst, uint32_t dst_size)
         case PAGE_TIER:
             memcpy(dst, pg->raw.data, dst_size);
             break;
+        case PAGE_GORILLA_TIER:
+            internal_fatal(!pg->gorilla_tier.encoded,
+                           "pgd_copy_to_extent() gorilla tier page has not been encoded");
+
+            memcpy(dst, pg->gorilla_tier.encoded, dst_size);
+
+            // the page will be served from its raw points from now on
+            pgd_gorilla_tier_free_encoded(pg);
+            break;
         case PAGE_GORILLA_METRICS: {
             if ((pg->states & PGD_STATE_SCHEDULED_FOR_FLUSHING) == 0)
                 fatal("Copying to extent is supported only for PGDs that are scheduled for flushing.");
@@ -500,7 +835,8 @@ void pgd_append_point(PGD *pg,
 
             break;
         }
-        case PAGE_TIER: {
+        case PAGE_TIER:
+        case PAGE_GORILLA_TIER: {
             storage_number_tier1_t *tier12_metric_data = (storage_number_tier1_t *)pg->raw.data;
             storage_number_tier1_t t;
             t.sum_value = (float) n;
@@ -552,12 +888,25 @@ static void pgdc_seek(PGDC *pgdc, uint32_t position)
     switch (pg->type) {
         case PAGE_METRICS:
         case PAGE_TIER:
+        case PAGE_GORILLA_TIER:
             pgdc->slots = pgdc->pgd->used;
+
+            if (pg->states & PGD_STATE_COMPACT) {
+                if (position > pgdc->slots)
+                    position = pgdc->slots;
+
+                gorilla_buffer_t *gbuf = (gorilla_buffer_t *) pg->compact.data;
+                for (size_t c = 0; c != pgd_compact_columns(pg->type); c++) {
+                    pgdc->gr[c] = gorilla_reader_init(gbuf);
+                    gorilla_reader_skip(&pgdc->gr[c], position);
+                    gbuf = pgd_compact_next_column(gbuf);
+                }
+            }
             break;
         case PAGE_GORILLA_METRICS: {
             if (pg->states & PGD_STATE_CREATED_FROM_DISK) {
                 pgdc->slots = pgdc->pgd->slots;
-                pgdc->gr = gorilla_reader_init((void *) pg->raw.data);
+                pgdc->gr[0] = gorilla_reader_init((void *) pg->raw.data);
             } else {
                 if (!(pg->states & PGD_STATE_CREATED_FROM_COLLECTOR) &&
                     !(pg->states & PGD_STATE_SCHEDULED_FOR_FLUSHING) &&
@@ -568,23 +917,15 @@ static void pgdc_seek(PGDC *pgdc, uint32_t position)
                     fatal("Seeking from a page without an active gorilla writer is not supported (yet).");
 
                 pgdc->slots = gorilla_writer_entries(pg->gorilla.writer);
-                pgdc->gr = gorilla_writer_get_reader(pg->gorilla.writer);
+                pgdc->gr[0] = gorilla_writer_get_reader(pg->gorilla.writer);
             }
 
             if (position > pgdc->slots)
                 position = pgdc->slots;
 
-            for (uint32_t i = 0; i != position; i++) {
-                uint32_t value;
-
-                bool ok = gorilla_reader_read(&pgdc->gr, &value);
-
-                if (!ok) {
-                    // this is fine, the reader will return empty points
-                    break;
-                }
-            }
-
+            // jumps over whole gorilla buffers and runs of repeated values,
+            // if it stops short the reader will return empty points
+            gorilla_reader_skip(&pgdc->gr[0], position);
             break;
         }
         default:
@@ -599,6 +940,8 @@ void pgdc_reset(PGDC *pgdc, PGD *pgd, uint32_t position)
 
     pgdc->pgd = pgd;
     pgdc->position = position;
+    pgdc->block.used = 0;
+    pgdc->block.index = 0;
 
     if (!pgd)
         return;
@@ -612,6 +955,54 @@ void pgdc_reset(PGDC *pgdc, PGD *pgd, uint32_t position)
     pgdc_seek(pgdc, position);
 }
 
+static bool pgdc_block_refill(PGDC *pgdc)
+{
+    uint32_t wanted = MIN(PGDC_BLOCK_POINTS, pgdc->slots - pgdc->position);
+
+    switch (pgdc->pgd->type) {
+        case PAGE_METRICS: {
+            if (pgdc->pgd->states & PGD_STATE_COMPACT) {
+                pgdc->block.used = gorilla_reader_read_batch(&pgdc->gr[0], pgdc->block.numbers, wanted);
+                break;
+            }
+
+            storage_number *array = (storage_number *) pgdc->pgd->raw.data;
+            memcpy(pgdc->block.numbers, &array[pgdc->position], wanted * sizeof(storage_number));
+            pgdc->block.used = wanted;
+            break;
+        }
+        case PAGE_GORILLA_METRICS:
+            pgdc->block.used = gorilla_reader_read_batch(&pgdc->gr[0], pgdc->block.numbers, wanted);
+            break;
+        case PAGE_TIER: {
+            // compact tier pages, the fields are decoded column by column
+            uint32_t values[PGDC_BLOCK_POINTS];
+            uint32_t used = wanted;
+
+            for (size_t c = 0; c != RRDENG_GORILLA_TIER_COLUMNS; c++) {
+                uint32_t decoded = gorilla_reader_read_batch(&pgdc->gr[c], values, wanted);
+                for (uint32_t i = 0; i != decoded; i++)
+                    gorilla_tier_column_set_value(&pgdc->block.tier[i], c, values[i]);
+
+                if (decoded < used)
+                    used = decoded;
+            }
+
+            pgdc->block.used = used;
+            pgdc->block.index = 0;
+            return used != 0;
+        }
+        default:
+            pgdc->block.used = 0;
+            break;
+    }
+
+    unpack_storage_numbers(pgdc->block.numbers, pgdc->block.values, pgdc->block.used);
+    pgdc->block.index = 0;
+
+    return pgdc->block.used != 0;
+}
+
 bool pgdc_get_next_point(PGDC *pgdc, uint32_t expected_position, STORAGE_POINT *sp)
 {
     if (!pgdc->pgd || pgdc->pgd == PGD_EMPTY || pgdc->position >= pgdc->slots)
@@ -624,20 +1015,43 @@ bool pgdc_get_next_point(PGDC *pgdc, uint32_t expected_position, STORAGE_POINT *
 
     switch (pgdc->pgd->type)
     {
-        case PAGE_METRICS: {
-            storage_number *array = (storage_number *) pgdc->pgd->raw.data;
-            storage_number n = array[pgdc->position++];
+        case PAGE_METRICS:
+        case PAGE_GORILLA_METRICS: {
+            if (pgdc->block.index == pgdc->block.used && !pgdc_block_refill(pgdc)) {
+                pgdc->position++;
+                storage_point_empty(*sp, sp->start_time_s, sp->end_time_s);
+                return false;
+            }
+
+            pgdc->position++;
 
-            sp->min = sp->max = sp->sum = unpack_storage_number(n);
+            storage_number n = pgdc->block.numbers[pgdc->block.index];
+            sp->min = sp->max = sp->sum = pgdc->block.values[pgdc->block.index];
             sp->flags = (SN_FLAGS)(n & SN_USER_FLAGS);
             sp->count = 1;
             sp->anomaly_count = is_storage_number_anomalous(n) ? 1 : 0;
 
+            pgdc->block.index++;
             return true;
         }
-        case PAGE_TIER: {
-            storage_number_tier1_t *array = (storage_number_tier1_t *) pgdc->pgd->raw.data;
-            storage_number_tier1_t n = array[pgdc->position++];
+        case PAGE_TIER:
+        case PAGE_GORILLA_TIER: {
+            storage_number_tier1_t n;
+
+            if (pgdc->pgd->states & PGD_STATE_COMPACT) {
+                if (pgdc->block.index == pgdc->block.used && !pgdc_block_refill(pgdc)) {
+                    pgdc->position++;
+                    storage_point_empty(*sp, sp->start_time_s, sp->end_time_s);
+                    return false;
+                }
+
+                n = pgdc->block.tier[pgdc->block.index++];
+                pgdc->position++;
+            }
+            else {
+                storage_number_tier1_t *array = (storage_number_tier1_t *) pgdc->pgd->raw.data;
+                n = array[pgdc->position++];
+            }
 
             sp->flags = n.anomaly_count ? SN_FLAG_NONE : SN_FLAG_NOT_ANOMALOUS;
             sp->count = n.count;
@@ -648,22 +1062,6 @@ bool pgdc_get_next_point(PGDC *pgdc, uint32_t expected_position, STORAGE_POINT *
 
             return true;
         }
-        case PAGE_GORILLA_METRICS: {
-            pgdc->position++;
-
-            uint32_t n = 666666666;
-            bool ok = gorilla_reader_read(&pgdc->gr, &n);
-            if (ok) {
-                sp->min = sp->max = sp->sum = unpack_storage_number(n);
-                sp->flags = (SN_FLAGS)(n & SN_USER_FLAGS);
-                sp->count = 1;
-                sp->anomaly_count = is_storage_number_anomalous(n) ? 1 : 0;
-            } else {
-                storage_point_empty(*sp, sp->start_time_s, sp->end_time_s);
-            }
-
-            return ok;
-        }
         default: {
             static bool logged = false;
             if (!logged)
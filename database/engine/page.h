@@ -9,12 +9,31 @@ extern "C" {
 
 #include "libnetdata/libnetdata.h"
 
+#define PGDC_BLOCK_POINTS 64
+
+// compact tier pages have one gorilla stream per field (RRDENG_GORILLA_TIER_COLUMNS)
+#define PGDC_MAX_COLUMNS 4
+
 typedef struct pgd_cursor {
     struct pgd *pgd;
     uint32_t position;
     uint32_t slots;
 
-    gorilla_reader_t gr;
+    gorilla_reader_t gr[PGDC_MAX_COLUMNS];
+
+    // tier0 values and the points of compact tier pages are decoded
+    // in blocks, and then they are handed out one point at a time
+    struct {
+        uint32_t used;
+        uint32_t index;
+        union {
+            struct {
+                storage_number numbers[PGDC_BLOCK_POINTS];
+                NETDATA_DOUBLE values[PGDC_BLOCK_POINTS];
+            };
+            storage_number_tier1_t tier[PGDC_BLOCK_POINTS];
+        };
+    } block;
 } PGDC;
 
 #include "rrdengine.h"
@@ -34,6 +53,7 @@ bool pgd_is_empty(PGD *pg);
 uint32_t pgd_slots_used(PGD *pg);
 
 uint32_t pgd_memory_footprint(PGD *pg);
+void pgd_prepare_for_flushing(PGD *pg);
 uint32_t pgd_disk_footprint(PGD *pg);
 
 void pgd_copy_to_extent(PGD *pg, uint8_t *dst, uint32_t dst_size);
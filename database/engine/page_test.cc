@@ -6,6 +6,7 @@
 #include <gtest/gtest.h>
 #include <limits>
 #include <random>
+#include <vector>
 
 bool operator==(const STORAGE_POINT lhs, const STORAGE_POINT rhs) {
     if (lhs.min != rhs.min)
@@ -377,6 +378,175 @@ TEST(PGD, Roundtrip) {
     pgd_free(pg_collector);
 }
 
+TEST(PGD, GorillaTierRoundtrip) {
+    size_t slots = 128;
+    PGD *pg_collector = pgd_create(PAGE_GORILLA_TIER, slots);
+
+    for (size_t i = 0; i != slots; i++) {
+        NETDATA_DOUBLE sum = 60.0 * (1000 + (i % 3));
+        pgd_append_point(pg_collector, i, sum, sum / 60.0 - 1, sum / 60.0 + 1, 60, i % 2, SN_DEFAULT_FLAGS, i);
+    }
+
+    uint32_t memory_footprint = pgd_memory_footprint(pg_collector);
+
+    pgd_prepare_for_flushing(pg_collector);
+    EXPECT_EQ(pgd_type(pg_collector), PAGE_GORILLA_TIER);
+    EXPECT_EQ(pgd_memory_footprint(pg_collector), memory_footprint);
+
+    uint32_t size_in_bytes = pgd_disk_footprint(pg_collector);
+    EXPECT_EQ(pgd_type(pg_collector), PAGE_GORILLA_TIER);
+    EXPECT_LT(size_in_bytes, slots * sizeof(storage_number_tier1_t));
+
+    std::vector<uint8_t> disk_buffer(size_in_bytes, 0xFF);
+    pgd_copy_to_extent(pg_collector, disk_buffer.data(), size_in_bytes);
+
+    PGD *pg_disk = pgd_create_from_disk_data(PAGE_GORILLA_TIER, disk_buffer.data(), size_in_bytes);
+    EXPECT_EQ(pgd_slots_used(pg_disk), slots);
+
+    PGDC cursor_collector;
+    PGDC cursor_disk;
+
+    pgdc_reset(&cursor_collector, pg_collector, 0);
+    pgdc_reset(&cursor_disk, pg_disk, 0);
+
+    STORAGE_POINT sp_collector = {};
+    STORAGE_POINT sp_disk = {};
+
+    for (size_t slot = 0; slot != slots; slot++) {
+        EXPECT_TRUE(pgdc_get_next_point(&cursor_collector, slot, &sp_collector));
+        EXPECT_TRUE(pgdc_get_next_point(&cursor_disk, slot, &sp_disk));
+
+        EXPECT_EQ(sp_collector, sp_disk);
+        EXPECT_EQ(sp_collector.anomaly_count, sp_disk.anomaly_count);
+    }
+
+    EXPECT_FALSE(pgdc_get_next_point(&cursor_disk, slots, &sp_disk));
+
+    // a truncated page is rejected
+    EXPECT_EQ(pgd_create_from_disk_data(PAGE_GORILLA_TIER, disk_buffer.data(), size_in_bytes - 4), PGD_EMPTY);
+
+    pgd_free(pg_disk);
+    pgd_free(pg_collector);
+}
+
+// fills the disk data of a page of the given type with slowly changing values,
+// or with random ones when compressible is false
+static std::vector<uint8_t> compact_disk_data(uint8_t type, size_t slots, bool compressible, std::mt19937 &gen) {
+    std::uniform_real_distribution<float> value_distr(-1000000.0, 1000000.0);
+    std::uniform_int_distribution<uint16_t> count_distr(0, std::numeric_limits<uint16_t>::max());
+    std::vector<uint8_t> data(slots * page_type_size[type]);
+
+    for (size_t i = 0; i != slots; i++) {
+        float n = 1000 + (i / 10) % 7;
+
+        if (type == PAGE_TIER) {
+            storage_number_tier1_t t = {};
+            t.sum_value = compressible ? n * 60 : value_distr(gen);
+            t.min_value = compressible ? n - 1 : value_distr(gen);
+            t.max_value = compressible ? n + 1 : value_distr(gen);
+            t.count = compressible ? 60 : count_distr(gen);
+            t.anomaly_count = compressible ? (i % 3 == 0) : count_distr(gen);
+            memcpy(&data[i * sizeof(t)], &t, sizeof(t));
+        } else {
+            storage_number sn = pack_storage_number(compressible ? n : value_distr(gen), SN_DEFAULT_FLAGS);
+            memcpy(&data[i * sizeof(sn)], &sn, sizeof(sn));
+        }
+    }
+
+    return data;
+}
+
+// reads both pages from the slot to their end, expecting the same points
+static void compact_compare_from(PGD *pg_raw, PGD *pg_compact, size_t slots, size_t slot) {
+    PGDC cursor_raw;
+    PGDC cursor_compact;
+
+    pgdc_reset(&cursor_raw, pg_raw, slot);
+    pgdc_reset(&cursor_compact, pg_compact, slot);
+
+    STORAGE_POINT sp_raw = {};
+    STORAGE_POINT sp_compact = {};
+
+    for (size_t i = slot; i != slots; i++) {
+        EXPECT_TRUE(pgdc_get_next_point(&cursor_raw, i, &sp_raw));
+        EXPECT_TRUE(pgdc_get_next_point(&cursor_compact, i, &sp_compact));
+
+        EXPECT_EQ(sp_raw, sp_compact) << "slot " << i << " of " << slots << ", seeked to " << slot;
+        EXPECT_EQ(sp_raw.anomaly_count, sp_compact.anomaly_count);
+    }
+
+    EXPECT_FALSE(pgdc_get_next_point(&cursor_raw, slots, &sp_raw));
+    EXPECT_FALSE(pgdc_get_next_point(&cursor_compact, slots, &sp_compact));
+}
+
+static void compact_roundtrip(uint8_t type, size_t slots, bool compressible) {
+    SCOPED_TRACE(testing::Message() << "type " << (int) type << ", slots " << slots << (compressible ? "" : ", random"));
+
+    std::mt19937 gen(slots);
+    std::vector<uint8_t> data = compact_disk_data(type, slots, compressible, gen);
+    uint32_t size = (uint32_t) data.size();
+
+    int compact_clean_pages = db_engine_compact_clean_pages;
+
+    db_engine_compact_clean_pages = 0;
+    PGD *pg_raw = pgd_create_from_disk_data(type, data.data(), size);
+
+    db_engine_compact_clean_pages = 1;
+    PGD *pg_compact = pgd_create_from_disk_data(type, data.data(), size);
+
+    db_engine_compact_clean_pages = compact_clean_pages;
+
+    EXPECT_EQ(pgd_type(pg_compact), type);
+    EXPECT_EQ(pgd_slots_used(pg_compact), slots);
+
+    // pages that do not get smaller stay raw, slowly changing values get smaller
+    EXPECT_LE(pgd_memory_footprint(pg_compact), pgd_memory_footprint(pg_raw));
+    if (compressible && slots >= PGDC_BLOCK_POINTS) {
+        EXPECT_LT(pgd_memory_footprint(pg_compact), pgd_memory_footprint(pg_raw));
+    }
+
+    // the first slot, the blocks around the last one, the last slot and random ones
+    std::vector<size_t> seeks = { 0, slots - 1 };
+    if (slots > PGDC_BLOCK_POINTS) {
+        seeks.push_back(PGDC_BLOCK_POINTS - 1);
+        seeks.push_back(PGDC_BLOCK_POINTS);
+        seeks.push_back((slots - 1) / PGDC_BLOCK_POINTS * PGDC_BLOCK_POINTS);
+    }
+
+    std::uniform_int_distribution<size_t> slot_distr(0, slots - 1);
+    for (size_t i = 0; i != 16; i++)
+        seeks.push_back(slot_distr(gen));
+
+    for (size_t slot : seeks)
+        compact_compare_from(pg_raw, pg_compact, slots, slot);
+
+    // out of bounds seek
+    {
+        PGDC cursor;
+        STORAGE_POINT sp;
+        pgdc_reset(&cursor, pg_compact, 2 * slots);
+        EXPECT_FALSE(pgdc_get_next_point(&cursor, 2 * slots, &sp));
+    }
+
+    pgd_free(pg_compact);
+    pgd_free(pg_raw);
+}
+
+TEST(PGD, CompactMetricsRoundtrip) {
+    // partial pages, pages ending at and after a block boundary and full pages
+    for (size_t slots : { 1, 10, PGDC_BLOCK_POINTS - 1, PGDC_BLOCK_POINTS, PGDC_BLOCK_POINTS + 1, 1000, 1024 }) {
+        compact_roundtrip(PAGE_METRICS, slots, true);
+        compact_roundtrip(PAGE_METRICS, slots, false);
+    }
+}
+
+TEST(PGD, CompactTierRoundtrip) {
+    for (size_t slots : { 1, 10, PGDC_BLOCK_POINTS - 1, PGDC_BLOCK_POINTS, PGDC_BLOCK_POINTS + 1, 300, 341 }) {
+        compact_roundtrip(PAGE_TIER, slots, true);
+        compact_roundtrip(PAGE_TIER, slots, false);
+    }
+}
+
 int pgd_test(int argc, char *argv[])
 {
     // Dummy/necessary initialization stuff
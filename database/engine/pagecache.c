@@ -43,8 +43,13 @@ static void main_cache_flush_dirty_page_callback(PGC *cache __maybe_unused, PGC_
         descr->update_every_s = entries_array[Index].update_every_s;
 
         descr->pgd = pgc_page_data(pages_array[Index]);
-        descr->type = pgd_type(descr->pgd);
+
+        // this may change the type of the page
+        // (gorilla tier pages that do not compress are stored as tier pages)
+        pgd_prepare_for_flushing(descr->pgd);
+
         descr->page_length = pgd_disk_footprint(descr->pgd);
+        descr->type = pgd_type(descr->pgd);
 
         DOUBLE_LINKED_LIST_APPEND_ITEM_UNSAFE(base, descr, link.prev, link.next);
 
@@ -505,6 +510,7 @@ static size_t get_page_list_from_journal_v2(struct rrdengine_instance *ctx, METR
             .ctx = ctx,
             .wanted_start_time_s = wanted_start_time_s,
             .wanted_end_time_s = wanted_end_time_s,
+            .uuid = uuid,
             .j2_header_acquired = NULL,
     };
 
@@ -756,10 +762,8 @@ inline void rrdeng_prep_wait(PDC *pdc) {
     }
 }
 
-void rrdeng_prep_query(struct page_details_control *pdc, bool worker) {
-    if(worker)
-        worker_is_busy(UV_EVENT_DBENGINE_QUERY);
-
+// find the pages of the query and return true when some of them have to be loaded from disk
+static bool rrdeng_prep_query_plan(PDC *pdc) {
     pdc->page_list_JudyL = get_page_list(pdc->ctx, pdc->metric,
                                                  pdc->start_time_s * USEC_PER_SEC,
                                                  pdc->end_time_s * USEC_PER_SEC,
@@ -778,24 +782,160 @@ void rrdeng_prep_query(struct page_details_control *pdc, bool worker) {
 
     if (pdc->pages_to_load_from_disk && pdc->page_list_JudyL) {
         pdc_acquire(pdc); // we get 1 for the 1st worker in the chain: do_read_page_list_work()
+        return true;
+    }
+
+    completion_mark_complete(&pdc->page_completion);
+    return false;
+}
+
+#define PREP_QUERY_GROUP_ON_STACK 64
+
+static void rrdeng_prep_query_group(PDC *pdc) {
+    size_t count = 0;
+    for(PDC *p = pdc; p ; p = p->group_next)
+        count++;
+
+    PDC *stack_pdcs[2 * PREP_QUERY_GROUP_ON_STACK];
+    PDC **pdcs = (count <= PREP_QUERY_GROUP_ON_STACK) ? stack_pdcs : mallocz(2 * count * sizeof(PDC *));
+    PDC **to_route = &pdcs[count];
+
+    count = 0;
+    for(PDC *p = pdc, *next; p ; p = next) {
+        next = p->group_next;
+        p->group_next = NULL;
+        pdcs[count++] = p;
+    }
+
+    // plan all the queries of the group, before routing any of them
+    size_t routed = 0;
+    for(size_t i = 0; i < count ; i++) {
+        if(rrdeng_prep_query_plan(pdcs[i]))
+            to_route[routed++] = pdcs[i];
+    }
+
+    if(routed) {
         usec_t start_ut = now_monotonic_usec();
-        if(likely(pdc->priority == STORAGE_PRIORITY_SYNCHRONOUS))
-            pdc_route_synchronously(pdc->ctx, pdc);
-        else
-            pdc_route_asynchronously(pdc->ctx, pdc);
+        pdc_route_group_asynchronously(pdcs[0]->ctx, to_route, routed);
         __atomic_add_fetch(&rrdeng_cache_efficiency_stats.prep_time_to_route, now_monotonic_usec() - start_ut, __ATOMIC_RELAXED);
     }
-    else
-        completion_mark_complete(&pdc->page_completion);
 
-    completion_mark_complete(&pdc->prep_completion);
+    for(size_t i = 0; i < count ; i++) {
+        completion_mark_complete(&pdcs[i]->prep_completion);
+        pdc_release_and_destroy_if_unreferenced(pdcs[i], true, true);
+    }
+
+    if(pdcs != stack_pdcs)
+        freez(pdcs);
+}
+
+void rrdeng_prep_query(struct page_details_control *pdc, bool worker) {
+    if(worker)
+        worker_is_busy(UV_EVENT_DBENGINE_QUERY);
+
+    if(pdc->group_next)
+        rrdeng_prep_query_group(pdc);
 
-    pdc_release_and_destroy_if_unreferenced(pdc, true, true);
+    else {
+        if (rrdeng_prep_query_plan(pdc)) {
+            usec_t start_ut = now_monotonic_usec();
+            if(likely(pdc->priority == STORAGE_PRIORITY_SYNCHRONOUS))
+                pdc_route_synchronously(pdc->ctx, pdc);
+            else
+                pdc_route_asynchronously(pdc->ctx, pdc);
+            __atomic_add_fetch(&rrdeng_cache_efficiency_stats.prep_time_to_route, now_monotonic_usec() - start_ut, __ATOMIC_RELAXED);
+        }
+
+        completion_mark_complete(&pdc->prep_completion);
+
+        pdc_release_and_destroy_if_unreferenced(pdc, true, true);
+    }
 
     if(worker)
         worker_is_idle();
 }
 
+// ----------------------------------------------------------------------------
+// query groups
+// the queries a thread initializes between rrdeng_query_group_begin() and rrdeng_query_group_end()
+// are prepared together by one worker, so that they share their extent loads
+
+#define QUERY_GROUP_MAX_CTX 8
+#define QUERY_GROUP_MAX_QUERIES 256
+
+struct query_group_of_ctx {
+    struct rrdengine_instance *ctx;
+    PDC *first;
+    PDC *last;
+    size_t count;
+    STORAGE_PRIORITY priority;
+};
+
+static __thread struct {
+    size_t nesting;
+    struct query_group_of_ctx groups[QUERY_GROUP_MAX_CTX];
+} query_group = { 0 };
+
+static void pg_cache_query_group_submit(struct query_group_of_ctx *g) {
+    if(g->first)
+        rrdeng_enq_cmd(g->ctx, RRDENG_OPCODE_QUERY, g->first, NULL, g->priority, NULL, NULL);
+
+    *g = (struct query_group_of_ctx) { 0 };
+}
+
+static bool pg_cache_query_group_add(PDC *pdc) {
+    if(!query_group.nesting)
+        return false;
+
+    struct query_group_of_ctx *g = NULL;
+    for(size_t i = 0; i < QUERY_GROUP_MAX_CTX ; i++) {
+        if(query_group.groups[i].ctx == pdc->ctx) {
+            g = &query_group.groups[i];
+            break;
+        }
+
+        if(!g && !query_group.groups[i].ctx)
+            g = &query_group.groups[i];
+    }
+
+    if(!g)
+        return false;
+
+    if(!g->ctx) {
+        g->ctx = pdc->ctx;
+        g->priority = pdc->priority;
+    }
+
+    if(g->last)
+        g->last->group_next = pdc;
+    else
+        g->first = pdc;
+
+    g->last = pdc;
+
+    if(pdc->priority < g->priority)
+        g->priority = pdc->priority;
+
+    if(++g->count >= QUERY_GROUP_MAX_QUERIES)
+        pg_cache_query_group_submit(g);
+
+    return true;
+}
+
+void rrdeng_query_group_begin(void) {
+    query_group.nesting++;
+}
+
+void rrdeng_query_group_end(void) {
+    internal_fatal(!query_group.nesting, "DBENGINE: query group end without a begin");
+
+    if(!query_group.nesting || --query_group.nesting)
+        return;
+
+    for(size_t i = 0; i < QUERY_GROUP_MAX_CTX ; i++)
+        pg_cache_query_group_submit(&query_group.groups[i]);
+}
+
 /**
  * Searches for pages in a time range and triggers disk I/O if necessary and possible.
  * @param ctx DB context
@@ -827,7 +967,7 @@ void pg_cache_preload(struct rrdeng_query_handle *handle) {
 
         if(unlikely(handle->pdc->priority == STORAGE_PRIORITY_SYNCHRONOUS))
             rrdeng_prep_query(handle->pdc, false);
-        else
+        else if(!pg_cache_query_group_add(handle->pdc))
             rrdeng_enq_cmd(handle->ctx, RRDENG_OPCODE_QUERY, handle->pdc, NULL, handle->priority, NULL, NULL);
     }
     else {
@@ -836,6 +976,183 @@ void pg_cache_preload(struct rrdeng_query_handle *handle) {
     }
 }
 
+// ----------------------------------------------------------------------------
+// page cache warm start
+// on shutdown we save the index of the hottest clean pages of each tier, and on
+// the next startup we prefetch them in the background, at the lowest priority
+
+#define PG_CACHE_WARM_START_FILENAME "page-cache-warm-start"
+#define PG_CACHE_WARM_START_MAGIC 0x57474350 // PCGW
+#define PG_CACHE_WARM_START_VERSION 1
+
+struct pg_cache_warm_start_header {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t entries;
+};
+
+struct pg_cache_warm_start_entry {
+    uuid_t uuid;
+    int64_t start_time_s;
+    int64_t end_time_s;
+    uint32_t update_every_s;
+    uint32_t reserved;
+};
+
+static void pg_cache_warm_start_filename(struct rrdengine_instance *ctx, char *filename, size_t size) {
+    snprintfz(filename, size - 1, "%s/" PG_CACHE_WARM_START_FILENAME, ctx->config.dbfiles_path);
+}
+
+static int pg_cache_warm_start_entry_compar(const void *a, const void *b) {
+    const struct pg_cache_warm_start_entry *e1 = a, *e2 = b;
+
+    int ret = uuid_memcmp(&e1->uuid, &e2->uuid);
+    if(ret)
+        return ret;
+
+    if(e1->start_time_s < e2->start_time_s) return -1;
+    if(e1->start_time_s > e2->start_time_s) return 1;
+    return 0;
+}
+
+void pg_cache_warm_start_save(struct rrdengine_instance *ctx) {
+    if(!db_engine_warm_start_pages || ctx->config.legacy)
+        return;
+
+    char filename[FILENAME_MAX + 1];
+    pg_cache_warm_start_filename(ctx, filename, sizeof(filename));
+
+    PGC_ENTRY *pages = mallocz(db_engine_warm_start_pages * sizeof(PGC_ENTRY));
+    size_t count = pgc_clean_pages_of_section_mru(main_cache, (Word_t)ctx, pages, db_engine_warm_start_pages);
+    if(!count) {
+        freez(pages);
+        unlink(filename);
+        return;
+    }
+
+    struct pg_cache_warm_start_entry *entries = callocz(count, sizeof(*entries));
+    for(size_t i = 0; i < count; i++) {
+        uuid_copy(entries[i].uuid, *mrg_metric_uuid(main_mrg, (METRIC *)pages[i].metric_id));
+        entries[i].start_time_s = pages[i].start_time_s;
+        entries[i].end_time_s = pages[i].end_time_s;
+        entries[i].update_every_s = pages[i].update_every_s;
+    }
+    freez(pages);
+
+    // sort them, so that consecutive pages of the same metric can be loaded with one query
+    qsort(entries, count, sizeof(*entries), pg_cache_warm_start_entry_compar);
+
+    struct pg_cache_warm_start_header header = {
+            .magic = PG_CACHE_WARM_START_MAGIC,
+            .version = PG_CACHE_WARM_START_VERSION,
+            .entries = count,
+    };
+
+    bool ok = false;
+    FILE *fp = fopen(filename, "w");
+    if(fp) {
+        ok = fwrite(&header, sizeof(header), 1, fp) == 1 &&
+             fwrite(entries, sizeof(*entries), count, fp) == count;
+
+        if(fclose(fp) != 0)
+            ok = false;
+    }
+
+    if(!ok) {
+        netdata_log_error("DBENGINE: cannot save the page cache warm start file '%s'", filename);
+        unlink(filename);
+    }
+    else
+        netdata_log_info("DBENGINE: saved %zu pages of tier %d for warm starting the page cache", count, ctx->config.tier);
+
+    freez(entries);
+}
+
+static void pg_cache_prefetch(struct rrdengine_instance *ctx, METRIC *metric, time_t start_time_s, time_t end_time_s, STORAGE_PRIORITY priority) {
+    __atomic_add_fetch(&ctx->atomic.inflight_queries, 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&rrdeng_cache_efficiency_stats.currently_running_queries, 1, __ATOMIC_RELAXED);
+
+    PDC *pdc = pdc_get();
+    pdc->metric = mrg_metric_dup(main_mrg, metric);
+    pdc->start_time_s = start_time_s;
+    pdc->end_time_s = end_time_s;
+    pdc->priority = priority;
+    pdc->optimal_end_time_s = end_time_s;
+    pdc->ctx = ctx;
+    pdc->refcount = 1; // there is no query thread, only the prep thread
+    spinlock_init(&pdc->refcount_spinlock);
+    completion_init(&pdc->prep_completion);
+    completion_init(&pdc->page_completion);
+
+    rrdeng_enq_cmd(ctx, RRDENG_OPCODE_QUERY, pdc, NULL, priority, NULL, NULL);
+}
+
+void pg_cache_warm_start_load(struct rrdengine_instance *ctx) {
+    if(ctx->config.legacy)
+        return;
+
+    char filename[FILENAME_MAX + 1];
+    pg_cache_warm_start_filename(ctx, filename, sizeof(filename));
+
+    FILE *fp = fopen(filename, "r");
+    if(!fp)
+        return;
+
+    struct pg_cache_warm_start_entry *entries = NULL;
+    struct pg_cache_warm_start_header header = { 0 };
+    bool ok = fread(&header, sizeof(header), 1, fp) == 1 &&
+              header.magic == PG_CACHE_WARM_START_MAGIC &&
+              header.version == PG_CACHE_WARM_START_VERSION &&
+              header.entries && header.entries <= db_engine_warm_start_pages;
+
+    if(ok) {
+        entries = mallocz(header.entries * sizeof(*entries));
+        ok = fread(entries, sizeof(*entries), header.entries, fp) == header.entries;
+    }
+
+    fclose(fp);
+
+    // the file is used only once - it is saved again on the next shutdown
+    unlink(filename);
+
+    if(!ok || !ctx_is_available_for_queries(ctx)) {
+        freez(entries);
+        return;
+    }
+
+    size_t queries = 0, pages = 0;
+    for(size_t i = 0; i < header.entries ;) {
+        struct pg_cache_warm_start_entry *first = &entries[i];
+        time_t start_time_s = first->start_time_s;
+        time_t end_time_s = first->end_time_s;
+
+        // merge the consecutive pages of the same metric into one query
+        for(i++; i < header.entries ; i++) {
+            struct pg_cache_warm_start_entry *e = &entries[i];
+            if(uuid_memcmp(&e->uuid, &first->uuid) != 0 ||
+               e->start_time_s > end_time_s + (time_t)e->update_every_s)
+                break;
+
+            if(e->end_time_s > end_time_s)
+                end_time_s = e->end_time_s;
+        }
+        pages += &entries[i] - first;
+
+        METRIC *metric = mrg_metric_get_and_acquire(main_mrg, &first->uuid, (Word_t)ctx);
+        if(!metric)
+            continue;
+
+        pg_cache_prefetch(ctx, metric, start_time_s, end_time_s, STORAGE_PRIORITY_BEST_EFFORT);
+        mrg_metric_release(main_mrg, metric);
+        queries++;
+    }
+
+    freez(entries);
+
+    netdata_log_info("DBENGINE: warm starting the page cache of tier %d with %zu pages, using %zu background queries",
+                     ctx->config.tier, pages, queries);
+}
+
 /*
  * Searches for the first page between start_time and end_time and gets a reference.
  * start_time and end_time are inclusive.
@@ -1076,7 +1393,8 @@ void pgc_and_mrg_initialize(void)
             10240,                                      // if there are that many threads, evict so many at once!
             1000,                           //
             5,                                          // don't delay too much other threads
-            PGC_OPTIONS_AUTOSCALE,                               // AUTOSCALE = 2x max hot pages
+            PGC_OPTIONS_AUTOSCALE |                              // AUTOSCALE = 2x max hot pages
+            (db_engine_scan_resistant_eviction ? PGC_OPTIONS_EVICT_SCAN_RESISTANT : PGC_OPTIONS_NONE),
             0,                                                 // 0 = as many as the system cpus
             0
     );
@@ -1109,7 +1427,8 @@ void pgc_and_mrg_initialize(void)
             10,                                         // it will lose up to that extents at once!
             100,                            //
             2,                                          // don't delay too much other threads
-            PGC_OPTIONS_AUTOSCALE | PGC_OPTIONS_EVICT_PAGES_INLINE | PGC_OPTIONS_FLUSH_PAGES_INLINE,
+            PGC_OPTIONS_AUTOSCALE | PGC_OPTIONS_EVICT_PAGES_INLINE | PGC_OPTIONS_FLUSH_PAGES_INLINE |
+            (db_engine_scan_resistant_eviction ? PGC_OPTIONS_EVICT_SCAN_RESISTANT : PGC_OPTIONS_NONE),
             0,                                                 // 0 = as many as the system cpus
             0
     );
@@ -2,6 +2,10 @@
 #define NETDATA_RRD_INTERNALS
 #include "pdc.h"
 
+#ifdef ENABLE_LIBURING
+#include <liburing.h>
+#endif
+
 struct extent_page_details_list {
     uv_file file;
     uint64_t extent_offset;
@@ -14,6 +18,8 @@ struct extent_page_details_list {
     struct rrdeng_cmd *cmd;
     bool head_to_datafile_extent_queries_pending_for_extent;
 
+    PGC_PAGE *extent_cache_page; // the extent, acquired, when the router has read it in a batch
+
     struct {
         struct extent_page_details_list *prev;
         struct extent_page_details_list *next;
@@ -279,6 +285,10 @@ static void epdl_destroy(EPDL *epdl)
         PDCJudyLFreeArray(pd_by_start_time_s_JudyL, PJE0);
 
     PDCJudyLFreeArray(&epdl->page_details_by_metric_id_JudyL, PJE0);
+
+    if(epdl->extent_cache_page)
+        pgc_page_release(extent_cache, epdl->extent_cache_page);
+
     epdl_release(epdl);
 }
 
@@ -494,7 +504,431 @@ static void epdl_pending_del(EPDL *epdl) {
     spinlock_unlock(&epdl->datafile->extent_queries.spinlock);
 }
 
-void pdc_to_epdl_router(struct rrdengine_instance *ctx, PDC *pdc, execute_extent_page_details_list_t exec_first_extent_list, execute_extent_page_details_list_t exec_rest_extent_list)
+// ----------------------------------------------------------------------------
+// batched extent reads
+
+#define EXTENT_READ_BATCH_MAX 32
+
+struct extent_read {
+    struct rrdengine_datafile *datafile;
+    uv_file file;
+    uint64_t pos;               // the offset of the first extent
+    uint64_t end;               // the end of the last extent
+    unsigned size;              // the bytes to read, aligned
+    bool read_ahead;            // the read extends past the last extent
+    void *buffer;
+    int ret;
+
+    EPDL **epdls;               // the EPDLs served by this read
+    size_t count;
+};
+
+static PGC_PAGE *extent_cache_add_and_acquire(struct rrdengine_instance *ctx, struct rrdengine_datafile *datafile, uint64_t extent_offset, uint32_t extent_size, void *data) {
+    void *copied_extent_compressed_data = dbengine_extent_alloc(extent_size);
+    memcpy(copied_extent_compressed_data, data, extent_size);
+
+    bool added = false;
+    PGC_PAGE *extent_cache_page = pgc_page_add_and_acquire(extent_cache, (PGC_ENTRY) {
+            .hot = false,
+            .section = (Word_t) ctx,
+            .metric_id = (Word_t) datafile->fileno,
+            .start_time_s = (time_t) extent_offset,
+            .size = extent_size,
+            .end_time_s = 0,
+            .update_every_s = 0,
+            .data = copied_extent_compressed_data,
+    }, &added);
+
+    if (!added) {
+        dbengine_extent_free(copied_extent_compressed_data, extent_size);
+        internal_fatal(extent_size != pgc_page_data_size(extent_cache, extent_cache_page),
+                       "DBENGINE: cache size does not match the expected size");
+    }
+
+    return extent_cache_page;
+}
+
+static void datafile_extents_read_synchronously(struct extent_read *r) {
+    uv_fs_t request;
+    uv_buf_t iov = uv_buf_init(r->buffer, r->size);
+    r->ret = uv_fs_read(NULL, &request, r->file, &iov, 1, (int64_t)r->pos, NULL);
+    uv_fs_req_cleanup(&request);
+}
+
+#ifdef ENABLE_LIBURING
+static __thread struct {
+    bool initialized;
+    bool failed;
+    struct io_uring ring;
+} extent_uring = { 0 };
+
+static bool extent_uring_get(void) {
+    if(likely(extent_uring.initialized))
+        return true;
+
+    if(extent_uring.failed)
+        return false;
+
+    int ret = io_uring_queue_init(EXTENT_READ_BATCH_MAX, &extent_uring.ring, 0);
+    if(ret < 0) {
+        extent_uring.failed = true;
+        nd_log(NDLS_DAEMON, NDLP_NOTICE,
+               "DBENGINE: io_uring_queue_init() failed (%s), this thread will read extents without io_uring",
+               strerror(-ret));
+        return false;
+    }
+
+    extent_uring.initialized = true;
+    return true;
+}
+
+static void extent_uring_disable(void) {
+    io_uring_queue_exit(&extent_uring.ring);
+    extent_uring.initialized = false;
+    extent_uring.failed = true;
+}
+
+// asks the kernel to cancel the reads still in flight
+// returns the number of reads that were queued but not submitted before, and got submitted now
+static size_t extent_uring_cancel(struct extent_read *reads, size_t count, size_t submitted, bool *in_flight) {
+    for(size_t i = 0; i < submitted ; i++) {
+        if(!in_flight[i])
+            continue;
+
+        // the unsubmitted reads are the only other entries in the submission queue, so there is space
+        struct io_uring_sqe *sqe = io_uring_get_sqe(&extent_uring.ring);
+        if(!sqe)
+            break;
+
+        io_uring_prep_cancel(sqe, &reads[i], 0);
+        io_uring_sqe_set_data(sqe, NULL);
+    }
+
+    // the kernel consumes the submission queue in order,
+    // so the unsubmitted reads go before the cancellations
+    int ret = io_uring_submit(&extent_uring.ring);
+    if(ret <= 0)
+        return 0;
+
+    size_t added = MIN((size_t)ret, count - submitted);
+    for(size_t i = submitted; i < submitted + added ; i++)
+        in_flight[i] = true;
+
+    return added;
+}
+
+static void datafile_extents_read_uring(struct extent_read *reads, size_t count) {
+    bool in_flight[EXTENT_READ_BATCH_MAX] = { 0 };
+
+    for(size_t i = 0; i < count; i++) {
+        // the ring has EXTENT_READ_BATCH_MAX entries and it is empty, so we always get one
+        struct io_uring_sqe *sqe = io_uring_get_sqe(&extent_uring.ring);
+        io_uring_prep_read(sqe, reads[i].file, reads[i].buffer, reads[i].size, reads[i].pos);
+        io_uring_sqe_set_data(sqe, &reads[i]);
+    }
+
+    int ret = io_uring_submit(&extent_uring.ring);
+    size_t submitted = (ret < 0) ? 0 : (size_t)ret;
+    for(size_t i = 0; i < submitted ; i++)
+        in_flight[i] = true;
+
+    // This waits on purpose: the caller needs all the extents of the batch before
+    // it dispatches its EPDLs to the workers. The reads are in flight together,
+    // so the batch takes about as long as its slowest read.
+    bool cancelled = false;
+    for(size_t done = 0; done < submitted ;) {
+        struct io_uring_cqe *cqe;
+        ret = io_uring_wait_cqe(&extent_uring.ring, &cqe);
+        if(unlikely(ret == -EINTR))
+            continue;
+
+        if(unlikely(ret < 0)) {
+            nd_log_limit_static_global_var(erl, 1, 0);
+            nd_log_limit(&erl, NDLS_DAEMON, NDLP_ERR,
+                         "DBENGINE: io_uring_wait_cqe() failed with %zu reads in flight (%s), "
+                         "this thread will read extents without io_uring",
+                         submitted - done, strerror(-ret));
+
+            if(!cancelled) {
+                // the kernel writes to the buffers of the reads in flight, even after
+                // the ring is torn down - so they have to complete before we continue
+                cancelled = true;
+                submitted += extent_uring_cancel(reads, count, submitted, in_flight);
+                continue;
+            }
+
+            // we cannot wait for them - leave their buffers to the kernel
+            // and give the caller new ones, to read them synchronously
+            for(size_t i = 0; i < count ; i++) {
+                if(!in_flight[i])
+                    continue;
+
+                int err = posix_memalign(&reads[i].buffer, RRDFILE_ALIGNMENT, reads[i].size);
+                if (unlikely(err))
+                    fatal("DBENGINE: posix_memalign(): %s", strerror(err));
+
+                reads[i].ret = -ECANCELED;
+            }
+            break;
+        }
+
+        // the completions of the cancellations have no data
+        struct extent_read *r = io_uring_cqe_get_data(cqe);
+        if(r) {
+            r->ret = cqe->res;
+            in_flight[r - reads] = false;
+            done++;
+        }
+        io_uring_cqe_seen(&extent_uring.ring, cqe);
+    }
+
+    if(unlikely(cancelled || submitted != count)) {
+        // the unsubmitted reads are still in the submission queue,
+        // so this ring cannot be reused - the caller reads them without it
+        if(!cancelled)
+            nd_log(NDLS_DAEMON, NDLP_NOTICE,
+                   "DBENGINE: io_uring submitted %zu of %zu extent reads, this thread will read extents without io_uring",
+                   submitted, count);
+
+        extent_uring_disable();
+    }
+}
+#endif
+
+static inline size_t extent_read_batch_size(void) {
+    if(db_engine_extent_coalescing_max_size || db_engine_read_ahead_size)
+        return EXTENT_READ_BATCH_MAX;
+
+#ifdef ENABLE_LIBURING
+    if(db_engine_use_io_uring && !extent_uring.failed)
+        return EXTENT_READ_BATCH_MAX;
+#endif
+
+    return 1;
+}
+
+// walk the extents that follow the last extent of a read and add
+// the complete and valid ones to the extent cache
+static size_t extents_read_ahead_to_extent_cache(struct rrdengine_instance *ctx, struct extent_read *r, uint64_t available) {
+    size_t extents = 0;
+    uint64_t pos = ALIGN_BYTES_CEILING(r->end);
+
+    while(pos + sizeof(struct rrdeng_df_extent_header) <= available) {
+        struct rrdeng_df_extent_header *header = (void *)((uint8_t *)r->buffer + (pos - r->pos));
+        if(!header->number_of_pages || header->number_of_pages > MAX_PAGES_PER_EXTENT)
+            break;
+
+        uint64_t size = sizeof(*header) + header->number_of_pages * sizeof(header->descr[0]) +
+                        header->payload_length + sizeof(struct rrdeng_df_extent_trailer);
+
+        if(pos + size > available)
+            break;
+
+        struct rrdeng_df_extent_trailer *trailer = (void *)((uint8_t *)header + size - sizeof(*trailer));
+        uLong crc = crc32(0L, Z_NULL, 0);
+        crc = crc32(crc, (uint8_t *)header, size - sizeof(*trailer));
+        if(crc32cmp(trailer->checksum, crc))
+            break;
+
+        PGC_PAGE *extent_cache_page = extent_cache_add_and_acquire(ctx, r->datafile, pos, size, header);
+        pgc_page_release(extent_cache, extent_cache_page);
+        extents++;
+
+        pos = ALIGN_BYTES_CEILING(pos + size);
+    }
+
+    return extents;
+}
+
+// read the extents of a batch of EPDLs that are not in the extent cache,
+// merging neighbouring extents of the same datafile into single reads and
+// submitting the reads in one go when io_uring is available; the extents
+// read are attached to their EPDLs, so that the workers will not read them
+// again - anything not read here, the workers read it themselves
+static void epdl_read_extents_in_batch(struct rrdengine_instance *ctx, EPDL **epdls, size_t count) {
+    EPDL *targets[EXTENT_READ_BATCH_MAX];
+    struct extent_read reads[EXTENT_READ_BATCH_MAX];
+    size_t used = 0, t = 0;
+
+    for(size_t i = 0; i < count && t < EXTENT_READ_BATCH_MAX ; i++) {
+        EPDL *epdl = epdls[i];
+
+        if(__atomic_load_n(&epdl->pdc->workers_should_stop, __ATOMIC_RELAXED))
+            continue;
+
+        PGC_PAGE *extent_cache_page = pgc_page_get_and_acquire(
+                extent_cache, (Word_t)ctx,
+                (Word_t)epdl->datafile->fileno, (time_t)epdl->extent_offset,
+                PGC_SEARCH_EXACT);
+
+        if(extent_cache_page) {
+            pgc_page_release(extent_cache, extent_cache_page);
+            continue;
+        }
+
+        uint64_t end = epdl->extent_offset + epdl->extent_size;
+        struct extent_read *r = used ? &reads[used - 1] : NULL;
+
+        if(r && r->datafile == epdl->datafile && epdl->extent_offset >= r->end &&
+           epdl->extent_offset - r->end <= db_engine_extent_coalescing_max_gap &&
+           end - r->pos <= db_engine_extent_coalescing_max_size) {
+            r->end = end;
+            r->count++;
+        }
+        else {
+            r = &reads[used++];
+            *r = (struct extent_read) {
+                    .datafile = epdl->datafile,
+                    .file = epdl->file,
+                    .pos = epdl->extent_offset,
+                    .end = end,
+                    .ret = -ECANCELED,
+                    .epdls = &targets[t],
+                    .count = 1,
+            };
+        }
+
+        targets[t++] = epdl;
+    }
+
+    bool with_uring = false;
+#ifdef ENABLE_LIBURING
+    with_uring = db_engine_use_io_uring && used > 1 && extent_uring_get();
+#endif
+
+    // decide which reads are worth doing here
+    size_t to_read = 0;
+    for(size_t i = 0; i < used ; i++) {
+        struct extent_read *r = &reads[i];
+
+        uint64_t read_ahead = 0;
+        if(db_engine_read_ahead_size && (i + 1 == used || reads[i + 1].datafile != r->datafile)) {
+            uint64_t written = __atomic_load_n(&r->datafile->pos, __ATOMIC_RELAXED);
+            if(written > r->end)
+                read_ahead = MIN(db_engine_read_ahead_size, written - r->end);
+        }
+
+        // a single extent is better left to its worker, to be read in parallel with the rest
+        if(!with_uring && r->count == 1 && !read_ahead)
+            continue;
+
+        r->read_ahead = read_ahead > 0;
+        r->size = ALIGN_BYTES_CEILING(r->end + read_ahead - r->pos);
+
+        int ret = posix_memalign(&r->buffer, RRDFILE_ALIGNMENT, r->size);
+        if (unlikely(ret))
+            fatal("DBENGINE: posix_memalign(): %s", strerror(ret));
+
+        reads[to_read++] = *r;
+    }
+
+    if(!to_read)
+        return;
+
+#ifdef ENABLE_LIBURING
+    if(with_uring)
+        datafile_extents_read_uring(reads, to_read);
+#endif
+
+    size_t extents_coalesced = 0, extents_read_ahead = 0;
+    for(size_t i = 0; i < to_read ; i++) {
+        struct extent_read *r = &reads[i];
+
+        if(!with_uring || r->ret == -ECANCELED)
+            datafile_extents_read_synchronously(r);
+
+        if(r->ret < 0) {
+            ctx_io_error(ctx);
+            posix_memfree(r->buffer);
+            continue;
+        }
+
+        ctx_io_read_op_bytes(ctx, r->size);
+
+        uint64_t available = r->pos + (uint64_t)r->ret;
+        for(size_t k = 0; k < r->count ; k++) {
+            EPDL *epdl = r->epdls[k];
+
+            if(epdl->extent_offset + epdl->extent_size <= available)
+                epdl->extent_cache_page = extent_cache_add_and_acquire(
+                        ctx, epdl->datafile, epdl->extent_offset, epdl->extent_size,
+                        (uint8_t *)r->buffer + (epdl->extent_offset - r->pos));
+        }
+
+        if(r->count > 1)
+            extents_coalesced += r->count;
+
+        if(r->read_ahead)
+            extents_read_ahead += extents_read_ahead_to_extent_cache(ctx, r, available);
+
+        posix_memfree(r->buffer);
+    }
+
+    if(extents_coalesced)
+        __atomic_add_fetch(&rrdeng_cache_efficiency_stats.extents_coalesced, extents_coalesced, __ATOMIC_RELAXED);
+
+    if(extents_read_ahead)
+        __atomic_add_fetch(&rrdeng_cache_efficiency_stats.extents_read_ahead, extents_read_ahead, __ATOMIC_RELAXED);
+}
+
+static void epdl_dispatch_batch(struct rrdengine_instance *ctx, EPDL **epdls, size_t count, size_t *extent_list_no, enum storage_priority priority,
+                                execute_extent_page_details_list_t exec_first_extent_list, execute_extent_page_details_list_t exec_rest_extent_list) {
+    if(count > 1)
+        epdl_read_extents_in_batch(ctx, epdls, count);
+
+    for(size_t i = 0; i < count ; i++) {
+        if ((*extent_list_no)++ == 0)
+            exec_first_extent_list(ctx, epdls[i], priority);
+        else
+            exec_rest_extent_list(ctx, epdls[i], priority);
+    }
+}
+
+// the router of a single query dispatches its extents while it finds them,
+// a query group collects the extents of all its queries before dispatching them
+struct epdl_router {
+    struct rrdengine_instance *ctx;
+    enum storage_priority priority;
+    execute_extent_page_details_list_t exec_first_extent_list;
+    execute_extent_page_details_list_t exec_rest_extent_list;
+    size_t extent_list_no;
+
+    size_t batch_size;
+    size_t used;
+    size_t size;
+    EPDL **epdls;
+    EPDL *batch[EXTENT_READ_BATCH_MAX];
+};
+
+static void epdl_router_add(struct epdl_router *router, EPDL *epdl, bool collect) {
+    if(collect) {
+        if(router->used == router->size) {
+            router->size = router->size ? router->size * 2 : 64;
+            router->epdls = reallocz(router->epdls, router->size * sizeof(EPDL *));
+        }
+
+        router->epdls[router->used++] = epdl;
+        return;
+    }
+
+    if(!router->extent_list_no) {
+        // the first extent of the query goes to the workers immediately,
+        // only the ones following it wait to be read in batches
+        epdl_dispatch_batch(router->ctx, &epdl, 1, &router->extent_list_no, router->priority,
+                            router->exec_first_extent_list, router->exec_rest_extent_list);
+        return;
+    }
+
+    router->batch[router->used++] = epdl;
+
+    if(router->used >= router->batch_size) {
+        epdl_dispatch_batch(router->ctx, router->batch, router->used, &router->extent_list_no, router->priority,
+                            router->exec_first_extent_list, router->exec_rest_extent_list);
+        router->used = 0;
+    }
+}
+
+static void pdc_to_pending_epdls(PDC *pdc, struct epdl_router *router, bool collect)
 {
     Pvoid_t *PValue;
     Pvoid_t *PValue1;
@@ -562,7 +996,6 @@ void pdc_to_epdl_router(struct rrdengine_instance *ctx, PDC *pdc, execute_extent
             *pd_pptr = pd;
         }
 
-        size_t extent_list_no = 0;
         Word_t datafile_no = 0;
         first_then_next = true;
         while((PValue = PDCJudyLFirstThenNext(JudyL_datafile_list, &datafile_no, &first_then_next))) {
@@ -581,22 +1014,81 @@ void pdc_to_epdl_router(struct rrdengine_instance *ctx, PDC *pdc, execute_extent
                 pdc_acquire(pdc); // we do this for the next worker: do_read_extent_work()
                 epdl->pdc = pdc;
 
-                if(epdl_pending_add(epdl)) {
-                    if (extent_list_no++ == 0)
-                        exec_first_extent_list(ctx, epdl, pdc->priority);
-                    else
-                        exec_rest_extent_list(ctx, epdl, pdc->priority);
-                }
+                if(epdl_pending_add(epdl))
+                    epdl_router_add(router, epdl, collect);
             }
             PDCJudyLFreeArray(&deol->extent_pd_list_by_extent_offset_JudyL, PJE0);
             deol_release(deol);
         }
+
         PDCJudyLFreeArray(&JudyL_datafile_list, PJE0);
     }
+}
+
+void pdc_to_epdl_router(struct rrdengine_instance *ctx, PDC *pdc, execute_extent_page_details_list_t exec_first_extent_list, execute_extent_page_details_list_t exec_rest_extent_list)
+{
+    struct epdl_router router = {
+            .ctx = ctx,
+            .priority = pdc->priority,
+            .exec_first_extent_list = exec_first_extent_list,
+            .exec_rest_extent_list = exec_rest_extent_list,
+            .batch_size = extent_read_batch_size(),
+    };
+
+    pdc_to_pending_epdls(pdc, &router, false);
+
+    if(router.used)
+        epdl_dispatch_batch(ctx, router.batch, router.used, &router.extent_list_no, router.priority,
+                            exec_first_extent_list, exec_rest_extent_list);
 
     pdc_release_and_destroy_if_unreferenced(pdc, true, true);
 }
 
+static int epdl_compar_by_datafile_and_offset(const void *a, const void *b) {
+    const EPDL *e1 = *(const EPDL **)a, *e2 = *(const EPDL **)b;
+
+    if(e1->datafile->fileno < e2->datafile->fileno) return -1;
+    if(e1->datafile->fileno > e2->datafile->fileno) return 1;
+    if(e1->extent_offset < e2->extent_offset) return -1;
+    if(e1->extent_offset > e2->extent_offset) return 1;
+    return 0;
+}
+
+// route the queries of a query group together: an extent needed by more than one of them is read
+// once (the EPDLs of the same extent are merged while pending), and the extents of all of them are
+// dispatched in datafile order, so that the batched reads can merge neighbouring extents of different metrics
+void pdc_group_to_epdl_router(struct rrdengine_instance *ctx, PDC **pdcs, size_t count, execute_extent_page_details_list_t exec_first_extent_list, execute_extent_page_details_list_t exec_rest_extent_list)
+{
+    struct epdl_router router = {
+            .ctx = ctx,
+            .priority = STORAGE_PRIORITY_INTERNAL_MAX_DONT_USE,
+            .exec_first_extent_list = exec_first_extent_list,
+            .exec_rest_extent_list = exec_rest_extent_list,
+            .batch_size = extent_read_batch_size(),
+    };
+
+    for(size_t i = 0; i < count ; i++) {
+        if(pdcs[i]->priority < router.priority)
+            router.priority = pdcs[i]->priority;
+
+        pdc_to_pending_epdls(pdcs[i], &router, true);
+    }
+
+    if(router.used > 1)
+        qsort(router.epdls, router.used, sizeof(EPDL *), epdl_compar_by_datafile_and_offset);
+
+    // the first extent goes to the workers alone, without waiting for a batch read
+    for(size_t i = 0, n = 1; i < router.used ; i += n, n = router.batch_size) {
+        n = MIN(n, router.used - i);
+        epdl_dispatch_batch(ctx, &router.epdls[i], n, &router.extent_list_no, router.priority,
+                            exec_first_extent_list, exec_rest_extent_list);
+    }
+    freez(router.epdls);
+
+    for(size_t i = 0; i < count ; i++)
+        pdc_release_and_destroy_if_unreferenced(pdcs[i], true, true);
+}
+
 void collect_page_flags_to_buffer(BUFFER *wb, RRDENG_COLLECT_PAGE_FLAGS flags) {
     if(flags & RRDENG_PAGE_PAST_COLLECTION)
         buffer_strcat(wb, "PAST_COLLECTION ");
@@ -641,6 +1133,7 @@ inline VALIDATED_PAGE_DESCRIPTOR validate_extent_page_descr(const struct rrdeng_
             entries = 0;
             break;
         case PAGE_GORILLA_METRICS:
+        case PAGE_GORILLA_TIER:
             end_time_s = start_time_s + descr->gorilla.delta_time_s;
             entries = descr->gorilla.entries;
             break;
@@ -697,6 +1190,7 @@ VALIDATED_PAGE_DESCRIPTOR validate_page(
                 entries = vd.entries;
             break;
         case PAGE_GORILLA_METRICS:
+        case PAGE_GORILLA_TIER:
             internal_fatal(entries == 0, "0 number of entries found on gorilla page");
             vd.entries = entries;
             break;
@@ -875,6 +1369,7 @@ static void epdl_extent_loading_error_log(struct rrdengine_instance *ctx, EPDL *
                 end_time_s = (time_t)(descr->end_time_ut / USEC_PER_SEC);
                 break;
             case PAGE_GORILLA_METRICS:
+            case PAGE_GORILLA_TIER:
                 end_time_s = (time_t) start_time_s + (descr->gorilla.delta_time_s);
                 break;
         }
@@ -928,6 +1423,38 @@ static void epdl_extent_loading_error_log(struct rrdengine_instance *ctx, EPDL *
                 msg);
 }
 
+static inline bool extent_compression_algorithm_is_supported(uint8_t algorithm) {
+    switch(algorithm) {
+        case RRD_NO_COMPRESSION:
+        case RRD_LZ4:
+#ifdef ENABLE_ZSTD
+        case RRD_ZSTD:
+#endif
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+#ifdef ENABLE_ZSTD
+static int extent_decompress_zstd(const void *src, size_t src_size, void *dst, size_t dst_size) {
+    // decompression contexts are reused, one per thread
+    static __thread ZSTD_DCtx *dctx = NULL;
+    if(unlikely(!dctx)) {
+        dctx = ZSTD_createDCtx();
+        if(unlikely(!dctx))
+            return -1;
+    }
+
+    size_t ret = ZSTD_decompressDCtx(dctx, dst, dst_size, src, src_size);
+    if(unlikely(ZSTD_isError(ret)))
+        return -1;
+
+    return (int)ret;
+}
+#endif
+
 static bool epdl_populate_pages_from_extent_data(
         struct rrdengine_instance *ctx,
         void *data,
@@ -972,7 +1499,7 @@ static bool epdl_populate_pages_from_extent_data(
     if( !can_use_data ||
         count < 1 ||
         count > MAX_PAGES_PER_EXTENT ||
-        (header->compression_algorithm != RRD_NO_COMPRESSION && header->compression_algorithm != RRD_LZ4) ||
+        !extent_compression_algorithm_is_supported(header->compression_algorithm) ||
         (payload_length != trailer_offset - payload_offset) ||
         (data_length != payload_offset + payload_length + sizeof(*trailer))
             ) {
@@ -1014,9 +1541,22 @@ static bool epdl_populate_pages_from_extent_data(
             eb = extent_buffer_get(uncompressed_payload_length);
             uncompressed_buf = eb->data;
 
+#ifdef ENABLE_ZSTD
+            if(header->compression_algorithm == RRD_ZSTD)
+                ret = extent_decompress_zstd(data + payload_offset, payload_length,
+                                             uncompressed_buf, uncompressed_payload_length);
+            else
+#endif
             ret = LZ4_decompress_safe(data + payload_offset, uncompressed_buf,
                                       (int) payload_length, (int) uncompressed_payload_length);
 
+            if(unlikely(ret != (int) uncompressed_payload_length)) {
+                ctx_io_error(ctx);
+                have_read_error = true;
+                epdl_extent_loading_error_log(ctx, epdl, NULL, "decompression FAILED");
+                ret = 0;
+            }
+
             __atomic_add_fetch(&ctx->stats.before_decompress_bytes, payload_length, __ATOMIC_RELAXED);
             __atomic_add_fetch(&ctx->stats.after_decompress_bytes, ret, __ATOMIC_RELAXED);
         }
@@ -1227,12 +1767,24 @@ void epdl_find_extent_and_populate_pages(struct rrdengine_instance *ctx, EPDL *e
     bool extent_found_in_cache = false;
 
     void *extent_compressed_data = NULL;
-    PGC_PAGE *extent_cache_page = pgc_page_get_and_acquire(
-            extent_cache, (Word_t)ctx,
-            (Word_t)epdl->datafile->fileno, (time_t)epdl->extent_offset,
-            PGC_SEARCH_EXACT);
 
-    if(extent_cache_page) {
+    // the router may have read it already, in a batch
+    PGC_PAGE *extent_cache_page = epdl->extent_cache_page;
+    bool extent_read_by_router = extent_cache_page != NULL;
+    epdl->extent_cache_page = NULL;
+
+    if(!extent_cache_page)
+        extent_cache_page = pgc_page_get_and_acquire(
+                extent_cache, (Word_t)ctx,
+                (Word_t)epdl->datafile->fileno, (time_t)epdl->extent_offset,
+                PGC_SEARCH_EXACT);
+
+    if(extent_read_by_router) {
+        extent_compressed_data = pgc_page_data(extent_cache_page);
+        loaded_pages_tag |= PDC_PAGE_EXTENT_FROM_DISK;
+        not_loaded_pages_tag |= PDC_PAGE_EXTENT_FROM_DISK;
+    }
+    else if(extent_cache_page) {
         extent_compressed_data = pgc_page_data(extent_cache_page);
         internal_fatal(epdl->extent_size != pgc_page_data_size(extent_cache, extent_cache_page),
                        "DBENGINE: cache size does not match the expected size");
@@ -1247,31 +1799,11 @@ void epdl_find_extent_and_populate_pages(struct rrdengine_instance *ctx, EPDL *e
 
         void *extent_data = datafile_extent_read(ctx, epdl->file, epdl->extent_offset, epdl->extent_size);
         if(extent_data != NULL) {
-
-            void *copied_extent_compressed_data = dbengine_extent_alloc(epdl->extent_size);
-            memcpy(copied_extent_compressed_data, extent_data, epdl->extent_size);
-            datafile_extent_read_free(extent_data);
-
             if(worker)
                 worker_is_busy(UV_EVENT_DBENGINE_EXTENT_CACHE_LOOKUP);
 
-            bool added = false;
-            extent_cache_page = pgc_page_add_and_acquire(extent_cache, (PGC_ENTRY) {
-                    .hot = false,
-                    .section = (Word_t) ctx,
-                    .metric_id = (Word_t) epdl->datafile->fileno,
-                    .start_time_s = (time_t) epdl->extent_offset,
-                    .size = epdl->extent_size,
-                    .end_time_s = 0,
-                    .update_every_s = 0,
-                    .data = copied_extent_compressed_data,
-            }, &added);
-
-            if (!added) {
-                dbengine_extent_free(copied_extent_compressed_data, epdl->extent_size);
-                internal_fatal(epdl->extent_size != pgc_page_data_size(extent_cache, extent_cache_page),
-                               "DBENGINE: cache size does not match the expected size");
-            }
+            extent_cache_page = extent_cache_add_and_acquire(ctx, epdl->datafile, epdl->extent_offset, epdl->extent_size, extent_data);
+            datafile_extent_read_free(extent_data);
 
             extent_compressed_data = pgc_page_data(extent_cache_page);
 
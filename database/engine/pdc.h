@@ -32,6 +32,7 @@ struct rrdeng_cmd;
 typedef struct extent_page_details_list EPDL;
 typedef void (*execute_extent_page_details_list_t)(struct rrdengine_instance *ctx, EPDL *epdl, enum storage_priority priority);
 void pdc_to_epdl_router(struct rrdengine_instance *ctx, struct page_details_control *pdc, execute_extent_page_details_list_t exec_first_extent_list, execute_extent_page_details_list_t exec_rest_extent_list);
+void pdc_group_to_epdl_router(struct rrdengine_instance *ctx, struct page_details_control **pdcs, size_t count, execute_extent_page_details_list_t exec_first_extent_list, execute_extent_page_details_list_t exec_rest_extent_list);
 void epdl_find_extent_and_populate_pages(struct rrdengine_instance *ctx, EPDL *epdl, bool worker);
 
 size_t pdc_cache_size(void);
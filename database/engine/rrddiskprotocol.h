@@ -21,6 +21,7 @@
 
 #define RRD_NO_COMPRESSION (0)
 #define RRD_LZ4 (1)
+#define RRD_ZSTD (2)
 
 #define RRDENG_DF_SB_PADDING_SZ (RRDENG_BLOCK_SIZE - (RRDENG_MAGIC_SZ + RRDENG_VER_SZ + sizeof(uint8_t)))
 /*
@@ -39,7 +40,22 @@ struct rrdeng_df_sb {
 #define PAGE_METRICS    (0)
 #define PAGE_TIER       (1)
 #define PAGE_GORILLA_METRICS    (2)
-#define PAGE_TYPE_MAX   2   // Maximum page type (inclusive)
+#define PAGE_GORILLA_TIER       (3)
+#define PAGE_TYPE_MAX   3   // Maximum page type (inclusive)
+
+/*
+ * Gorilla tier page header
+ *
+ * PAGE_GORILLA_TIER pages store the points of a tier page column-wise.
+ * The header is followed by the gorilla bit streams of the sum, min and max
+ * values and the count/anomaly_count pairs, each padded to 32-bit words.
+ */
+#define RRDENG_GORILLA_TIER_COLUMNS (4)
+
+struct rrdeng_page_gorilla_tier_header {
+    uint32_t entries;
+    uint32_t nbits[RRDENG_GORILLA_TIER_COLUMNS];
+} __attribute__ ((packed));
 
 /*
  * Data file page descriptor
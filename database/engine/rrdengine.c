@@ -766,6 +766,31 @@ static struct rrdengine_datafile *get_datafile_to_write_extent(struct rrdengine_
     return datafile;
 }
 
+#ifdef ENABLE_ZSTD
+// returns the compressed size, or zero when the extent could not be compressed
+static int datafile_extent_compress_zstd(struct rrdengine_instance *ctx, const void *src, size_t src_size, void *dst, size_t dst_size) {
+    // compression contexts are expensive to create, so we keep one per thread
+    static __thread ZSTD_CCtx *cctx = NULL;
+    if(unlikely(!cctx)) {
+        cctx = ZSTD_createCCtx();
+        if(unlikely(!cctx)) {
+            netdata_log_error("DBENGINE: cannot create ZSTD compression context");
+            return 0;
+        }
+    }
+
+    int level = ctx->config.compression_level ? ctx->config.compression_level : ZSTD_CLEVEL_DEFAULT;
+
+    size_t ret = ZSTD_compressCCtx(cctx, dst, dst_size, src, src_size, level);
+    if(unlikely(ZSTD_isError(ret))) {
+        netdata_log_error("DBENGINE: ZSTD compression of extent failed: %s", ZSTD_getErrorName(ret));
+        return 0;
+    }
+
+    return (int)ret;
+}
+#endif
+
 /*
  * Take a page list in a judy array and write them
  */
@@ -811,7 +836,17 @@ static struct extent_io_descriptor *datafile_extent_build(struct rrdengine_insta
             size_bytes = payload_offset + uncompressed_payload_length + sizeof(*trailer);
             break;
 
+#ifdef ENABLE_ZSTD
+        case RRD_ZSTD:
+            max_compressed_size = (int)ZSTD_compressBound(uncompressed_payload_length);
+            eb = extent_buffer_get(max_compressed_size);
+            compressed_buf = eb->data;
+            size_bytes = payload_offset + MAX(uncompressed_payload_length, (unsigned)max_compressed_size) + sizeof(*trailer);
+            break;
+#endif
+
         default: /* Compress */
+            compression_algorithm = RRD_LZ4;
             fatal_assert(uncompressed_payload_length < LZ4_MAX_INPUT_SIZE);
             max_compressed_size = LZ4_compressBound(uncompressed_payload_length);
             eb = extent_buffer_get(max_compressed_size);
@@ -848,6 +883,7 @@ static struct extent_io_descriptor *datafile_extent_build(struct rrdengine_insta
                 header->descr[i].end_time_ut = descr->end_time_ut;
                 break;
             case PAGE_GORILLA_METRICS:
+            case PAGE_GORILLA_TIER:
                 header->descr[i].gorilla.delta_time_s = (uint32_t) ((descr->end_time_ut - descr->start_time_ut) / USEC_PER_SEC);
                 header->descr[i].gorilla.entries = pgd_slots_used(descr->pgd);
                 break;
@@ -869,7 +905,23 @@ static struct extent_io_descriptor *datafile_extent_build(struct rrdengine_insta
                 compressed_buf,
                 (int)uncompressed_payload_length,
                 max_compressed_size);
+    }
+#ifdef ENABLE_ZSTD
+    else if(compression_algorithm == RRD_ZSTD) {
+        compressed_size = datafile_extent_compress_zstd(
+                ctx, xt_io_descr->buf + payload_offset, uncompressed_payload_length,
+                compressed_buf, max_compressed_size);
+
+        if(unlikely(compressed_size <= 0)) {
+            // store this extent uncompressed
+            extent_buffer_release(eb);
+            compression_algorithm = RRD_NO_COMPRESSION;
+            header->compression_algorithm = compression_algorithm;
+        }
+    }
+#endif
 
+    if(likely(compression_algorithm != RRD_NO_COMPRESSION)) {
         __atomic_add_fetch(&ctx->stats.before_compress_bytes, uncompressed_payload_length, __ATOMIC_RELAXED);
         __atomic_add_fetch(&ctx->stats.after_compress_bytes, compressed_size, __ATOMIC_RELAXED);
 
@@ -879,6 +931,7 @@ static struct extent_io_descriptor *datafile_extent_build(struct rrdengine_insta
         header->payload_length = compressed_size;
     }
     else { // RRD_NO_COMPRESSION
+        size_bytes = payload_offset + uncompressed_payload_length + sizeof(*trailer);
         header->payload_length = uncompressed_payload_length;
     }
 
@@ -1439,6 +1492,10 @@ void pdc_route_asynchronously(struct rrdengine_instance *ctx, struct page_detail
     pdc_to_epdl_router(ctx, pdc, epdl_populate_pages_asynchronously, epdl_populate_pages_asynchronously);
 }
 
+void pdc_route_group_asynchronously(struct rrdengine_instance *ctx, struct page_details_control **pdcs, size_t count) {
+    pdc_group_to_epdl_router(ctx, pdcs, count, epdl_populate_pages_asynchronously, epdl_populate_pages_asynchronously);
+}
+
 void epdl_populate_pages_synchronously(struct rrdengine_instance *ctx, EPDL *epdl, enum storage_priority priority __maybe_unused) {
     epdl_find_extent_and_populate_pages(ctx, epdl, false);
 }
@@ -1538,6 +1595,7 @@ struct rrdeng_buffer_sizes rrdeng_get_buffer_sizes(void) {
             .epdl        = epdl_cache_size(),
             .deol        = deol_cache_size(),
             .pd          = pd_cache_size(),
+            .journal_filters = journalfile_v2_filters_size(),
 
 #ifdef PDC_USE_JULYL
             .julyl       = julyl_cache_size(),
@@ -12,6 +12,9 @@
 #include <openssl/sha.h>
 #include <openssl/evp.h>
 #include "daemon/common.h"
+#ifdef ENABLE_ZSTD
+#include <zstd.h>
+#endif
 #include "../rrd.h"
 #include "rrddiskprotocol.h"
 #include "rrdenginelib.h"
@@ -99,6 +102,8 @@ typedef struct page_details_control {
     STORAGE_PRIORITY priority;
 
     time_t optimal_end_time_s;
+
+    struct page_details_control *group_next;    // the next query of the same query group, until it is prepared
 } PDC;
 
 PDC *pdc_get(void);
@@ -356,6 +361,7 @@ struct rrdengine_instance {
 
         uint64_t max_disk_space;                    // the max disk space this ctx is allowed to use
         uint8_t global_compress_alg;                // the wanted compression algorithm
+        int compression_level;                      // the level of the compression algorithm (0 = default)
 
         char dbfiles_path[FILENAME_MAX + 1];
     } config;
@@ -398,6 +404,7 @@ struct rrdengine_instance {
         struct {
             size_t size;
             struct completion *array;
+            usec_t started_ut;
         } populate_mrg;
 
         bool create_new_datafile_pair;
@@ -470,6 +477,7 @@ void rrdeng_enq_cmd(struct rrdengine_instance *ctx, enum rrdeng_opcode opcode, v
 
 void pdc_route_asynchronously(struct rrdengine_instance *ctx, struct page_details_control *pdc);
 void pdc_route_synchronously(struct rrdengine_instance *ctx, struct page_details_control *pdc);
+void pdc_route_group_asynchronously(struct rrdengine_instance *ctx, struct page_details_control **pdcs, size_t count);
 
 void pdc_acquire(PDC *pdc);
 bool pdc_release_and_destroy_if_unreferenced(PDC *pdc, bool worker, bool router);
@@ -17,6 +17,8 @@ struct rrdengine_instance multidb_ctx_storage_tier4;
 #endif
 struct rrdengine_instance *multidb_ctx[RRD_STORAGE_TIERS];
 uint8_t tier_page_type[RRD_STORAGE_TIERS] = {PAGE_METRICS, PAGE_TIER, PAGE_TIER, PAGE_TIER, PAGE_TIER};
+uint8_t tier_compression_algorithm[RRD_STORAGE_TIERS] = {RRD_LZ4, RRD_LZ4, RRD_LZ4, RRD_LZ4, RRD_LZ4};
+int tier_compression_level[RRD_STORAGE_TIERS] = {0, 0, 0, 0, 0};
 
 #if defined(ENV32BIT)
 size_t tier_page_size[RRD_STORAGE_TIERS] = {2048, 1024, 192, 192, 192};
@@ -24,14 +26,15 @@ size_t tier_page_size[RRD_STORAGE_TIERS] = {2048, 1024, 192, 192, 192};
 size_t tier_page_size[RRD_STORAGE_TIERS] = {4096, 2048, 384, 384, 384};
 #endif
 
-#if PAGE_TYPE_MAX != 2
-#error PAGE_TYPE_MAX is not 2 - you need to add allocations here
+#if PAGE_TYPE_MAX != 3
+#error PAGE_TYPE_MAX is not 3 - you need to add allocations here
 #endif
 
 size_t page_type_size[256] = {
         [PAGE_METRICS] = sizeof(storage_number),
         [PAGE_TIER] = sizeof(storage_number_tier1_t),
-        [PAGE_GORILLA_METRICS] = sizeof(storage_number)
+        [PAGE_GORILLA_METRICS] = sizeof(storage_number),
+        [PAGE_GORILLA_TIER] = sizeof(storage_number_tier1_t)
 };
 
 __attribute__((constructor)) void initialize_multidb_ctx(void) {
@@ -43,6 +46,15 @@ __attribute__((constructor)) void initialize_multidb_ctx(void) {
 }
 
 int db_engine_journal_check = 0;
+int db_engine_use_io_uring = 0;
+int db_engine_scan_resistant_eviction = 0;
+int db_engine_compact_clean_pages = 0;
+size_t db_engine_extent_coalescing_max_gap = 32 * 1024;
+size_t db_engine_extent_coalescing_max_size = 0;
+size_t db_engine_read_ahead_size = 0;
+size_t db_engine_warm_start_pages = 65536;
+size_t db_engine_journal_indexing_max_memory = 0;
+size_t db_engine_journal_indexing_write_rate = 0;
 int default_rrdeng_disk_quota_mb = 256;
 int default_multidb_disk_quota_mb = 256;
 
@@ -446,6 +458,7 @@ static PGD *rrdeng_alloc_new_page_data(struct rrdeng_collect_handle *handle, siz
     switch (ctx->config.page_type) {
         case PAGE_METRICS:
         case PAGE_TIER:
+        case PAGE_GORILLA_TIER:
             d = pgd_create(ctx->config.page_type, slots);
             break;
         case PAGE_GORILLA_METRICS:
@@ -1036,6 +1049,8 @@ void rrdeng_get_37_statistics(struct rrdengine_instance *ctx, unsigned long long
 }
 
 static void rrdeng_populate_mrg(struct rrdengine_instance *ctx) {
+    ctx->loading.populate_mrg.started_ut = now_monotonic_usec();
+
     uv_rwlock_rdlock(&ctx->datafiles.rwlock);
     size_t datafiles = 0;
     for(struct rrdengine_datafile *df = ctx->datafiles.first; df ;df = df->next)
@@ -1096,7 +1111,15 @@ void rrdeng_readiness_wait(struct rrdengine_instance *ctx) {
     ctx->loading.populate_mrg.array = NULL;
     ctx->loading.populate_mrg.size = 0;
 
+    if(ctx->loading.populate_mrg.started_ut) {
+        netdata_log_info("DBENGINE: tier %d populated retention to MRG in %0.2f ms",
+                         ctx->config.tier, (double)(now_monotonic_usec() - ctx->loading.populate_mrg.started_ut) / USEC_PER_MS);
+        ctx->loading.populate_mrg.started_ut = 0;
+    }
+
     netdata_log_info("DBENGINE: tier %d is ready for data collection and queries", ctx->config.tier);
+
+    pg_cache_warm_start_load(ctx);
 }
 
 bool rrdeng_is_legacy(STORAGE_INSTANCE *db_instance) {
@@ -1142,7 +1165,8 @@ int rrdeng_init(struct rrdengine_instance **ctxp, const char *dbfiles_path,
 
     ctx->config.tier = (int)tier;
     ctx->config.page_type = tier_page_type[tier];
-    ctx->config.global_compress_alg = RRD_LZ4;
+    ctx->config.global_compress_alg = tier_compression_algorithm[tier];
+    ctx->config.compression_level = tier_compression_level[tier];
     if (disk_space_mb < RRDENG_MIN_DISK_SPACE_MB)
         disk_space_mb = RRDENG_MIN_DISK_SPACE_MB;
     ctx->config.max_disk_space = disk_space_mb * 1048576LLU;
@@ -1202,6 +1226,8 @@ int rrdeng_exit(struct rrdengine_instance *ctx) {
     netdata_log_info("DBENGINE: flushing main cache for tier %d", (ctx->config.legacy) ? -1 : ctx->config.tier);
     pgc_flush_all_hot_and_dirty_pages(main_cache, (Word_t)ctx);
 
+    pg_cache_warm_start_save(ctx);
+
     netdata_log_info("DBENGINE: shutting down tier %d", (ctx->config.legacy) ? -1 : ctx->config.tier);
     struct completion completion = {};
     completion_init(&completion);
@@ -15,12 +15,23 @@
 extern int default_rrdeng_page_cache_mb;
 extern int default_rrdeng_extent_cache_mb;
 extern int db_engine_journal_check;
+extern int db_engine_use_io_uring;
+extern int db_engine_scan_resistant_eviction;
+extern int db_engine_compact_clean_pages;
+extern size_t db_engine_extent_coalescing_max_gap;
+extern size_t db_engine_extent_coalescing_max_size;
+extern size_t db_engine_read_ahead_size;
+extern size_t db_engine_warm_start_pages;
+extern size_t db_engine_journal_indexing_max_memory;
+extern size_t db_engine_journal_indexing_write_rate;
 extern int default_rrdeng_disk_quota_mb;
 extern int default_multidb_disk_quota_mb;
 extern struct rrdengine_instance *multidb_ctx[RRD_STORAGE_TIERS];
 extern size_t page_type_size[];
 extern size_t tier_page_size[];
 extern uint8_t tier_page_type[];
+extern uint8_t tier_compression_algorithm[];
+extern int tier_compression_level[];
 
 #define CTX_POINT_SIZE_BYTES(ctx) page_type_size[(ctx)->config.page_type]
 
@@ -52,6 +63,8 @@ void rrdeng_load_metric_finalize(struct storage_engine_query_handle *rrddim_hand
 time_t rrdeng_metric_latest_time(STORAGE_METRIC_HANDLE *db_metric_handle);
 time_t rrdeng_metric_oldest_time(STORAGE_METRIC_HANDLE *db_metric_handle);
 time_t rrdeng_load_align_to_optimal_before(struct storage_engine_query_handle *rrddim_handle);
+void rrdeng_query_group_begin(void);
+void rrdeng_query_group_end(void);
 
 void rrdeng_get_37_statistics(struct rrdengine_instance *ctx, unsigned long long *array);
 
@@ -131,6 +144,8 @@ struct rrdeng_cache_efficiency_stats {
     size_t pages_total;
     size_t pages_to_load_from_disk;
     size_t extents_loaded_from_disk;
+    size_t extents_coalesced;                           // read together with neighbouring extents
+    size_t extents_read_ahead;                          // added to the extent cache by read-ahead
 
     // pages metadata sources
     size_t pages_meta_source_main_cache;
@@ -190,11 +205,18 @@ struct rrdeng_cache_efficiency_stats {
     // database events
     size_t journal_v2_mapped;
     size_t journal_v2_unmapped;
+    size_t journal_v2_skipped_by_filter;                // journals skipped by queries, because their filter excluded the metric
     size_t datafile_creation_started;
     size_t datafile_deletion_started;
     size_t datafile_deletion_spin;
     size_t journal_v2_indexing_started;
     size_t metrics_retention_started;
+
+    // journal v2 indexing
+    size_t journal_v2_indexing_pages;                   // pages indexed
+    size_t journal_v2_indexing_bytes;                   // bytes of journal v2 files written
+    size_t journal_v2_indexing_throttled_ut;            // time indexers slept, to respect the write rate
+    size_t journal_v2_indexing_memory_wait_ut;          // time indexers waited for the memory budget
 };
 
 struct rrdeng_buffer_sizes {
@@ -211,6 +233,7 @@ struct rrdeng_buffer_sizes {
     size_t pd;
     size_t pgc;
     size_t mrg;
+    size_t journal_filters;
 #ifdef PDC_USE_JULYL
     size_t julyl;
 #endif
@@ -116,6 +116,7 @@ struct ml_metrics_statistics {
 #include "rrdcalc.h"
 #include "rrdcalctemplate.h"
 #include "rrdlabels.h"
+#include "streaming/binary.h"
 #include "streaming/rrdpush.h"
 #include "aclk/aclk_rrdhost_state.h"
 #include "sqlite/sqlite_health.h"
@@ -342,7 +343,12 @@ struct rrddim {
         struct {
             uint32_t sent_version;
             uint32_t dim_slot;
+            STREAM_BINARY_DELTA delta;              // the last values sent, with STREAM_CAP_BINARY_DELTA
         } sender;
+
+        struct {
+            STREAM_BINARY_DELTA delta;              // the last values received, with STREAM_CAP_BINARY_DELTA
+        } receiver;
     } rrdpush;
 
     // ------------------------------------------------------------------------
@@ -649,6 +655,23 @@ static inline time_t storage_engine_align_to_optimal_before(struct storage_engin
     return rrddim_query_align_to_optimal_before(handle);
 }
 
+// the queries a thread initializes between these two calls are prepared together, so that the
+// metrics that are stored in the same extents (e.g. the dimensions of a chart) load each extent once
+// the queries should not be consumed before the group ends
+void rrdeng_query_group_begin(void);
+void rrdeng_query_group_end(void);
+static inline void storage_engine_query_group_begin(void) {
+#ifdef ENABLE_DBENGINE
+    rrdeng_query_group_begin();
+#endif
+}
+
+static inline void storage_engine_query_group_end(void) {
+#ifdef ENABLE_DBENGINE
+    rrdeng_query_group_end();
+#endif
+}
+
 // ------------------------------------------------------------------------
 // function pointers for all APIs provided by a storage engine
 typedef struct storage_engine_api {
@@ -820,6 +843,9 @@ struct rrdset {
             uint32_t dim_last_slot_used;
 
             time_t resync_time_s;                   // the timestamp up to which we should resync clock upstream
+
+            uint32_t delta_generation;              // the delta bases of the dimensions are valid for this generation
+            bool delta_in_flight;                   // an update of the chart is being streamed
         } sender;
     } rrdpush;
 
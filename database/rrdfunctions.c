@@ -351,6 +351,22 @@ void rrd_collector_finished(void) {
     thread_rrd_collector = NULL;
 }
 
+// threads serving many collectors (like the streaming receivers pool),
+// keep the collector of each one aside, and attach it while serving it
+
+struct rrd_collector *rrd_collector_detach(void) {
+    struct rrd_collector *rdc = thread_rrd_collector;
+    thread_rrd_collector = NULL;
+    return rdc;
+}
+
+void rrd_collector_attach(struct rrd_collector *rdc) {
+    internal_fatal(thread_rrd_collector && thread_rrd_collector != rdc,
+                   "FUNCTIONS: attaching a collector to a thread that already has another one");
+
+    thread_rrd_collector = rdc;
+}
+
 #define rrd_collector_running(c) __atomic_load_n(&(c)->running, __ATOMIC_RELAXED)
 
 static struct rrd_collector *rrd_collector_acquire(void) {
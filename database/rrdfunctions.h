@@ -24,6 +24,10 @@ void rrdfunctions_host_destroy(RRDHOST *host);
 void rrd_collector_started(void);
 void rrd_collector_finished(void);
 
+// for threads serving many collectors, one at a time
+struct rrd_collector *rrd_collector_detach(void);
+void rrd_collector_attach(struct rrd_collector *rdc);
+
 // add a function, to be run from the collector
 void rrd_function_add(RRDHOST *host, RRDSET *st, const char *name, int timeout, const char *help,
                       bool sync, rrd_function_execute_cb_t execute_cb, void *execute_cb_data);
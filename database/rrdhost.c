@@ -865,6 +865,41 @@ void *dbengine_tier_init(void *ptr) {
     dbi->ret = rrdeng_init(NULL, dbi->path, dbi->disk_space_mb, dbi->tier);
     return ptr;
 }
+
+static void dbengine_tier_compression_config(const char *hostname, size_t tier) {
+    char key[200 + 1];
+
+    if(tier == 0)
+        snprintfz(key, sizeof(key) - 1, "dbengine compression");
+    else
+        snprintfz(key, sizeof(key) - 1, "dbengine tier %zu compression", tier);
+
+    const char *algorithm = config_get(CONFIG_SECTION_DB, key, "lz4");
+    if(strcmp(algorithm, "lz4") == 0)
+        tier_compression_algorithm[tier] = RRD_LZ4;
+    else if(strcmp(algorithm, "none") == 0)
+        tier_compression_algorithm[tier] = RRD_NO_COMPRESSION;
+#ifdef ENABLE_ZSTD
+    else if(strcmp(algorithm, "zstd") == 0)
+        tier_compression_algorithm[tier] = RRD_ZSTD;
+#endif
+    else {
+        nd_log(NDLS_DAEMON, NDLP_WARNING,
+               "DBENGINE on '%s': unknown or unsupported compression '%s' for tier %zu, assuming 'lz4'",
+               hostname, algorithm, tier);
+
+        config_set(CONFIG_SECTION_DB, key, "lz4");
+        tier_compression_algorithm[tier] = RRD_LZ4;
+    }
+
+    if(tier == 0)
+        snprintfz(key, sizeof(key) - 1, "dbengine compression level");
+    else
+        snprintfz(key, sizeof(key) - 1, "dbengine tier %zu compression level", tier);
+
+    // zero means the default level of the algorithm (lz4 has only one)
+    tier_compression_level[tier] = (int)config_get_number(CONFIG_SECTION_DB, key, tier_compression_level[tier]);
+}
 #endif
 
 void dbengine_init(char *hostname) {
@@ -961,6 +996,8 @@ void dbengine_init(char *hostname) {
         storage_tiers_grouping_iterations[tier] = grouping_iterations;
         storage_tiers_backfill[tier] = backfill;
 
+        dbengine_tier_compression_config(hostname, tier);
+
         if(tier > 0 && get_tier_grouping(tier) > 65535) {
             storage_tiers_grouping_iterations[tier] = 1;
             nd_log(NDLS_DAEMON, NDLP_WARNING,
@@ -357,6 +357,113 @@ bool gorilla_reader_read(gorilla_reader_t *gr, uint32_t *number)
     return true;
 }
 
+// Within a buffer, a run of repeated numbers is a run of `1` bits, so
+// up to a word's worth of them can be consumed at once. Returns the number
+// of repeated numbers (at most max) that follow the reader's position.
+static inline uint32_t gorilla_reader_repeated_run(const gorilla_reader_t *gr, uint32_t max)
+{
+    // the first number of a buffer is always stored verbatim
+    if (gr->index == 0 || gr->index >= gr->entries)
+        return 0;
+
+    const size_t offset = gr->position % bit_size<uint32_t>();
+    const uint32_t word = gr->buffer->data[gr->position / bit_size<uint32_t>()] >> offset;
+
+    size_t run = (~word) ? __builtin_ctz(~word) : bit_size<uint32_t>();
+    if (run > bit_size<uint32_t>() - offset)
+        run = bit_size<uint32_t>() - offset;
+    if (run > gr->capacity - gr->position)
+        run = gr->capacity - gr->position;
+    if (run > gr->entries - gr->index)
+        run = gr->entries - gr->index;
+    if (run > max)
+        run = max;
+
+    return run;
+}
+
+uint32_t gorilla_reader_read_batch(gorilla_reader_t *gr, uint32_t *numbers, uint32_t n)
+{
+    uint32_t decoded = 0;
+
+    while (decoded != n) {
+        uint32_t run = gorilla_reader_repeated_run(gr, n - decoded);
+        if (run) {
+            for (uint32_t i = 0; i != run; i++)
+                numbers[decoded + i] = gr->prev_number;
+
+            gr->index += run;
+            gr->position += run;
+            decoded += run;
+            continue;
+        }
+
+        if (!gorilla_reader_read(gr, &numbers[decoded]))
+            break;
+
+        decoded++;
+    }
+
+    return decoded;
+}
+
+uint32_t gorilla_reader_skip(gorilla_reader_t *gr, uint32_t n)
+{
+    uint32_t skipped = 0;
+
+    while (skipped != n) {
+        if (gr->index == gr->entries) {
+            // same as in gorilla_reader_read(), the writer might have added
+            // more entries to the buffer, or moved on to a new buffer.
+            gr->entries = __atomic_load_n(&gr->buffer->header.entries, __ATOMIC_SEQ_CST);
+            gr->capacity = __atomic_load_n(&gr->buffer->header.nbits, __ATOMIC_SEQ_CST);
+
+            if (gr->index == gr->entries) {
+                gorilla_buffer_t *next_buffer = __atomic_load_n(&gr->buffer->header.next, __ATOMIC_SEQ_CST);
+                if (!next_buffer)
+                    break;
+
+                *gr = gorilla_reader_init(next_buffer);
+                continue;
+            }
+        }
+
+        uint32_t wanted = n - skipped;
+
+        // Every buffer starts with a verbatim number and a reset xor/lzc state,
+        // ie. each buffer is a checkpoint we can jump to without decoding any of
+        // the values that precede it. Once a buffer has a successor the writer
+        // will not touch it again, so its number of entries is final.
+        gorilla_buffer_t *next_buffer = __atomic_load_n(&gr->buffer->header.next, __ATOMIC_SEQ_CST);
+        if (next_buffer) {
+            gr->entries = __atomic_load_n(&gr->buffer->header.entries, __ATOMIC_SEQ_CST);
+
+            uint32_t remaining = gr->entries - gr->index;
+            if (remaining <= wanted) {
+                skipped += remaining;
+                *gr = gorilla_reader_init(next_buffer);
+                continue;
+            }
+        }
+
+        uint32_t run = gorilla_reader_repeated_run(gr, wanted);
+        if (run) {
+            gr->index += run;
+            gr->position += run;
+            skipped += run;
+            continue;
+        }
+
+        uint32_t number;
+        if (!gorilla_reader_read(gr, &number))
+            break;
+
+        skipped++;
+    }
+
+    return skipped;
+}
+
 /*
  * Internal code used for fuzzing the library
 */
@@ -444,6 +551,44 @@ extern "C" int LLVMFuzzerTestOneInput(const uint8_t *Data, size_t Size) {
                 && "Read wrong number from gorilla buffer");
     }
 
+    /*
+     * read data in batches
+    */
+    {
+        gorilla_reader_t gr = gorilla_writer_get_reader(&gw);
+        std::vector<uint32_t> Batch(RandomData.size());
+
+        size_t decoded = 0;
+        while (decoded != RandomData.size()) {
+            uint32_t n = 1 + (RandomData[decoded] % 64);
+            if (n > RandomData.size() - decoded)
+                n = RandomData.size() - decoded;
+
+            uint32_t got = gorilla_reader_read_batch(&gr, &Batch[decoded], n);
+            assert((got == n) && "Failed to read batch of numbers from gorilla buffer");
+            decoded += got;
+        }
+
+        assert((Batch == RandomData) && "Read wrong batch of numbers from gorilla buffer");
+    }
+
+    /*
+     * skip data
+    */
+    for (size_t i = 0; i < RandomData.size(); i += 1 + (RandomData[i] % 7)) {
+        gorilla_reader_t gr = gorilla_writer_get_reader(&gw);
+
+        uint32_t skipped = gorilla_reader_skip(&gr, i);
+        assert((skipped == i) && "Failed to skip numbers in gorilla buffer");
+
+        uint32_t number = 0;
+        bool ok = gorilla_reader_read(&gr, &number);
+        assert(ok && "Failed to read number from gorilla buffer after skipping");
+
+        assert((number == RandomData[i])
+                && "Read wrong number from gorilla buffer after skipping");
+    }
+
     S.free_buffers();
     return 0;
 }
@@ -519,4 +664,85 @@ static void BM_DecodeU32Numbers(benchmark::State& state) {
 }
 BENCHMARK(BM_DecodeU32Numbers)->ThreadRange(1, 16)->UseRealTime();
 
+static void BM_DecodeBatchU32Numbers(benchmark::State& state) {
+    std::random_device rd;
+    std::mt19937 mt(rd());
+    std::uniform_int_distribution<uint32_t> dist(0x0, 0xFFFFFFFF);
+
+    std::vector<uint32_t> RandomData;
+    for (size_t idx = 0; idx != NumItems; idx++) {
+        RandomData.push_back(dist(mt));
+    }
+    std::vector<uint32_t> EncodedData(10 * RandomData.capacity(), 0);
+    std::vector<uint32_t> DecodedData(RandomData.size(), 0);
+
+    gorilla_writer_t gw = gorilla_writer_init(
+        reinterpret_cast<gorilla_buffer_t *>(EncodedData.data()),
+        EncodedData.size());
+
+    for (size_t i = 0; i != RandomData.size(); i++)
+        gorilla_writer_write(&gw, RandomData[i]);
+
+    for (auto _ : state) {
+        gorilla_reader_t gr = gorilla_reader_init(reinterpret_cast<gorilla_buffer_t *>(EncodedData.data()));
+
+        benchmark::DoNotOptimize(gorilla_reader_read_batch(&gr, DecodedData.data(), DecodedData.size()));
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(NumItems * state.iterations());
+    state.SetBytesProcessed(NumItems * state.iterations() * sizeof(uint32_t));
+}
+BENCHMARK(BM_DecodeBatchU32Numbers)->ThreadRange(1, 16)->UseRealTime();
+
+// Seeking into a 1024-slot page made of 128-slot buffers (same as dbengine),
+// with a mix of repeated and changing values. The argument is the position
+// to seek to, so that the latency can be compared across the page.
+static void BM_SeekU32Numbers(benchmark::State& state) {
+    std::random_device rd;
+    std::mt19937 mt(rd());
+    std::uniform_int_distribution<uint32_t> dist(0x0, 0x0000FFFF);
+
+    std::vector<uint32_t> RandomData;
+    for (size_t idx = 0; idx != NumItems; idx++) {
+        if (idx && (dist(mt) % 4))
+            RandomData.push_back(RandomData.back());
+        else
+            RandomData.push_back(dist(mt));
+    }
+
+    std::vector<uint32_t> EncodedData(10 * RandomData.capacity(), 0);
+    size_t used = GORILLA_BUFFER_SLOTS;
+
+    gorilla_writer_t gw = gorilla_writer_init(
+        reinterpret_cast<gorilla_buffer_t *>(EncodedData.data()),
+        GORILLA_BUFFER_SLOTS);
+
+    for (size_t i = 0; i != RandomData.size(); i++) {
+        if (gorilla_writer_write(&gw, RandomData[i]))
+            continue;
+
+        gorilla_writer_add_buffer(&gw,
+            reinterpret_cast<gorilla_buffer_t *>(&EncodedData[used]),
+            GORILLA_BUFFER_SLOTS);
+        used += GORILLA_BUFFER_SLOTS;
+
+        gorilla_writer_write(&gw, RandomData[i]);
+    }
+
+    const uint32_t position = state.range(0);
+
+    for (auto _ : state) {
+        gorilla_reader_t gr = gorilla_writer_get_reader(&gw);
+        benchmark::DoNotOptimize(gorilla_reader_skip(&gr, position));
+
+        uint32_t number = 0;
+        benchmark::DoNotOptimize(gorilla_reader_read(&gr, &number));
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SeekU32Numbers)->RangeMultiplier(4)->Range(1, 1023);
+
 #endif /* ENABLE_BENCHMARK */
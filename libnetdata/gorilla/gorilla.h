@@ -66,6 +66,8 @@ bool gorilla_writer_serialize(const gorilla_writer_t *gw, uint8_t *dst, uint32_t
 uint32_t gorilla_buffer_patch(gorilla_buffer_t *buf);
 gorilla_reader_t gorilla_reader_init(gorilla_buffer_t *buf);
 bool gorilla_reader_read(gorilla_reader_t *gr, uint32_t *number);
+uint32_t gorilla_reader_read_batch(gorilla_reader_t *gr, uint32_t *numbers, uint32_t n);
+uint32_t gorilla_reader_skip(gorilla_reader_t *gr, uint32_t n);
 
 #define GORILLA_BUFFER_SLOTS 128
 #define GORILLA_BUFFER_SIZE (GORILLA_BUFFER_SLOTS * sizeof(uint32_t))
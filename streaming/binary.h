@@ -0,0 +1,341 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef NETDATA_STREAM_BINARY_H
+#define NETDATA_STREAM_BINARY_H 1
+
+#include "libnetdata/libnetdata.h"
+
+// ----------------------------------------------------------------------------
+// binary frames of BEGIN2 / SET2 / END2 - negotiated with STREAM_CAP_BINARY_DATA
+//
+// A frame is a single line: STREAM_BINARY_FRAME_MARKER, the records and a newline.
+// So that frames can travel along the text lines of the protocol, the bytes
+// '\n', '\0' and STREAM_BINARY_ESCAPE are sent as STREAM_BINARY_ESCAPE,
+// followed by the byte XOR STREAM_BINARY_ESCAPE_XOR.
+//
+// Records (numbers are LEB128 varints, signed numbers are zigzag encoded):
+//
+//  'B' chart-slot chart-id '\0' update-every end-time (wall-clock-time - end-time)
+//  'S' dimension-slot dimension-id '\0' collected-value (flags << 1 | has-value) [value]
+//  'D' dimension-slot dimension-id '\0' collected-value-delta (flags << 1 | has-value) [value-xor]
+//  'E'
+//
+// Slots are zero when the sender does not have STREAM_CAP_SLOTS.
+// The ids are used by the receiver only when a slot is not cached.
+// The value is 8 bytes of an IEEE754 double in little endian, sent only when
+// it is not equal to the collected value.
+// A chart update may span several frames and text lines (like chart variables)
+// may be interleaved between them, exactly like text BEGIN2 / SET2 / END2 lines.
+//
+// With STREAM_CAP_BINARY_DELTA, 'D' records are sent instead of 'S' records,
+// relative to the last values sent for the dimension (its delta base):
+// - the collected value as the difference from the previous one
+// - the value as the XOR of its IEEE754 bits with the bits of the previous one,
+//   sent as the number of its trailing zero bits (a byte) and the rest as a varint
+//   (a single byte of 64 when the value has not changed)
+// Slowly changing metrics become a few small repeating bytes, that compress well.
+// 'S' records are still sent when the sender does not have a base for the
+// dimension (e.g. after the chart definition is sent); they set the base of
+// both sides.
+
+#define STREAM_BINARY_FRAME_MARKER  0x02
+#define STREAM_BINARY_ESCAPE        0x10
+#define STREAM_BINARY_ESCAPE_XOR    0x40
+
+// new frames are started when the current one gets bigger than this
+#define STREAM_BINARY_FRAME_MAX_SIZE 4096
+
+#define STREAM_BINARY_RECORD_BEGIN  'B'
+#define STREAM_BINARY_RECORD_SET    'S'
+#define STREAM_BINARY_RECORD_DELTA  'D'
+#define STREAM_BINARY_RECORD_END    'E'
+
+// the worst case size of the numbers of a record, escaped
+#define STREAM_BINARY_RECORD_NUMBERS_MAX_SIZE (2 * (1 + 4 * 10 + 8))
+
+typedef struct stream_binary_frame {
+    bool open;
+    size_t start;                       // the position of the open frame in the buffer
+} STREAM_BINARY_FRAME;
+
+// the last values sent or received for a dimension, with STREAM_CAP_BINARY_DELTA
+typedef struct stream_binary_delta {
+    collected_number collected;
+    uint64_t value;                     // the IEEE754 bits of the value
+    uint32_t id;                        // the state of the stream this base is valid for (0 = none)
+} STREAM_BINARY_DELTA;
+
+static inline uint64_t stream_binary_double_bits(NETDATA_DOUBLE n) {
+    double d = (double)n;
+    uint64_t bits;
+    memcpy(&bits, &d, sizeof(bits));
+    return bits;
+}
+
+static inline NETDATA_DOUBLE stream_binary_bits_double(uint64_t bits) {
+    double d;
+    memcpy(&d, &bits, sizeof(d));
+    return (NETDATA_DOUBLE)d;
+}
+
+static inline void stream_binary_delta_set(STREAM_BINARY_DELTA *base, uint32_t id, collected_number collected_value, NETDATA_DOUBLE value) {
+    base->collected = collected_value;
+    base->value = stream_binary_double_bits(value);
+    base->id = id;
+}
+
+// ----------------------------------------------------------------------------
+// encoding - the callers ensure the buffer has enough space for each record
+
+static inline void stream_binary_put_byte(BUFFER *wb, uint8_t c) {
+    if(unlikely(c == '\n' || c == '\0' || c == STREAM_BINARY_ESCAPE)) {
+        wb->buffer[wb->len++] = (char)STREAM_BINARY_ESCAPE;
+        c ^= STREAM_BINARY_ESCAPE_XOR;
+    }
+
+    wb->buffer[wb->len++] = (char)c;
+}
+
+static inline void stream_binary_put_varint(BUFFER *wb, uint64_t v) {
+    while(v >= 0x80) {
+        stream_binary_put_byte(wb, (uint8_t)(v | 0x80));
+        v >>= 7;
+    }
+
+    stream_binary_put_byte(wb, (uint8_t)v);
+}
+
+static inline void stream_binary_put_zigzag(BUFFER *wb, int64_t v) {
+    stream_binary_put_varint(wb, ((uint64_t)v << 1) ^ (uint64_t)(v >> 63));
+}
+
+static inline void stream_binary_put_string(BUFFER *wb, const char *s, size_t len) {
+    for(size_t i = 0; i < len ;i++)
+        stream_binary_put_byte(wb, (uint8_t)s[i]);
+
+    stream_binary_put_byte(wb, '\0');
+}
+
+static inline void stream_binary_put_double(BUFFER *wb, NETDATA_DOUBLE n) {
+    uint64_t bits = stream_binary_double_bits(n);
+
+    for(size_t i = 0; i < sizeof(bits) ;i++)
+        stream_binary_put_byte(wb, (uint8_t)(bits >> (i * 8)));
+}
+
+static inline void stream_binary_put_xor(BUFFER *wb, uint64_t x) {
+    uint8_t trailing_zeros = x ? (uint8_t)__builtin_ctzll(x) : 64;
+    stream_binary_put_byte(wb, trailing_zeros);
+
+    if(trailing_zeros < 64)
+        stream_binary_put_varint(wb, x >> trailing_zeros);
+}
+
+static inline void stream_binary_frame_close(BUFFER *wb, STREAM_BINARY_FRAME *f) {
+    if(!f->open)
+        return;
+
+    buffer_need_bytes(wb, 2);
+    wb->buffer[wb->len++] = '\n';
+    wb->buffer[wb->len] = '\0';
+    f->open = false;
+}
+
+// makes sure a frame is open and there is space for a record with an id of id_len bytes
+static inline void stream_binary_frame_prepare(BUFFER *wb, STREAM_BINARY_FRAME *f, size_t id_len) {
+    if(f->open && wb->len - f->start > STREAM_BINARY_FRAME_MAX_SIZE)
+        stream_binary_frame_close(wb, f);
+
+    buffer_need_bytes(wb, 2 * (id_len + 1) + STREAM_BINARY_RECORD_NUMBERS_MAX_SIZE + 2);
+
+    if(!f->open) {
+        f->start = wb->len;
+        wb->buffer[wb->len++] = (char)STREAM_BINARY_FRAME_MARKER;
+        f->open = true;
+    }
+}
+
+static inline void stream_binary_begin(BUFFER *wb, STREAM_BINARY_FRAME *f, uint64_t slot, const char *id, size_t id_len,
+                                       time_t update_every, time_t end_time, time_t wall_clock_time) {
+    stream_binary_frame_prepare(wb, f, id_len);
+    stream_binary_put_byte(wb, STREAM_BINARY_RECORD_BEGIN);
+    stream_binary_put_varint(wb, slot);
+    stream_binary_put_string(wb, id, id_len);
+    stream_binary_put_varint(wb, (uint64_t)update_every);
+    stream_binary_put_varint(wb, (uint64_t)end_time);
+    stream_binary_put_zigzag(wb, (int64_t)(wall_clock_time - end_time));
+}
+
+static inline void stream_binary_set(BUFFER *wb, STREAM_BINARY_FRAME *f, uint64_t slot, const char *id, size_t id_len,
+                                     collected_number collected_value, NETDATA_DOUBLE value, SN_FLAGS flags) {
+    bool has_value = ((NETDATA_DOUBLE)collected_value != value);
+
+    stream_binary_frame_prepare(wb, f, id_len);
+    stream_binary_put_byte(wb, STREAM_BINARY_RECORD_SET);
+    stream_binary_put_varint(wb, slot);
+    stream_binary_put_string(wb, id, id_len);
+    stream_binary_put_zigzag(wb, (int64_t)collected_value);
+    stream_binary_put_varint(wb, ((uint64_t)flags << 1) | (has_value ? 1 : 0));
+
+    if(has_value)
+        stream_binary_put_double(wb, value);
+}
+
+// the base must be valid - it is updated to the values sent
+static inline void stream_binary_set_delta(BUFFER *wb, STREAM_BINARY_FRAME *f, uint64_t slot, const char *id, size_t id_len,
+                                           collected_number collected_value, NETDATA_DOUBLE value, SN_FLAGS flags,
+                                           STREAM_BINARY_DELTA *base) {
+    bool has_value = ((NETDATA_DOUBLE)collected_value != value);
+    uint64_t value_bits = stream_binary_double_bits(value);
+
+    stream_binary_frame_prepare(wb, f, id_len);
+    stream_binary_put_byte(wb, STREAM_BINARY_RECORD_DELTA);
+    stream_binary_put_varint(wb, slot);
+    stream_binary_put_string(wb, id, id_len);
+    stream_binary_put_zigzag(wb, (int64_t)((uint64_t)collected_value - (uint64_t)base->collected));
+    stream_binary_put_varint(wb, ((uint64_t)flags << 1) | (has_value ? 1 : 0));
+
+    if(has_value)
+        stream_binary_put_xor(wb, value_bits ^ base->value);
+
+    base->collected = collected_value;
+    base->value = value_bits;
+}
+
+// a 'D' record when the base is valid for this generation of the stream,
+// otherwise an 'S' record that resets the base of both sides
+static inline void stream_binary_set_with_base(BUFFER *wb, STREAM_BINARY_FRAME *f, uint64_t slot, const char *id, size_t id_len,
+                                               collected_number collected_value, NETDATA_DOUBLE value, SN_FLAGS flags,
+                                               STREAM_BINARY_DELTA *base, uint32_t generation) {
+    if(likely(base->id == generation)) {
+        stream_binary_set_delta(wb, f, slot, id, id_len, collected_value, value, flags, base);
+        return;
+    }
+
+    stream_binary_delta_set(base, generation, collected_value, value);
+    stream_binary_set(wb, f, slot, id, id_len, collected_value, value, flags);
+}
+
+static inline void stream_binary_end(BUFFER *wb, STREAM_BINARY_FRAME *f) {
+    stream_binary_frame_prepare(wb, f, 0);
+    stream_binary_put_byte(wb, STREAM_BINARY_RECORD_END);
+    stream_binary_frame_close(wb, f);
+}
+
+// ----------------------------------------------------------------------------
+// decoding
+
+typedef struct stream_binary_reader {
+    const uint8_t *pos;
+    const uint8_t *end;
+    bool error;
+} STREAM_BINARY_READER;
+
+// unescapes in place the records of a frame (the line after the marker)
+// returns their size in bytes, or -1 when the frame is corrupted
+static inline ssize_t stream_binary_frame_unescape(char *records) {
+    char *s = records, *d = records;
+
+    while(*s && *s != '\n') {
+        if(unlikely(*s == (char)STREAM_BINARY_ESCAPE)) {
+            s++;
+            if(unlikely(!*s || *s == '\n'))
+                return -1;
+
+            *d++ = (char)(*s++ ^ STREAM_BINARY_ESCAPE_XOR);
+        }
+        else
+            *d++ = *s++;
+    }
+
+    return d - records;
+}
+
+static inline uint8_t stream_binary_get_byte(STREAM_BINARY_READER *r) {
+    if(unlikely(r->pos >= r->end)) {
+        r->error = true;
+        return 0;
+    }
+
+    return *r->pos++;
+}
+
+static inline uint64_t stream_binary_get_varint(STREAM_BINARY_READER *r) {
+    uint64_t v = 0;
+
+    for(size_t shift = 0; shift < 64 ;shift += 7) {
+        uint8_t c = stream_binary_get_byte(r);
+        v |= (uint64_t)(c & 0x7f) << shift;
+
+        if(!(c & 0x80))
+            return v;
+    }
+
+    r->error = true;
+    return 0;
+}
+
+static inline int64_t stream_binary_get_zigzag(STREAM_BINARY_READER *r) {
+    uint64_t v = stream_binary_get_varint(r);
+    return (int64_t)(v >> 1) ^ -(int64_t)(v & 1);
+}
+
+// returns a pointer to the string, inside the frame
+static inline const char *stream_binary_get_string(STREAM_BINARY_READER *r) {
+    const uint8_t *z = (r->pos < r->end) ? (const uint8_t *)memchr(r->pos, '\0', r->end - r->pos) : NULL;
+    if(unlikely(!z)) {
+        r->error = true;
+        return NULL;
+    }
+
+    const char *s = (const char *)r->pos;
+    r->pos = z + 1;
+    return s;
+}
+
+static inline NETDATA_DOUBLE stream_binary_get_double(STREAM_BINARY_READER *r) {
+    if(unlikely(r->end - r->pos < (ssize_t)sizeof(uint64_t))) {
+        r->error = true;
+        return NAN;
+    }
+
+    uint64_t bits = 0;
+    for(size_t i = 0; i < sizeof(bits) ;i++)
+        bits |= (uint64_t)r->pos[i] << (i * 8);
+
+    r->pos += sizeof(bits);
+
+    return stream_binary_bits_double(bits);
+}
+
+static inline uint64_t stream_binary_get_xor(STREAM_BINARY_READER *r) {
+    uint8_t trailing_zeros = stream_binary_get_byte(r);
+    if(trailing_zeros == 64)
+        return 0;
+
+    if(unlikely(trailing_zeros > 64)) {
+        r->error = true;
+        return 0;
+    }
+
+    return stream_binary_get_varint(r) << trailing_zeros;
+}
+
+// applies a 'D' record to the base of the dimension, to get the values sent
+// returns false when the base is not valid for this state of the stream
+static inline bool stream_binary_delta_apply(STREAM_BINARY_DELTA *base, uint32_t id,
+                                             uint64_t collected_delta, uint64_t flags_and_value, uint64_t value_xor) {
+    if(unlikely(base->id != id))
+        return false;
+
+    base->collected = (collected_number)((uint64_t)base->collected + collected_delta);
+
+    if(flags_and_value & 1)
+        base->value ^= value_xor;
+    else
+        base->value = stream_binary_double_bits((NETDATA_DOUBLE)base->collected);
+
+    return true;
+}
+
+#endif //NETDATA_STREAM_BINARY_H
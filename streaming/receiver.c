@@ -281,9 +281,7 @@ static inline bool receiver_should_stop(struct receiver_state *rpt) {
     return false;
 }
 
-static size_t streaming_parser(struct receiver_state *rpt, struct plugind *cd, int fd, void *ssl) {
-    size_t result = 0;
-
+static PARSER *receiver_parser_create(struct receiver_state *rpt, struct plugind *cd, int fd, void *ssl) {
     PARSER *parser = NULL;
     {
         PARSER_USER_OBJECT user = {
@@ -304,6 +302,25 @@ static size_t streaming_parser(struct receiver_state *rpt, struct plugind *cd, i
 
     pluginsd_keywords_init(parser, PARSER_INIT_STREAMING);
 
+#ifdef NETDATA_LOG_STREAM_RECEIVE
+    {
+        char filename[FILENAME_MAX + 1];
+        snprintfz(filename, FILENAME_MAX, "/tmp/stream-receiver-%s.txt", rpt->host ? rrdhost_hostname(
+                        rpt->host) : "unknown"
+                 );
+        parser->user.stream_log_fp = fopen(filename, "w");
+        parser->user.stream_log_repertoire = PARSER_REP_METADATA;
+    }
+#endif
+
+    return parser;
+}
+
+static size_t streaming_parser(struct receiver_state *rpt, struct plugind *cd, int fd, void *ssl) {
+    size_t result = 0;
+
+    PARSER *parser = receiver_parser_create(rpt, cd, fd, ssl);
+
     rrd_collector_started();
 
     // this keeps the parser with its current value
@@ -312,17 +329,6 @@ static size_t streaming_parser(struct receiver_state *rpt, struct plugind *cd, i
         bool compressed_connection = rrdpush_decompression_initialize(rpt);
         buffered_reader_init(&rpt->reader);
 
-#ifdef NETDATA_LOG_STREAM_RECEIVE
-        {
-            char filename[FILENAME_MAX + 1];
-            snprintfz(filename, FILENAME_MAX, "/tmp/stream-receiver-%s.txt", rpt->host ? rrdhost_hostname(
-                            rpt->host) : "unknown"
-                     );
-            parser->user.stream_log_fp = fopen(filename, "w");
-            parser->user.stream_log_repertoire = PARSER_REP_METADATA;
-        }
-#endif
-
         CLEAN_BUFFER *buffer = buffer_create(sizeof(rpt->reader.read_buffer), NULL);
 
         ND_LOG_STACK lgs[] = {
@@ -480,7 +486,10 @@ bool stop_streaming_receiver(RRDHOST *host, STREAM_HANDSHAKE reason) {
             shutdown(host->receiver->fd, SHUT_RDWR);
         }
 
-        netdata_thread_cancel(host->receiver->thread);
+        // the receivers pool threads serve many children
+        // they notice the shutdown of the socket instead
+        if(!host->receiver->pool)
+            netdata_thread_cancel(host->receiver->thread);
     }
 
     int count = 2000;
@@ -546,7 +555,29 @@ void rrdpush_receive_log_status(struct receiver_state *rpt, const char *msg, con
                      );
 }
 
-static void rrdpush_receive(struct receiver_state *rpt)
+static void rrdpush_receive_disconnected(struct receiver_state *rpt, size_t count) {
+    receiver_set_exit_reason(rpt, STREAM_HANDSHAKE_DISCONNECT_PARSER_EXIT, false);
+
+    {
+        char msg[100 + 1];
+        snprintfz(msg, sizeof(msg) - 1, "disconnected (completed %zu updates)", count);
+        rrdpush_receive_log_status(
+                rpt, msg,
+                RRDPUSH_STATUS_DISCONNECTED, NDLP_WARNING);
+    }
+
+#ifdef ENABLE_ACLK
+    // in case we have cloud connection we inform cloud
+    // a child disconnected
+    if (netdata_cloud_enabled)
+        aclk_host_state_update(rpt->host, 0, 1);
+#endif
+}
+
+static bool receivers_pool_add(struct receiver_state *rpt, struct plugind *cd);
+
+// returns true when the connection has been handed over to the receivers pool
+static bool rrdpush_receive(struct receiver_state *rpt)
 {
     rpt->config.mode = default_rrd_memory_mode;
     rpt->config.history = default_rrd_history_entries;
@@ -818,6 +849,13 @@ static void rrdpush_receive(struct receiver_state *rpt)
     // let it reconnect to parent immediately
     rrdpush_reset_destinations_postpone_time(rpt->host);
 
+    if(rrdpush_receivers_pool_threads
+#ifdef ENABLE_H2O
+       && !is_h2o_rrdpush(rpt)
+#endif
+       && receivers_pool_add(rpt, &cd))
+        return true;
+
     size_t count = streaming_parser(rpt, &cd, rpt->fd,
 #ifdef ENABLE_HTTPS
                                     (rpt->ssl.conn) ? &rpt->ssl : NULL
@@ -826,25 +864,10 @@ static void rrdpush_receive(struct receiver_state *rpt)
 #endif
                                     );
 
-    receiver_set_exit_reason(rpt, STREAM_HANDSHAKE_DISCONNECT_PARSER_EXIT, false);
-
-    {
-        char msg[100 + 1];
-        snprintfz(msg, sizeof(msg) - 1, "disconnected (completed %zu updates)", count);
-        rrdpush_receive_log_status(
-                rpt, msg,
-                RRDPUSH_STATUS_DISCONNECTED, NDLP_WARNING);
-    }
-
-#ifdef ENABLE_ACLK
-    // in case we have cloud connection we inform cloud
-    // a child disconnected
-    if (netdata_cloud_enabled)
-        aclk_host_state_update(rpt->host, 0, 1);
-#endif
+    rrdpush_receive_disconnected(rpt, count);
 
 cleanup:
-    ;
+    return false;
 }
 
 static void rrdpush_receiver_thread_cleanup(void *ptr) {
@@ -886,23 +909,600 @@ static bool stream_receiver_log_transport(BUFFER *wb, void *ptr) {
     return true;
 }
 
-void *rrdpush_receiver_thread(void *ptr) {
-    netdata_thread_cleanup_push(rrdpush_receiver_thread_cleanup, ptr);
+static void receiver_worker_register(void) {
+    worker_register("STREAMRCV");
 
-            {
-                worker_register("STREAMRCV");
+    worker_register_job_custom_metric(WORKER_RECEIVER_JOB_BYTES_READ,
+                                      "received bytes", "bytes/s",
+                                      WORKER_METRIC_INCREMENT);
+
+    worker_register_job_custom_metric(WORKER_RECEIVER_JOB_BYTES_UNCOMPRESSED,
+                                      "uncompressed bytes", "bytes/s",
+                                      WORKER_METRIC_INCREMENT);
+
+    worker_register_job_custom_metric(WORKER_RECEIVER_JOB_REPLICATION_COMPLETION,
+                                      "replication completion", "%",
+                                      WORKER_METRIC_ABSOLUTE);
+}
 
-                worker_register_job_custom_metric(WORKER_RECEIVER_JOB_BYTES_READ,
-                                                  "received bytes", "bytes/s",
-                                                  WORKER_METRIC_INCREMENT);
+// ----------------------------------------------------------------------------
+// receivers pool
+//
+// By default, each child is served by its own receiver thread.
+// When 'receivers pool threads' is set, the children are served by this
+// number of threads instead, each one polling the sockets of its children.
+// The handshake of each child still runs on its own (short-lived) thread,
+// which then hands the connection over to the pool thread with the fewest
+// children. The pool threads use non-blocking sockets, parse all the complete
+// lines available from each child and move on to the next, so that a busy
+// child cannot keep its thread from serving the others.
+
+size_t rrdpush_receivers_pool_threads = 0;
+
+#define RECEIVERS_POOL_READS_PER_TURN 16
+#define RECEIVERS_POOL_IDLE_TIMEOUT_S 600
+
+// the data a child may leave unread, before it is disconnected
+#define RECEIVERS_POOL_MAX_PENDING_BYTES (4 * 1024 * 1024)
+
+struct receivers_pool_thread;
+
+struct receivers_pool_receiver {
+    struct receiver_state *rpt;
+    struct receivers_pool_thread *thread;
+
+    struct plugind cd;
+    PARSER *parser;
+    BUFFER *line;                       // the incomplete line, until the rest of it is received
+    struct rrd_collector *collector;    // the collector of the functions of this child
+    bool compressed;
+    time_t last_read_s;
+
+    struct {
+        size_t needed;                  // the size of the compressed block, zero while reading its signature
+        size_t used;
+        char data[COMPRESSION_MAX_MSG_SIZE];
+    } block;
+
+    struct receivers_pool_receiver *prev, *next;
+};
+
+struct receivers_pool_thread {
+    size_t id;
+    netdata_thread_t thread;
+    int pipe[2];                                // to wake up the thread when children are added
+
+    SPINLOCK spinlock;
+    struct receivers_pool_receiver *incoming;   // handed over, but not served yet - protected by spinlock
+
+    struct receivers_pool_receiver *receivers;  // served by this thread - touched only by this thread
+    size_t count;                               // atomic - all the children assigned to this thread
+};
+
+static struct {
+    SPINLOCK spinlock;
+    bool stopped;                               // netdata is exiting, no more children are accepted
+    size_t threads;
+    struct receivers_pool_thread *array;
+} receivers_pool = {
+        .spinlock = NETDATA_SPINLOCK_INITIALIZER,
+        .stopped = false,
+        .threads = 0,
+        .array = NULL,
+};
+
+// like read_stream(), for non-blocking sockets
+// returns the bytes read, zero when there is nothing to read now, or a negative read_stream() error
+static inline int read_stream_nonblocking(struct receiver_state *r, char* buffer, size_t size) {
+    ssize_t bytes_read;
 
-                worker_register_job_custom_metric(WORKER_RECEIVER_JOB_BYTES_UNCOMPRESSED,
-                                                  "uncompressed bytes", "bytes/s",
-                                                  WORKER_METRIC_INCREMENT);
+    do {
+        errno = 0;
 
-                worker_register_job_custom_metric(WORKER_RECEIVER_JOB_REPLICATION_COMPLETION,
-                                                  "replication completion", "%",
-                                                  WORKER_METRIC_ABSOLUTE);
+#ifdef ENABLE_HTTPS
+        if (SSL_connection(&r->ssl))
+            bytes_read = netdata_ssl_read(&r->ssl, buffer, size);
+        else
+            bytes_read = read(r->fd, buffer, size);
+#else
+        bytes_read = read(r->fd, buffer, size);
+#endif
+
+    } while(bytes_read < 0 && errno == EINTR);
+
+    if(bytes_read < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        return 0;
+
+    if (bytes_read == 0) {
+        netdata_log_error("STREAM: %s(): EOF while reading data from socket!", __FUNCTION__);
+        return -1;
+    }
+
+    if (bytes_read < 0) {
+        netdata_log_error("STREAM: %s() failed to read from socket!", __FUNCTION__);
+        return -2;
+    }
+
+    return (int)bytes_read;
+}
+
+// returns 1 on progress, 0 when there is nothing to read now, -1 on errors
+static int receivers_pool_read_uncompressed(struct receivers_pool_receiver *p, STREAM_HANDSHAKE *reason) {
+    struct receiver_state *r = p->rpt;
+
+    int bytes_read = read_stream_nonblocking(r, r->reader.read_buffer + r->reader.read_len, sizeof(r->reader.read_buffer) - r->reader.read_len - 1);
+    if(unlikely(bytes_read < 0)) {
+        *reason = read_stream_error_to_reason(bytes_read);
+        return -1;
+    }
+
+    if(!bytes_read)
+        return 0;
+
+    worker_set_metric(WORKER_RECEIVER_JOB_BYTES_READ, (NETDATA_DOUBLE)bytes_read);
+    worker_set_metric(WORKER_RECEIVER_JOB_BYTES_UNCOMPRESSED, (NETDATA_DOUBLE)bytes_read);
+
+    r->reader.read_len += bytes_read;
+    r->reader.read_buffer[r->reader.read_len] = '\0';
+
+    return 1;
+}
+
+// the compressed blocks are received in pieces, as they arrive
+// returns 1 on progress, 0 when there is nothing to read now, -1 on errors
+static int receivers_pool_read_compressed(struct receivers_pool_receiver *p, STREAM_HANDSHAKE *reason) {
+    struct receiver_state *r = p->rpt;
+
+    // first use any available uncompressed data
+    if (likely(rrdpush_decompressed_bytes_in_buffer(&r->decompressor))) {
+        size_t len = rrdpush_decompressor_get(&r->decompressor, r->reader.read_buffer + r->reader.read_len, sizeof(r->reader.read_buffer) - r->reader.read_len - 1);
+        if (unlikely(!len)) {
+            internal_error(true, "decompressor returned zero length #1");
+            return -1;
+        }
+
+        r->reader.read_len += (int)len;
+        r->reader.read_buffer[r->reader.read_len] = '\0';
+        return 1;
+    }
+
+    size_t wanted = p->block.needed ? p->block.needed : r->decompressor.signature_size;
+
+    int bytes_read = read_stream_nonblocking(r, &p->block.data[p->block.used], wanted - p->block.used);
+    if(unlikely(bytes_read < 0)) {
+        *reason = read_stream_error_to_reason(bytes_read);
+        return -1;
+    }
+
+    if(!bytes_read)
+        return 0;
+
+    worker_set_metric(WORKER_RECEIVER_JOB_BYTES_READ, (NETDATA_DOUBLE)bytes_read);
+
+    p->block.used += bytes_read;
+    if(p->block.used < wanted)
+        return 1;
+
+    p->block.used = 0;
+
+    if(!p->block.needed) {
+        // we have the compression signature of the next block
+        size_t compressed_message_size = rrdpush_decompressor_start(&r->decompressor, p->block.data, wanted);
+        if (unlikely(!compressed_message_size)) {
+            internal_error(true, "multiplexed uncompressed data in compressed stream!");
+            memcpy(r->reader.read_buffer + r->reader.read_len, p->block.data, wanted);
+            r->reader.read_len += (ssize_t)wanted;
+            r->reader.read_buffer[r->reader.read_len] = '\0';
+            return 1;
+        }
+
+        if(unlikely(compressed_message_size > COMPRESSION_MAX_MSG_SIZE)) {
+            netdata_log_error("received a compressed message of %zu bytes, which is bigger than the max compressed message size supported of %zu. Ignoring message.",
+                              compressed_message_size, (size_t)COMPRESSION_MAX_MSG_SIZE);
+            return -1;
+        }
+
+        p->block.needed = compressed_message_size;
+        return 1;
+    }
+
+    // we have the entire compressed block
+    p->block.needed = 0;
+
+    size_t bytes_to_parse = rrdpush_decompress(&r->decompressor, p->block.data, wanted);
+    if (unlikely(!bytes_to_parse)) {
+        internal_error(true, "no bytes to parse.");
+        return -1;
+    }
+
+    worker_set_metric(WORKER_RECEIVER_JOB_BYTES_UNCOMPRESSED, (NETDATA_DOUBLE)bytes_to_parse);
+
+    // the next call will move the decompressed data to the read buffer
+    return 1;
+}
+
+// data that have been received, but poll() will not report
+static inline bool receivers_pool_has_buffered_data(struct receivers_pool_receiver *p) {
+    if(p->compressed && rrdpush_decompressed_bytes_in_buffer(&p->rpt->decompressor))
+        return true;
+
+#ifdef ENABLE_HTTPS
+    if(SSL_connection(&p->rpt->ssl) && SSL_pending(p->rpt->ssl.conn) > 0)
+        return true;
+#endif
+
+    return false;
+}
+
+// returns false when the child has to be disconnected
+static bool receivers_pool_receive(struct receivers_pool_receiver *p, time_t now_s) {
+    struct receiver_state *rpt = p->rpt;
+    PARSER *parser = p->parser;
+
+    ND_LOG_STACK lgs[] = {
+            ND_LOG_FIELD_TXT(NDF_SRC_IP, rpt->client_ip),
+            ND_LOG_FIELD_TXT(NDF_SRC_PORT, rpt->client_port),
+            ND_LOG_FIELD_CB(NDF_SRC_TRANSPORT, stream_receiver_log_transport, rpt),
+            ND_LOG_FIELD_CB(NDF_SRC_CAPABILITIES, stream_receiver_log_capabilities, rpt),
+            ND_LOG_FIELD_CB(NDF_REQUEST, line_splitter_reconstruct_line, &parser->line),
+            ND_LOG_FIELD_CB(NDF_NIDL_NODE, parser_reconstruct_node, parser),
+            ND_LOG_FIELD_CB(NDF_NIDL_INSTANCE, parser_reconstruct_instance, parser),
+            ND_LOG_FIELD_CB(NDF_NIDL_CONTEXT, parser_reconstruct_context, parser),
+            ND_LOG_FIELD_END(),
+    };
+    ND_LOG_STACK_PUSH(lgs);
+
+    rrd_collector_attach(p->collector);
+    rpt->tid = gettid();
+
+    bool keep = true;
+    size_t reads = 0;
+
+    while(keep) {
+        if(receiver_should_stop(rpt)) {
+            keep = false;
+            break;
+        }
+
+        if(buffered_reader_next_line(&rpt->reader, p->line)) {
+            if(unlikely(parser_action(parser, p->line->buffer))) {
+                receiver_set_exit_reason(rpt, STREAM_HANDSHAKE_DISCONNECT_PARSER_FAILED, false);
+                keep = false;
+                break;
+            }
+
+            p->line->len = 0;
+            p->line->buffer[0] = '\0';
+            continue;
+        }
+
+        // yield to the other children - poll() will bring us back
+        if(reads >= RECEIVERS_POOL_READS_PER_TURN && !receivers_pool_has_buffered_data(p))
+            break;
+
+        STREAM_HANDSHAKE reason = STREAM_HANDSHAKE_DISCONNECT_UNKNOWN_SOCKET_READ_ERROR;
+        int rc = p->compressed ? receivers_pool_read_compressed(p, &reason)
+                               : receivers_pool_read_uncompressed(p, &reason);
+
+        if(unlikely(rc < 0)) {
+            receiver_set_exit_reason(rpt, reason, false);
+            keep = false;
+            break;
+        }
+
+        if(!rc)
+            break;
+
+        reads++;
+        p->last_read_s = now_s;
+        rpt->last_msg_t = now_s;
+    }
+
+    p->collector = rrd_collector_detach();
+    return keep;
+}
+
+static void receivers_pool_adopt_incoming(struct receivers_pool_thread *t) {
+    spinlock_lock(&t->spinlock);
+    struct receivers_pool_receiver *incoming = t->incoming;
+    t->incoming = NULL;
+    spinlock_unlock(&t->spinlock);
+
+    while(incoming) {
+        struct receivers_pool_receiver *p = incoming;
+        DOUBLE_LINKED_LIST_REMOVE_ITEM_UNSAFE(incoming, p, prev, next);
+
+        struct receiver_state *rpt = p->rpt;
+
+        // the functions of the child are registered to the collector of the thread
+        // each child gets its own collector, attached while it is served
+        p->parser = receiver_parser_create(rpt, &p->cd, rpt->fd,
+#ifdef ENABLE_HTTPS
+                                           (rpt->ssl.conn) ? &rpt->ssl : NULL
+#else
+                                           NULL
+#endif
+                                           );
+        rrd_collector_started();
+        p->collector = rrd_collector_detach();
+
+        // the socket is non-blocking, so the pool thread sends what the child cannot receive now later
+        parser_writer_nonblocking(p->parser, RECEIVERS_POOL_MAX_PENDING_BYTES, t->pipe[PIPE_WRITE]);
+
+        p->compressed = rrdpush_decompression_initialize(rpt);
+        buffered_reader_init(&rpt->reader);
+        p->line = buffer_create(sizeof(rpt->reader.read_buffer), NULL);
+        p->last_read_s = now_monotonic_sec();
+
+        DOUBLE_LINKED_LIST_APPEND_ITEM_UNSAFE(t->receivers, p, prev, next);
+    }
+}
+
+static void receivers_pool_release(struct receivers_pool_thread *t, struct receivers_pool_receiver *p) {
+    struct receiver_state *rpt = p->rpt;
+
+    DOUBLE_LINKED_LIST_REMOVE_ITEM_UNSAFE(t->receivers, p, prev, next);
+
+    ND_LOG_STACK lgs[] = {
+            ND_LOG_FIELD_TXT(NDF_SRC_IP, rpt->client_ip),
+            ND_LOG_FIELD_TXT(NDF_SRC_PORT, rpt->client_port),
+            ND_LOG_FIELD_TXT(NDF_NIDL_NODE, rpt->hostname),
+            ND_LOG_FIELD_CB(NDF_SRC_TRANSPORT, stream_receiver_log_transport, rpt),
+            ND_LOG_FIELD_CB(NDF_SRC_CAPABILITIES, stream_receiver_log_capabilities, rpt),
+            ND_LOG_FIELD_END(),
+    };
+    ND_LOG_STACK_PUSH(lgs);
+
+    size_t count = p->parser->user.data_collections_count;
+
+    // this also finishes the collector of the child
+    rrd_collector_attach(p->collector);
+    pluginsd_process_thread_cleanup(p->parser);
+    buffer_free(p->line);
+
+    rrdpush_receive_disconnected(rpt, count);
+    rrdhost_clear_receiver(rpt);
+
+    netdata_log_info("STREAM '%s' [receive from [%s]:%s]: "
+                     "left receivers pool thread %zu"
+                     , rpt->hostname ? rpt->hostname : "-"
+                     , rpt->client_ip ? rpt->client_ip : "-", rpt->client_port ? rpt->client_port : "-"
+                     , t->id);
+
+    receiver_state_free(rpt);
+    rrdhost_set_is_parent_label();
+
+    __atomic_sub_fetch(&t->count, 1, __ATOMIC_RELAXED);
+    freez(p);
+}
+
+static void receivers_pool_release_all(struct receivers_pool_thread *t) {
+    receivers_pool_adopt_incoming(t);
+    while(t->receivers) {
+        receiver_set_exit_reason(t->receivers->rpt, STREAM_HANDSHAKE_DISCONNECT_NETDATA_EXIT, false);
+        receivers_pool_release(t, t->receivers);
+    }
+}
+
+static void *receivers_pool_thread(void *ptr) {
+    struct receivers_pool_thread *t = ptr;
+
+    // the children of this thread are released when it exits,
+    // so it is stopped by service_running() and joined, never cancelled
+    netdata_thread_disable_cancelability();
+
+    receiver_worker_register();
+
+    size_t slots = 0;
+    struct pollfd *fds = NULL;
+    struct receivers_pool_receiver **served = NULL;
+
+    while(service_running(SERVICE_STREAMING)) {
+        receivers_pool_adopt_incoming(t);
+
+        size_t entries = 1;
+        for(struct receivers_pool_receiver *p = t->receivers; p ; p = p->next)
+            entries++;
+
+        if(entries > slots) {
+            slots = entries * 2;
+            fds = reallocz(fds, slots * sizeof(*fds));
+            served = reallocz(served, slots * sizeof(*served));
+        }
+
+        fds[0] = (struct pollfd){ .fd = t->pipe[PIPE_READ], .events = POLLIN, .revents = 0 };
+        served[0] = NULL;
+
+        size_t used = 1;
+        for(struct receivers_pool_receiver *p = t->receivers; p ; p = p->next, used++) {
+            short events = POLLIN;
+            if(parser_writer_has_pending(p->parser))
+                events |= POLLOUT;
+
+            fds[used] = (struct pollfd){ .fd = p->rpt->fd, .events = events, .revents = 0 };
+            served[used] = p;
+        }
+
+        worker_is_idle();
+        int rc = poll(fds, used, 1000);
+        if(rc < 0) {
+            if(errno != EINTR && errno != EAGAIN) {
+                netdata_log_error("STREAM: receivers pool thread %zu: poll() failed", t->id);
+                sleep_usec(100 * USEC_PER_MS);
+            }
+            continue;
+        }
+
+        if(fds[0].revents & POLLIN) {
+            char buffer[1024];
+            if(read(t->pipe[PIPE_READ], buffer, sizeof(buffer)) == -1 && errno != EAGAIN && errno != EINTR)
+                netdata_log_error("STREAM: receivers pool thread %zu: cannot read from internal pipe", t->id);
+        }
+
+        time_t now_s = now_monotonic_sec();
+        for(size_t i = 1; i < used ;i++) {
+            struct receivers_pool_receiver *p = served[i];
+            bool keep = true;
+
+            if(fds[i].revents & ~POLLOUT)
+                keep = receivers_pool_receive(p, now_s);
+
+            else if(!fds[i].revents && now_s - p->last_read_s > RECEIVERS_POOL_IDLE_TIMEOUT_S) {
+                receiver_set_exit_reason(p->rpt, STREAM_HANDSHAKE_DISCONNECT_SOCKET_READ_TIMEOUT, false);
+                keep = false;
+            }
+
+            // send whatever the parser could not send to the child before
+            if(keep && !parser_writer_flush(p->parser)) {
+                receiver_set_exit_reason(p->rpt, STREAM_HANDSHAKE_DISCONNECT_SOCKET_WRITE_FAILED, false);
+                keep = false;
+            }
+
+            if(!keep)
+                receivers_pool_release(t, p);
+        }
+    }
+
+    // netdata is exiting
+    receivers_pool_release_all(t);
+
+    freez(fds);
+    freez(served);
+    worker_unregister();
+    return NULL;
+}
+
+static void receivers_pool_start_unsafe(void) {
+    receivers_pool.array = callocz(rrdpush_receivers_pool_threads, sizeof(*receivers_pool.array));
+
+    for(size_t i = 0; i < rrdpush_receivers_pool_threads ;i++) {
+        struct receivers_pool_thread *t = &receivers_pool.array[receivers_pool.threads];
+        t->id = i;
+        spinlock_init(&t->spinlock);
+
+        if(pipe(t->pipe) != 0) {
+            netdata_log_error("STREAM: cannot create the internal pipe of receivers pool thread %zu", i);
+            continue;
+        }
+        sock_setnonblock(t->pipe[PIPE_READ]);
+        sock_setnonblock(t->pipe[PIPE_WRITE]);
+
+        char tag[NETDATA_THREAD_TAG_MAX + 1];
+        snprintfz(tag, NETDATA_THREAD_TAG_MAX, THREAD_TAG_STREAM_RECEIVERS_POOL "[%zu]", i);
+
+        if(netdata_thread_create(&t->thread, tag, NETDATA_THREAD_OPTION_JOINABLE, receivers_pool_thread, t)) {
+            netdata_log_error("STREAM: cannot create receivers pool thread %zu", i);
+            close(t->pipe[PIPE_READ]);
+            close(t->pipe[PIPE_WRITE]);
+            continue;
+        }
+
+        receivers_pool.threads++;
+    }
+}
+
+// called by the receiver thread of a child, after the handshake
+// returns false when the receiver thread has to serve the child itself
+static bool receivers_pool_add(struct receiver_state *rpt, struct plugind *cd) {
+    if(sock_setnonblock(rpt->fd) < 0) {
+        netdata_log_error("STREAM '%s' [receive from [%s]:%s]: "
+                          "cannot set the non-blocking flag to socket %d, serving it from its own thread"
+                          , rrdhost_hostname(rpt->host)
+                          , rpt->client_ip, rpt->client_port
+                          , rpt->fd);
+        return false;
+    }
+
+    // from now on rpt belongs to the pool thread,
+    // so this thread must exit without being cancelled
+    netdata_thread_disable_cancelability();
+
+    struct receivers_pool_receiver *p = callocz(1, sizeof(*p));
+    p->rpt = rpt;
+    p->cd = *cd;
+
+    netdata_mutex_lock(&rpt->host->receiver_lock);
+    rpt->pool = p;
+    netdata_mutex_unlock(&rpt->host->receiver_lock);
+
+    // the pool spinlock is held until the child is handed over,
+    // so that the pool cannot be stopped in the meantime
+    struct receivers_pool_thread *t = NULL;
+    spinlock_lock(&receivers_pool.spinlock);
+
+    if(!receivers_pool.array && !receivers_pool.stopped)
+        receivers_pool_start_unsafe();
+
+    for(size_t i = 0; i < receivers_pool.threads ;i++) {
+        struct receivers_pool_thread *c = &receivers_pool.array[i];
+        if(!t || __atomic_load_n(&c->count, __ATOMIC_RELAXED) < __atomic_load_n(&t->count, __ATOMIC_RELAXED))
+            t = c;
+    }
+
+    if(t) {
+        p->thread = t;
+        __atomic_add_fetch(&t->count, 1, __ATOMIC_RELAXED);
+
+        spinlock_lock(&t->spinlock);
+        DOUBLE_LINKED_LIST_APPEND_ITEM_UNSAFE(t->incoming, p, prev, next);
+        spinlock_unlock(&t->spinlock);
+
+        // the pool thread wakes up every second anyway
+        if(write(t->pipe[PIPE_WRITE], " ", 1) == -1 && errno != EAGAIN && errno != EWOULDBLOCK)
+            netdata_log_error("STREAM: cannot write to the internal pipe of receivers pool thread %zu", t->id);
+    }
+
+    spinlock_unlock(&receivers_pool.spinlock);
+
+    if(!t) {
+        netdata_mutex_lock(&rpt->host->receiver_lock);
+        rpt->pool = NULL;
+        netdata_mutex_unlock(&rpt->host->receiver_lock);
+
+        freez(p);
+        sock_delnonblock(rpt->fd);
+        netdata_thread_enable_cancelability();
+        return false;
+    }
+
+    return true;
+}
+
+// called at netdata exit, after the streaming threads have been signaled to stop
+void rrdpush_receivers_pool_stop(void) {
+    spinlock_lock(&receivers_pool.spinlock);
+    receivers_pool.stopped = true;
+    size_t threads = receivers_pool.threads;
+    struct receivers_pool_thread *array = receivers_pool.array;
+    receivers_pool.threads = 0;
+    receivers_pool.array = NULL;
+    spinlock_unlock(&receivers_pool.spinlock);
+
+    for(size_t i = 0; i < threads ;i++) {
+        struct receivers_pool_thread *t = &array[i];
+
+        if(write(t->pipe[PIPE_WRITE], " ", 1) == -1 && errno != EAGAIN && errno != EWOULDBLOCK)
+            netdata_log_error("STREAM: cannot write to the internal pipe of receivers pool thread %zu", t->id);
+
+        netdata_thread_join(t->thread, NULL);
+
+        // children handed over while the thread was exiting
+        receivers_pool_release_all(t);
+
+        close(t->pipe[PIPE_READ]);
+        close(t->pipe[PIPE_WRITE]);
+    }
+
+    freez(array);
+}
+
+void *rrdpush_receiver_thread(void *ptr) {
+    bool pooled = false;
+
+    netdata_thread_cleanup_push(rrdpush_receiver_thread_cleanup, ptr);
+
+            {
+                receiver_worker_register();
 
                 struct receiver_state *rpt = (struct receiver_state *) ptr;
                 rpt->tid = gettid();
@@ -920,9 +1520,14 @@ void *rrdpush_receiver_thread(void *ptr) {
                 netdata_log_info("STREAM %s [%s]:%s: receive thread started", rpt->hostname, rpt->client_ip
                                  , rpt->client_port);
 
-                rrdpush_receive(rpt);
+                // rpt belongs to the receivers pool when this returns true
+                pooled = rrdpush_receive(rpt);
             }
 
-    netdata_thread_cleanup_pop(1);
+    netdata_thread_cleanup_pop(!pooled);
+
+    if(pooled)
+        worker_unregister();
+
     return NULL;
 }
@@ -165,8 +165,10 @@ static struct replication_query *replication_query_prepare(
     q->backend = st->rrdhost->db[0].eng->backend;
 
     // prepare our array of dimensions
+    // the dimensions of a chart are stored in the same extents, so their queries are prepared as a group
     size_t count = 0;
     RRDDIM *rd;
+    storage_engine_query_group_begin();
     rrddim_foreach_read(rd, st) {
         if (unlikely(!rd || !rd_dfe.item || !rrddim_check_upstream_exposed(rd)))
             continue;
@@ -191,6 +193,7 @@ static struct replication_query *replication_query_prepare(
         count++;
     }
     rrddim_foreach_done(rd);
+    storage_engine_query_group_end();
 
     if(!count) {
         // no data for this chart
@@ -973,8 +976,9 @@ bool replicate_chart_request(send_command callback, void *callback_data, RRDHOST
 struct replication_request {
     struct sender_state *sender;        // the sender we should put the reply at
     STRING *chart_id;                   // the chart of the request
-    time_t after;                       // the start time of the query (maybe zero) key for sorting (JudyL)
+    time_t after;                       // the start time of the query (maybe zero)
     time_t before;                      // the end time of the query (maybe zero)
+    Word_t fair_tag;                    // the fair scheduling tag of the request, key for sorting (JudyL)
 
     usec_t sender_last_flush_ut;        // the timestamp of the sender, at the time we indexed this request
     Word_t unique_id;                   // auto-increment, later requests have bigger
@@ -993,6 +997,13 @@ struct replication_request {
 
 // replication sort entry in JudyL array
 // used for sorting all requests, across all nodes
+//
+// The requests are sorted by their fair scheduling tag (start-time fair queuing):
+// each request of a sender is tagged one after the previous request of the same
+// sender, but never before the tag of the last request executed. So, senders with
+// pending requests are served round-robin, one request each, and a sender that
+// keeps asking for more (e.g. a child replicating a month of data) cannot starve
+// the others. The requests of a sender are served in the order they are received.
 struct replication_sort_entry {
     struct replication_request *rq;
 
@@ -1019,9 +1030,11 @@ static struct replication_thread {
         time_t first_time_t;            // the minimum 'after' we encountered
 
         struct {
-            Word_t after;
+            Word_t fair_tag;            // the position of the next scan in the queue
             Word_t unique_id;
             Pvoid_t JudyL_array;
+
+            Word_t virtual_time;        // the fair scheduling tag of the last request executed
         } queue;
 
     } unsafe;                           // protected from replication_recursive_lock()
@@ -1055,9 +1068,10 @@ static struct replication_thread {
                 .first_time_t = 0,
 
                 .queue = {
-                        .after = 0,
+                        .fair_tag = 0,
                         .unique_id = 0,
                         .JudyL_array = NULL,
+                        .virtual_time = 0,
                 },
         },
         .atomic = {
@@ -1115,9 +1129,9 @@ static inline bool replication_recursive_lock_mode(char mode) {
         fatal("REPLICATION: reached %s, but replication is not locked by this thread.", __FUNCTION__); \
 } while(0)
 
-void replication_set_next_point_in_time(time_t after, size_t unique_id) {
+void replication_set_next_point_in_time(Word_t fair_tag, size_t unique_id) {
     replication_recursive_lock();
-    replication_globals.unsafe.queue.after = after;
+    replication_globals.unsafe.queue.fair_tag = fair_tag;
     replication_globals.unsafe.queue.unique_id = unique_id;
     replication_recursive_unlock();
 }
@@ -1180,11 +1194,20 @@ static void replication_sort_entry_add(struct replication_request *rq) {
     replication_globals.unsafe.added++;
     replication_globals.unsafe.pending++;
 
+    // tag it after the previous request of the same sender, when that is still pending,
+    // but never before the last request executed
+    Word_t fair_tag = replication_globals.unsafe.queue.virtual_time;
+    if((Word_t)rq->sender->replication.fair_tag > fair_tag && rrdpush_sender_pending_replication_requests(rq->sender) > 1)
+        fair_tag = (Word_t)rq->sender->replication.fair_tag;
+
+    rq->fair_tag = ++fair_tag;
+    rq->sender->replication.fair_tag = (size_t)fair_tag;
+
     Pvoid_t *inner_judy_ptr;
 
-    // find the outer judy entry, using after as key
+    // find the outer judy entry, using the fair tag as key
     size_t mem_before_outer_judyl = JudyLMemUsed(replication_globals.unsafe.queue.JudyL_array);
-    inner_judy_ptr = JudyLIns(&replication_globals.unsafe.queue.JudyL_array, (Word_t) rq->after, PJE0);
+    inner_judy_ptr = JudyLIns(&replication_globals.unsafe.queue.JudyL_array, rq->fair_tag, PJE0);
     size_t mem_after_outer_judyl = JudyLMemUsed(replication_globals.unsafe.queue.JudyL_array);
     if(unlikely(!inner_judy_ptr || inner_judy_ptr == PJERR))
         fatal("REPLICATION: corrupted outer judyL");
@@ -1233,7 +1256,7 @@ static bool replication_sort_entry_unlink_and_free_unsafe(struct replication_sor
     // if no items left, delete it from the outer judy
     if(**inner_judy_ppptr == NULL) {
         size_t mem_before_outer_judyl = JudyLMemUsed(replication_globals.unsafe.queue.JudyL_array);
-        JudyLDel(&replication_globals.unsafe.queue.JudyL_array, rse->rq->after, PJE0);
+        JudyLDel(&replication_globals.unsafe.queue.JudyL_array, rse->rq->fair_tag, PJE0);
         size_t mem_after_outer_judyl = JudyLMemUsed(replication_globals.unsafe.queue.JudyL_array);
         memory_saved += mem_before_outer_judyl - mem_after_outer_judyl;
         inner_judy_deleted = true;
@@ -1254,7 +1277,7 @@ static void replication_sort_entry_del(struct replication_request *rq, bool buff
     replication_recursive_lock();
     if(rq->indexed_in_judy) {
 
-        inner_judy_pptr = JudyLGet(replication_globals.unsafe.queue.JudyL_array, rq->after, PJE0);
+        inner_judy_pptr = JudyLGet(replication_globals.unsafe.queue.JudyL_array, rq->fair_tag, PJE0);
         if (inner_judy_pptr) {
             Pvoid_t *our_item_pptr = JudyLGet(*inner_judy_pptr, rq->unique_id, PJE0);
             if (our_item_pptr) {
@@ -1284,12 +1307,12 @@ static struct replication_request replication_request_get_first_available() {
 
     struct replication_request rq_to_return = (struct replication_request){ .found = false };
 
-    if(unlikely(!replication_globals.unsafe.queue.after || !replication_globals.unsafe.queue.unique_id)) {
-        replication_globals.unsafe.queue.after = 0;
+    if(unlikely(!replication_globals.unsafe.queue.fair_tag || !replication_globals.unsafe.queue.unique_id)) {
+        replication_globals.unsafe.queue.fair_tag = 0;
         replication_globals.unsafe.queue.unique_id = 0;
     }
 
-    Word_t started_after = replication_globals.unsafe.queue.after;
+    Word_t started_fair_tag = replication_globals.unsafe.queue.fair_tag;
 
     size_t round = 0;
     while(!rq_to_return.found) {
@@ -1299,18 +1322,18 @@ static struct replication_request replication_request_get_first_available() {
             break;
 
         if(round == 2) {
-            if(started_after == 0)
+            if(started_fair_tag == 0)
                 break;
 
-            replication_globals.unsafe.queue.after = 0;
+            replication_globals.unsafe.queue.fair_tag = 0;
             replication_globals.unsafe.queue.unique_id = 0;
         }
 
         bool find_same_after = true;
-        while (!rq_to_return.found && (inner_judy_pptr = JudyLFirstThenNext(replication_globals.unsafe.queue.JudyL_array, &replication_globals.unsafe.queue.after, &find_same_after))) {
+        while (!rq_to_return.found && (inner_judy_pptr = JudyLFirstThenNext(replication_globals.unsafe.queue.JudyL_array, &replication_globals.unsafe.queue.fair_tag, &find_same_after))) {
             Pvoid_t *our_item_pptr;
 
-            if(unlikely(round == 2 && replication_globals.unsafe.queue.after > started_after))
+            if(unlikely(round == 2 && replication_globals.unsafe.queue.fair_tag > started_fair_tag))
                 break;
 
             while (!rq_to_return.found && (our_item_pptr = JudyLNext(*inner_judy_pptr, &replication_globals.unsafe.queue.unique_id, PJE0))) {
@@ -1324,6 +1347,10 @@ static struct replication_request replication_request_get_first_available() {
                 // set the return result to found
                 rq_to_return.found = true;
 
+                // the requests queued from now on are tagged after this one
+                if(rq->fair_tag > replication_globals.unsafe.queue.virtual_time)
+                    replication_globals.unsafe.queue.virtual_time = rq->fair_tag;
+
                 if (replication_sort_entry_unlink_and_free_unsafe(rse, &inner_judy_pptr, true))
                     // we removed the item from the outer JudyL
                     break;
@@ -92,6 +92,22 @@ bool rrdpush_receiver_needs_dbengine() {
     return false;
 }
 
+// zero disables the pool, anything else is limited to a few threads per cpu
+static size_t rrdpush_pool_threads_config(const char *option, size_t default_threads) {
+    long long max = (long long)get_netdata_cpus() * 4;
+    long long threads = appconfig_get_number(&stream_config, CONFIG_SECTION_STREAM, option, (long long)default_threads);
+
+    if(threads < 0 || threads > max) {
+        long long clamped = (threads < 0) ? 0 : max;
+        netdata_log_error("STREAM: [" CONFIG_SECTION_STREAM "].%s = %lld is out of range, using %lld (valid range is 0 to %lld)",
+                          option, threads, clamped, max);
+        threads = clamped;
+        appconfig_set_number(&stream_config, CONFIG_SECTION_STREAM, option, threads);
+    }
+
+    return (size_t)threads;
+}
+
 int rrdpush_init() {
     // --------------------------------------------------------------------
     // load stream.conf
@@ -127,6 +143,16 @@ int rrdpush_init() {
             &stream_config, CONFIG_SECTION_STREAM, "gzip compression level",
             rrdpush_compression_levels[COMPRESSION_ALGORITHM_GZIP]);
 
+    rrdpush_receivers_pool_threads = rrdpush_pool_threads_config("receivers pool threads", rrdpush_receivers_pool_threads);
+
+    rrdpush_senders_pool_threads = rrdpush_pool_threads_config("senders pool threads", rrdpush_senders_pool_threads);
+
+    if(!appconfig_get_boolean(&stream_config, CONFIG_SECTION_STREAM, "binary data", true))
+        globally_disabled_capabilities |= STREAM_CAP_BINARY_DATA;
+
+    if(!appconfig_get_boolean(&stream_config, CONFIG_SECTION_STREAM, "delta encoding", true))
+        globally_disabled_capabilities |= STREAM_CAP_BINARY_DELTA;
+
     if(default_rrdpush_enabled && (!default_rrdpush_destination || !*default_rrdpush_destination || !default_rrdpush_api_key || !*default_rrdpush_api_key)) {
         nd_log_daemon(NDLP_WARNING, "STREAM [send]: cannot enable sending thread - information is missing.");
         default_rrdpush_enabled = 0;
@@ -219,11 +245,21 @@ static void rrdpush_send_clabels(BUFFER *wb, RRDSET *st) {
     }
 }
 
+// Invalidate the delta bases of all the dimensions of the chart,
+// so that the next values are sent in full (STREAM_CAP_BINARY_DELTA).
+static inline void rrdset_push_delta_reset(RRDSET *st) {
+    if(unlikely(!++st->rrdpush.sender.delta_generation))
+        st->rrdpush.sender.delta_generation++;
+}
+
 // Send the current chart definition.
 // Assumes that collector thread has already called sender_start for mutex / buffer state.
 static inline bool rrdpush_send_chart_definition(BUFFER *wb, RRDSET *st) {
     uint32_t version = rrdset_metadata_version(st);
 
+    // the parent has not received any values of this chart on this connection
+    rrdset_push_delta_reset(st);
+
     RRDHOST *host = st->rrdhost;
     NUMBER_ENCODING integer_encoding = stream_has_capability(host->sender, STREAM_CAP_IEEE754) ? NUMBER_ENCODING_BASE64 : NUMBER_ENCODING_HEX;
     bool with_slots = stream_has_capability(host->sender, STREAM_CAP_SLOTS) ? true : false;
@@ -408,10 +444,47 @@ void rrdset_push_metrics_v1(RRDSET_STREAM_BUFFER *rsb, RRDSET *st) {
     rrdpush_send_chart_metrics(rsb->wb, st, host->sender, rsb->rrdset_flags);
 }
 
+static void rrddim_push_metrics_v2_binary(RRDSET_STREAM_BUFFER *rsb, RRDDIM *rd, time_t point_end_time_s, NETDATA_DOUBLE n, SN_FLAGS flags) {
+    bool with_slots = stream_has_capability(rsb, STREAM_CAP_SLOTS) ? true : false;
+    BUFFER *wb = rsb->wb;
+
+    if(unlikely(rsb->last_point_end_time_s != point_end_time_s)) {
+        if(unlikely(rsb->begin_v2_added))
+            stream_binary_end(wb, &rsb->binary);
+
+        stream_binary_begin(wb, &rsb->binary,
+                            with_slots ? rd->rrdset->rrdpush.sender.chart_slot : 0,
+                            rrdset_id(rd->rrdset), string_strlen(rd->rrdset->id),
+                            rd->rrdset->update_every, point_end_time_s, rsb->wall_clock_time);
+
+        rsb->last_point_end_time_s = point_end_time_s;
+        rsb->begin_v2_added = true;
+    }
+
+    rrddim_push_metrics_v2_binary_set(rsb, rd, rd->collector.last_collected_value, n, flags);
+}
+
+void rrddim_push_metrics_v2_binary_set(RRDSET_STREAM_BUFFER *rsb, RRDDIM *rd, collected_number collected_value, NETDATA_DOUBLE n, SN_FLAGS flags) {
+    uint64_t slot = stream_has_capability(rsb, STREAM_CAP_SLOTS) ? rd->rrdpush.sender.dim_slot : 0;
+
+    if(stream_has_capability(rsb, STREAM_CAP_BINARY_DELTA))
+        stream_binary_set_with_base(rsb->wb, &rsb->binary, slot, rrddim_id(rd), string_strlen(rd->id),
+                                    collected_value, n, flags,
+                                    &rd->rrdpush.sender.delta, rd->rrdset->rrdpush.sender.delta_generation);
+    else
+        stream_binary_set(rsb->wb, &rsb->binary, slot, rrddim_id(rd), string_strlen(rd->id),
+                          collected_value, n, flags);
+}
+
 void rrddim_push_metrics_v2(RRDSET_STREAM_BUFFER *rsb, RRDDIM *rd, usec_t point_end_time_ut, NETDATA_DOUBLE n, SN_FLAGS flags) {
     if(!rsb->wb || !rsb->v2 || !netdata_double_isnumber(n) || !does_storage_number_exist(flags))
         return;
 
+    if(stream_has_capability(rsb, STREAM_CAP_BINARY_DATA)) {
+        rrddim_push_metrics_v2_binary(rsb, rd, (time_t)(point_end_time_ut / USEC_PER_SEC), n, flags);
+        return;
+    }
+
     bool with_slots = stream_has_capability(rsb, STREAM_CAP_SLOTS) ? true : false;
     NUMBER_ENCODING integer_encoding = stream_has_capability(rsb, STREAM_CAP_IEEE754) ? NUMBER_ENCODING_BASE64 : NUMBER_ENCODING_HEX;
     NUMBER_ENCODING doubles_encoding = stream_has_capability(rsb, STREAM_CAP_IEEE754) ? NUMBER_ENCODING_BASE64 : NUMBER_ENCODING_DECIMAL;
@@ -474,13 +547,24 @@ void rrdset_push_metrics_finished(RRDSET_STREAM_BUFFER *rsb, RRDSET *st) {
         return;
 
     if(rsb->v2 && rsb->begin_v2_added) {
-        if(unlikely(rsb->rrdset_flags & RRDSET_FLAG_UPSTREAM_SEND_VARIABLES))
+        bool binary = stream_has_capability(rsb, STREAM_CAP_BINARY_DATA);
+
+        if(unlikely(rsb->rrdset_flags & RRDSET_FLAG_UPSTREAM_SEND_VARIABLES)) {
+            // the variables are text lines
+            if(binary)
+                stream_binary_frame_close(rsb->wb, &rsb->binary);
+
             rrdsetvar_print_to_streaming_custom_chart_variables(st, rsb->wb);
+        }
 
-        buffer_fast_strcat(rsb->wb, PLUGINSD_KEYWORD_END_V2 "\n", sizeof(PLUGINSD_KEYWORD_END_V2) - 1 + 1);
+        if(binary)
+            stream_binary_end(rsb->wb, &rsb->binary);
+        else
+            buffer_fast_strcat(rsb->wb, PLUGINSD_KEYWORD_END_V2 "\n", sizeof(PLUGINSD_KEYWORD_END_V2) - 1 + 1);
     }
 
     sender_commit(st->rrdhost->sender, rsb->wb, STREAM_TRAFFIC_TYPE_DATA);
+    st->rrdpush.sender.delta_in_flight = false;
 
     *rsb = (RRDSET_STREAM_BUFFER){ .wb = NULL, };
 }
@@ -565,6 +649,13 @@ RRDSET_STREAM_BUFFER rrdset_push_metric_initialize(RRDSET *st, time_t wall_clock
     if(replication_in_progress)
         return (RRDSET_STREAM_BUFFER) { .wb = NULL, };
 
+    if(unlikely(st->rrdpush.sender.delta_in_flight))
+        // the previous update of the chart was abandoned, so the parent
+        // did not receive the values the delta bases have
+        rrdset_push_delta_reset(st);
+
+    st->rrdpush.sender.delta_in_flight = true;
+
     return (RRDSET_STREAM_BUFFER) {
         .capabilities = host->sender->capabilities,
         .v2 = stream_has_capability(host->sender, STREAM_CAP_INTERPOLATED),
@@ -832,8 +923,9 @@ void rrdpush_sender_thread_stop(RRDHOST *host, STREAM_HANDSHAKE reason, bool wai
         host->sender->exit.shutdown = true;
         host->sender->exit.reason = reason;
 
-        // signal it to cancel
-        netdata_thread_cancel(host->rrdpush_sender_thread);
+        // signal it to cancel - the senders pool checks exit.shutdown
+        if(!host->sender->pool)
+            netdata_thread_cancel(host->rrdpush_sender_thread);
     }
 
     sender_unlock(host->sender);
@@ -1371,6 +1463,7 @@ static struct {
     {STREAM_HANDSHAKE_DISCONNECT_SOCKET_EOF, "DISCONNECTED SOCKET EOF" },
     {STREAM_HANDSHAKE_DISCONNECT_SOCKET_READ_FAILED, "DISCONNECTED SOCKET READ FAILED" },
     {STREAM_HANDSHAKE_DISCONNECT_SOCKET_READ_TIMEOUT, "DISCONNECTED SOCKET READ TIMEOUT" },
+    {STREAM_HANDSHAKE_DISCONNECT_SOCKET_WRITE_FAILED, "DISCONNECTED SOCKET WRITE FAILED" },
     { 0, NULL },
 };
 
@@ -1410,6 +1503,8 @@ static struct {
     {STREAM_CAP_ZSTD,         "ZSTD" },
     {STREAM_CAP_GZIP,         "GZIP" },
     {STREAM_CAP_BROTLI,       "BROTLI" },
+    {STREAM_CAP_BINARY_DATA,  "BINARY_DATA" },
+    {STREAM_CAP_BINARY_DELTA, "BINARY_DELTA" },
     {0 , NULL },
 };
 
@@ -1492,6 +1587,8 @@ STREAM_CAPABILITIES stream_our_capabilities(RRDHOST *host, bool sender) {
             #endif
             STREAM_CAP_IEEE754 |
             STREAM_CAP_DATA_WITH_ML |
+            STREAM_CAP_BINARY_DATA |
+            STREAM_CAP_BINARY_DELTA |
             0) & ~disabled_capabilities;
 }
 
@@ -1520,6 +1617,14 @@ STREAM_CAPABILITIES convert_stream_version_to_capabilities(int32_t version, RRDH
         // DATA WITH ML requires INTERPOLATED
         common_caps &= ~STREAM_CAP_DATA_WITH_ML;
 
+    if(!(common_caps & STREAM_CAP_INTERPOLATED) || !(common_caps & STREAM_CAP_IEEE754))
+        // BINARY DATA requires INTERPOLATED and IEEE754
+        common_caps &= ~STREAM_CAP_BINARY_DATA;
+
+    if(!(common_caps & STREAM_CAP_BINARY_DATA))
+        // BINARY DELTA requires BINARY DATA
+        common_caps &= ~STREAM_CAP_BINARY_DELTA;
+
     return common_caps;
 }
 
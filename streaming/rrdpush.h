@@ -4,6 +4,7 @@
 #define NETDATA_RRDPUSH_H 1
 
 #include "libnetdata/libnetdata.h"
+#include "binary.h"
 #include "daemon/common.h"
 #include "web/server/web_client.h"
 #include "database/rrdfunctions.h"
@@ -52,6 +53,8 @@ typedef enum {
     STREAM_CAP_ZSTD             = (1 << 19), // ZSTD compression supported
     STREAM_CAP_GZIP             = (1 << 20), // GZIP compression supported
     STREAM_CAP_BROTLI           = (1 << 21), // BROTLI compression supported
+    STREAM_CAP_BINARY_DATA      = (1 << 22), // BEGIN2 / SET2 / END2 are sent in binary frames
+    STREAM_CAP_BINARY_DELTA     = (1 << 23), // the values of binary frames are sent as deltas from the previous ones
 
     STREAM_CAP_INVALID          = (1 << 30), // used as an invalid value for capabilities when this is set
     // this must be signed int, so don't use the last bit
@@ -163,6 +166,7 @@ typedef enum {
     STREAM_HANDSHAKE_DISCONNECT_SOCKET_READ_FAILED = -25,
     STREAM_HANDSHAKE_DISCONNECT_SOCKET_READ_TIMEOUT = -26,
     STREAM_HANDSHAKE_ERROR_HTTP_UPGRADE = -27,
+    STREAM_HANDSHAKE_DISCONNECT_SOCKET_WRITE_FAILED = -28,
 
 } STREAM_HANDSHAKE;
 
@@ -204,9 +208,12 @@ struct function_payload_state {
     char *timeout;
 };
 
+struct senders_pool_sender;
+
 struct sender_state {
     RRDHOST *host;
     pid_t tid;                              // the thread id of the sender, from gettid()
+    struct senders_pool_sender *pool;       // set when this sender is served by the senders pool
     SENDER_FLAGS flags;
     int timeout;
     int default_port;
@@ -259,6 +266,7 @@ struct sender_state {
         DICTIONARY *requests;                   // de-duplication of replication requests, per chart
         time_t oldest_request_after_t;          // the timestamp of the oldest replication request
         time_t latest_completed_before_t;       // the timestamp of the latest replication request
+        size_t fair_tag;                        // the scheduling tag of the last request queued (protected by the replication lock)
 
         struct {
             size_t pending_requests;            // the currently outstanding replication requests
@@ -332,6 +340,8 @@ typedef struct stream_node_instance {
 } STREAM_NODE_INSTANCE;
 */
 
+struct receivers_pool_receiver;
+
 struct receiver_state {
     RRDHOST *host;
     pid_t tid;
@@ -388,6 +398,9 @@ struct receiver_state {
     time_t replication_first_time_t;
 
     struct decompressor_state decompressor;
+
+    struct receivers_pool_receiver *pool; // set when this receiver is served by the receivers pool
+
 /*
     struct {
         uint32_t count;
@@ -426,6 +439,8 @@ extern bool default_rrdpush_enable_replication;
 extern time_t default_rrdpush_seconds_to_replicate;
 extern time_t default_rrdpush_replication_step;
 extern unsigned int remote_clock_resync_iterations;
+extern size_t rrdpush_receivers_pool_threads;
+extern size_t rrdpush_senders_pool_threads;
 
 void rrdpush_destinations_init(RRDHOST *host);
 void rrdpush_destinations_free(RRDHOST *host);
@@ -433,6 +448,8 @@ void rrdpush_destinations_free(RRDHOST *host);
 BUFFER *sender_start(struct sender_state *s);
 void sender_commit(struct sender_state *s, BUFFER *wb, STREAM_TRAFFIC_TYPE type);
 int rrdpush_init();
+void rrdpush_receivers_pool_stop(void);
+void rrdpush_senders_pool_stop(void);
 bool rrdpush_receiver_needs_dbengine();
 int configured_as_parent();
 
@@ -444,12 +461,14 @@ typedef struct rrdset_stream_buffer {
     uint64_t rrdset_flags; // RRDSET_FLAGS
     time_t last_point_end_time_s;
     BUFFER *wb;
+    STREAM_BINARY_FRAME binary;             // the frame being written, with STREAM_CAP_BINARY_DATA
 } RRDSET_STREAM_BUFFER;
 
 RRDSET_STREAM_BUFFER rrdset_push_metric_initialize(RRDSET *st, time_t wall_clock_time);
 void rrdset_push_metrics_v1(RRDSET_STREAM_BUFFER *rsb, RRDSET *st);
 void rrdset_push_metrics_finished(RRDSET_STREAM_BUFFER *rsb, RRDSET *st);
 void rrddim_push_metrics_v2(RRDSET_STREAM_BUFFER *rsb, RRDDIM *rd, usec_t point_end_time_ut, NETDATA_DOUBLE n, SN_FLAGS flags);
+void rrddim_push_metrics_v2_binary_set(RRDSET_STREAM_BUFFER *rsb, RRDDIM *rd, collected_number collected_value, NETDATA_DOUBLE n, SN_FLAGS flags);
 
 bool rrdset_push_chart_definition_now(RRDSET *st);
 void *rrdpush_sender_thread(void *ptr);
@@ -460,6 +479,8 @@ void rrdpush_send_dyncfg(RRDHOST *host);
 
 #define THREAD_TAG_STREAM_RECEIVER "RCVR" // "[host]" is appended
 #define THREAD_TAG_STREAM_SENDER "SNDR" // "[host]" is appended
+#define THREAD_TAG_STREAM_RECEIVERS_POOL "RCVRPOOL" // "[id]" is appended
+#define THREAD_TAG_STREAM_SENDERS_POOL "SNDRPOOL" // "[id]" is appended
 
 int rrdpush_receiver_thread_spawn(struct web_client *w, char *decoded_query_string, void *h2o_ctx);
 void rrdpush_sender_thread_stop(RRDHOST *host, STREAM_HANDSHAKE reason, bool wait);
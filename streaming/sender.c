@@ -1442,21 +1442,18 @@ static bool rrdhost_sender_should_exit(struct sender_state *s) {
     return false;
 }
 
-static void rrdpush_sender_thread_cleanup_callback(void *ptr) {
-    struct rrdpush_sender_thread_data *s = ptr;
-    worker_unregister();
-
-    RRDHOST *host = s->host;
-
+// called by the thread serving the sender, when it stops serving it
+static void rrdpush_sender_release(RRDHOST *host, const char *msg) {
     sender_lock(host->sender);
-    netdata_log_info("STREAM %s [send]: sending thread exits %s",
-         rrdhost_hostname(host),
+    netdata_log_info("STREAM %s [send]: %s %s",
+         rrdhost_hostname(host), msg,
          host->sender->exit.reason != STREAM_HANDSHAKE_NEVER ? stream_handshake_error_to_string(host->sender->exit.reason) : "");
 
     rrdpush_sender_thread_close_socket(host);
     rrdpush_sender_pipe_close(host, host->sender->rrdpush_sender_pipe, false);
 
     rrdhost_clear_sender___while_having_sender_mutex(host);
+    host->sender->pool = NULL;
 
 #ifdef NETDATA_LOG_STREAM_SENDER
     if(host->sender->stream_log_fp) {
@@ -1466,6 +1463,13 @@ static void rrdpush_sender_thread_cleanup_callback(void *ptr) {
 #endif
 
     sender_unlock(host->sender);
+}
+
+static void rrdpush_sender_thread_cleanup_callback(void *ptr) {
+    struct rrdpush_sender_thread_data *s = ptr;
+    worker_unregister();
+
+    rrdpush_sender_release(s->host, "sending thread exits");
 
     freez(s->pipe_buffer);
     freez(s);
@@ -1539,19 +1543,7 @@ static bool stream_sender_log_dst_port(BUFFER *wb, void *ptr) {
     return true;
 }
 
-void *rrdpush_sender_thread(void *ptr) {
-    struct sender_state *s = ptr;
-
-    ND_LOG_STACK lgs[] = {
-            ND_LOG_FIELD_STR(NDF_NIDL_NODE, s->host->hostname),
-            ND_LOG_FIELD_CB(NDF_DST_IP, stream_sender_log_dst_ip, s),
-            ND_LOG_FIELD_CB(NDF_DST_PORT, stream_sender_log_dst_port, s),
-            ND_LOG_FIELD_CB(NDF_DST_TRANSPORT, stream_sender_log_transport, s),
-            ND_LOG_FIELD_CB(NDF_SRC_CAPABILITIES, stream_sender_log_capabilities, s),
-            ND_LOG_FIELD_END(),
-    };
-    ND_LOG_STACK_PUSH(lgs);
-
+static void sender_worker_register(void) {
     worker_register("STREAMSND");
     worker_register_job_name(WORKER_SENDER_JOB_CONNECT, "connect");
     worker_register_job_name(WORKER_SENDER_JOB_PIPE_READ, "pipe read");
@@ -1582,6 +1574,486 @@ void *rrdpush_sender_thread(void *ptr) {
     worker_register_job_custom_metric(WORKER_SENDER_JOB_BYTES_UNCOMPRESSED, "bytes uncompressed", "bytes/s", WORKER_METRIC_INCREMENTAL_TOTAL);
     worker_register_job_custom_metric(WORKER_SENDER_JOB_BYTES_COMPRESSION_RATIO, "cumulative compression savings ratio", "%", WORKER_METRIC_ABSOLUTE);
     worker_register_job_custom_metric(WORKER_SENDER_JOB_REPLAY_DICT_SIZE, "replication dict entries", "entries", WORKER_METRIC_ABSOLUTE);
+}
+
+// the work of a connected sender, before waiting for its pipe and its socket
+// returns 1 to poll(), 0 when the connection has been closed, -1 when streaming cannot continue
+static int rrdpush_sender_prepare_poll(struct sender_state *s, time_t now_s, size_t *outstanding_ptr) {
+    // If the TCP window never opened then something is wrong, restart connection
+    if(unlikely(now_s - s->last_traffic_seen_t > s->timeout &&
+        !rrdpush_sender_pending_replication_requests(s) &&
+        !rrdpush_sender_replicating_charts(s)
+    )) {
+        worker_is_busy(WORKER_SENDER_JOB_DISCONNECT_TIMEOUT);
+        netdata_log_error("STREAM %s [send to %s]: could not send metrics for %d seconds - closing connection - we have sent %zu bytes on this connection via %zu send attempts.", rrdhost_hostname(s->host), s->connected_to, s->timeout, s->sent_bytes_on_this_connection, s->send_attempts);
+        rrdpush_sender_thread_close_socket(s->host);
+        return 0;
+    }
+
+    sender_lock(s);
+    size_t outstanding = cbuffer_next_unsafe(s->buffer, NULL);
+    size_t available = cbuffer_available_size_unsafe(s->buffer);
+    if (unlikely(!outstanding)) {
+        rrdpush_sender_pipe_clear_pending_data(s);
+        rrdpush_sender_cbuffer_recreate_timed(s, now_s, true, false);
+    }
+
+    if(s->compressor.initialized) {
+        size_t bytes_uncompressed = s->compressor.sender_locked.total_uncompressed;
+        size_t bytes_compressed = s->compressor.sender_locked.total_compressed + s->compressor.sender_locked.total_compressions * sizeof(rrdpush_signature_t);
+        NETDATA_DOUBLE ratio = 100.0 - ((NETDATA_DOUBLE)bytes_compressed * 100.0 / (NETDATA_DOUBLE)bytes_uncompressed);
+        worker_set_metric(WORKER_SENDER_JOB_BYTES_UNCOMPRESSED, (NETDATA_DOUBLE)bytes_uncompressed);
+        worker_set_metric(WORKER_SENDER_JOB_BYTES_COMPRESSED, (NETDATA_DOUBLE)bytes_compressed);
+        worker_set_metric(WORKER_SENDER_JOB_BYTES_COMPRESSION_RATIO, ratio);
+    }
+    sender_unlock(s);
+
+    worker_set_metric(WORKER_SENDER_JOB_BUFFER_RATIO, (NETDATA_DOUBLE)(s->buffer->max_size - available) * 100.0 / (NETDATA_DOUBLE)s->buffer->max_size);
+
+    if(outstanding)
+        s->send_attempts++;
+
+    if(unlikely(s->rrdpush_sender_pipe[PIPE_READ] == -1)) {
+        if(!rrdpush_sender_pipe_close(s->host, s->rrdpush_sender_pipe, true)) {
+            netdata_log_error("STREAM %s [send]: cannot create inter-thread communication pipe. Disabling streaming.",
+                  rrdhost_hostname(s->host));
+            rrdpush_sender_thread_close_socket(s->host);
+            return -1;
+        }
+    }
+
+    *outstanding_ptr = outstanding;
+    return 1;
+}
+
+// the work of a connected sender, after poll() reported events on its pipe or its socket
+static void rrdpush_sender_process_events(struct sender_state *s, short pipe_revents, short socket_revents, size_t outstanding, char *pipe_buffer, size_t pipe_buffer_size) {
+     // If we have data and have seen the TCP window open then try to close it by a transmission.
+    if(likely(outstanding && (socket_revents & POLLOUT))) {
+        worker_is_busy(WORKER_SENDER_JOB_SOCKET_SEND);
+        ssize_t bytes = attempt_to_send(s);
+        if(bytes > 0) {
+            s->last_traffic_seen_t = now_monotonic_sec();
+            worker_set_metric(WORKER_SENDER_JOB_BYTES_SENT, (NETDATA_DOUBLE)bytes);
+        }
+    }
+
+    // If the collector woke us up then empty the pipe to remove the signal
+    if (pipe_revents & (POLLIN|POLLPRI)) {
+        worker_is_busy(WORKER_SENDER_JOB_PIPE_READ);
+        netdata_log_debug(D_STREAM, "STREAM: Data added to send buffer (current buffer chunk %zu bytes)...", outstanding);
+
+        if (read(s->rrdpush_sender_pipe[PIPE_READ], pipe_buffer, pipe_buffer_size) == -1)
+            netdata_log_error("STREAM %s [send to %s]: cannot read from internal pipe.", rrdhost_hostname(s->host), s->connected_to);
+    }
+
+    // Read as much as possible to fill the buffer, split into full lines for execution.
+    if (socket_revents & POLLIN) {
+        worker_is_busy(WORKER_SENDER_JOB_SOCKET_RECEIVE);
+        ssize_t bytes = attempt_read(s);
+        if(bytes > 0) {
+            s->last_traffic_seen_t = now_monotonic_sec();
+            worker_set_metric(WORKER_SENDER_JOB_BYTES_RECEIVED, (NETDATA_DOUBLE)bytes);
+        }
+    }
+
+    if(unlikely(s->read_len))
+        execute_commands(s);
+
+    if(unlikely(pipe_revents & (POLLERR|POLLHUP|POLLNVAL))) {
+        char *error = NULL;
+
+        if (unlikely(pipe_revents & POLLERR))
+            error = "pipe reports errors (POLLERR)";
+        else if (unlikely(pipe_revents & POLLHUP))
+            error = "pipe closed (POLLHUP)";
+        else if (unlikely(pipe_revents & POLLNVAL))
+            error = "pipe is invalid (POLLNVAL)";
+
+        if(error) {
+            rrdpush_sender_pipe_close(s->host, s->rrdpush_sender_pipe, true);
+            netdata_log_error("STREAM %s [send to %s]: restarting internal pipe: %s.",
+                  rrdhost_hostname(s->host), s->connected_to, error);
+        }
+    }
+
+    if(unlikely(socket_revents & (POLLERR|POLLHUP|POLLNVAL))) {
+        char *error = NULL;
+
+        if (unlikely(socket_revents & POLLERR))
+            error = "socket reports errors (POLLERR)";
+        else if (unlikely(socket_revents & POLLHUP))
+            error = "connection closed by remote end (POLLHUP)";
+        else if (unlikely(socket_revents & POLLNVAL))
+            error = "connection is invalid (POLLNVAL)";
+
+        if(unlikely(error)) {
+            worker_is_busy(WORKER_SENDER_JOB_DISCONNECT_SOCKET_ERROR);
+            netdata_log_error("STREAM %s [send to %s]: restarting connection: %s - %zu bytes transmitted.",
+                  rrdhost_hostname(s->host), s->connected_to, error, s->sent_bytes_on_this_connection);
+            rrdpush_sender_thread_close_socket(s->host);
+        }
+    }
+
+    // protection from overflow
+    if(unlikely(s->flags & SENDER_FLAG_OVERFLOW)) {
+        worker_is_busy(WORKER_SENDER_JOB_DISCONNECT_OVERFLOW);
+        errno = 0;
+        netdata_log_error("STREAM %s [send to %s]: buffer full (allocated %zu bytes) after sending %zu bytes. Restarting connection",
+              rrdhost_hostname(s->host), s->connected_to, s->buffer->size, s->sent_bytes_on_this_connection);
+        rrdpush_sender_thread_close_socket(s->host);
+    }
+
+    worker_set_metric(WORKER_SENDER_JOB_REPLAY_DICT_SIZE, (NETDATA_DOUBLE) dictionary_entries(s->replication.requests));
+}
+
+// ----------------------------------------------------------------------------
+// senders pool
+//
+// By default, each host streamed to a parent is served by its own sender thread.
+// When 'senders pool threads' is set, the sender thread of each host connects
+// to the parent and then hands the connection over to the pool thread with the
+// fewest senders, which polls the pipes and the sockets of all its senders.
+// When a connection breaks, the pool thread releases its sender, so that a new
+// sender thread is spawned to reconnect it, exactly like when sender threads exit.
+
+size_t rrdpush_senders_pool_threads = 0;
+
+#define SENDERS_POOL_PIPE_BUFFER_SIZE (10 * 1024)
+
+struct senders_pool_thread;
+
+struct senders_pool_sender {
+    struct sender_state *s;
+    struct senders_pool_thread *thread;
+
+    size_t outstanding;                         // the bytes to be sent, when poll() was called
+    size_t slot;                                // the index of its pipe in the poll() array, zero when not polled
+
+    struct senders_pool_sender *prev, *next;
+};
+
+struct senders_pool_thread {
+    size_t id;
+    netdata_thread_t thread;
+    int pipe[2];                                // to wake up the thread when senders are added
+
+    SPINLOCK spinlock;
+    struct senders_pool_sender *incoming;       // handed over, but not served yet - protected by spinlock
+
+    struct senders_pool_sender *senders;        // served by this thread - touched only by this thread
+    size_t count;                               // atomic - all the senders assigned to this thread
+};
+
+static struct {
+    SPINLOCK spinlock;
+    bool stopped;                               // netdata is exiting, no more senders are accepted
+    size_t threads;
+    struct senders_pool_thread *array;
+} senders_pool = {
+        .spinlock = NETDATA_SPINLOCK_INITIALIZER,
+        .stopped = false,
+        .threads = 0,
+        .array = NULL,
+};
+
+static void senders_pool_adopt_incoming(struct senders_pool_thread *t) {
+    spinlock_lock(&t->spinlock);
+    struct senders_pool_sender *incoming = t->incoming;
+    t->incoming = NULL;
+    spinlock_unlock(&t->spinlock);
+
+    while(incoming) {
+        struct senders_pool_sender *p = incoming;
+        DOUBLE_LINKED_LIST_REMOVE_ITEM_UNSAFE(incoming, p, prev, next);
+
+        // this thread owns the sender now
+        sender_lock(p->s);
+        p->s->tid = gettid();
+        sender_unlock(p->s);
+
+        DOUBLE_LINKED_LIST_APPEND_ITEM_UNSAFE(t->senders, p, prev, next);
+    }
+}
+
+static void senders_pool_release(struct senders_pool_thread *t, struct senders_pool_sender *p) {
+    struct sender_state *s = p->s;
+
+    DOUBLE_LINKED_LIST_REMOVE_ITEM_UNSAFE(t->senders, p, prev, next);
+
+    ND_LOG_STACK lgs[] = {
+            ND_LOG_FIELD_STR(NDF_NIDL_NODE, s->host->hostname),
+            ND_LOG_FIELD_CB(NDF_DST_TRANSPORT, stream_sender_log_transport, s),
+            ND_LOG_FIELD_CB(NDF_SRC_CAPABILITIES, stream_sender_log_capabilities, s),
+            ND_LOG_FIELD_END(),
+    };
+    ND_LOG_STACK_PUSH(lgs);
+
+    rrdpush_sender_release(s->host, "left senders pool thread");
+
+    __atomic_sub_fetch(&t->count, 1, __ATOMIC_RELAXED);
+    freez(p);
+}
+
+// returns false when the sender has to be released
+static bool senders_pool_prepare(struct senders_pool_sender *p, time_t now_s) {
+    struct sender_state *s = p->s;
+
+    ND_LOG_STACK lgs[] = {
+            ND_LOG_FIELD_STR(NDF_NIDL_NODE, s->host->hostname),
+            ND_LOG_FIELD_CB(NDF_DST_IP, stream_sender_log_dst_ip, s),
+            ND_LOG_FIELD_CB(NDF_DST_PORT, stream_sender_log_dst_port, s),
+            ND_LOG_FIELD_CB(NDF_DST_TRANSPORT, stream_sender_log_transport, s),
+            ND_LOG_FIELD_CB(NDF_SRC_CAPABILITIES, stream_sender_log_capabilities, s),
+            ND_LOG_FIELD_END(),
+    };
+    ND_LOG_STACK_PUSH(lgs);
+
+    if(rrdhost_sender_should_exit(s) || s->rrdpush_sender_socket == -1)
+        return false;
+
+    return rrdpush_sender_prepare_poll(s, now_s, &p->outstanding) > 0;
+}
+
+static void senders_pool_process(struct senders_pool_sender *p, short pipe_revents, short socket_revents, char *pipe_buffer) {
+    struct sender_state *s = p->s;
+
+    ND_LOG_STACK lgs[] = {
+            ND_LOG_FIELD_STR(NDF_NIDL_NODE, s->host->hostname),
+            ND_LOG_FIELD_CB(NDF_DST_IP, stream_sender_log_dst_ip, s),
+            ND_LOG_FIELD_CB(NDF_DST_PORT, stream_sender_log_dst_port, s),
+            ND_LOG_FIELD_CB(NDF_DST_TRANSPORT, stream_sender_log_transport, s),
+            ND_LOG_FIELD_CB(NDF_SRC_CAPABILITIES, stream_sender_log_capabilities, s),
+            ND_LOG_FIELD_END(),
+    };
+    ND_LOG_STACK_PUSH(lgs);
+
+    rrdpush_sender_process_events(s, pipe_revents, socket_revents, p->outstanding, pipe_buffer, SENDERS_POOL_PIPE_BUFFER_SIZE);
+}
+
+static void senders_pool_release_all(struct senders_pool_thread *t) {
+    senders_pool_adopt_incoming(t);
+    while(t->senders) {
+        struct sender_state *s = t->senders->s;
+        if(!s->exit.reason)
+            s->exit.reason = STREAM_HANDSHAKE_DISCONNECT_NETDATA_EXIT;
+
+        senders_pool_release(t, t->senders);
+    }
+}
+
+static void *senders_pool_thread(void *ptr) {
+    struct senders_pool_thread *t = ptr;
+
+    // the senders of this thread are released when it exits,
+    // so it is stopped by service_running() and joined, never cancelled
+    netdata_thread_disable_cancelability();
+
+    sender_worker_register();
+
+    char *pipe_buffer = mallocz(SENDERS_POOL_PIPE_BUFFER_SIZE);
+    size_t slots = 0;
+    struct pollfd *fds = NULL;
+
+    while(service_running(SERVICE_STREAMING)) {
+        senders_pool_adopt_incoming(t);
+
+        // the internal pipe, and the pipe and the socket of each sender
+        size_t entries = 1;
+        for(struct senders_pool_sender *p = t->senders; p ; p = p->next)
+            entries += 2;
+
+        if(entries > slots) {
+            slots = entries * 2;
+            fds = reallocz(fds, slots * sizeof(*fds));
+        }
+
+        fds[0] = (struct pollfd){ .fd = t->pipe[PIPE_READ], .events = POLLIN, .revents = 0 };
+
+        size_t used = 1;
+        time_t now_s = now_monotonic_sec();
+        struct senders_pool_sender *p = t->senders;
+        while(p) {
+            struct senders_pool_sender *next = p->next;
+
+            p->slot = 0;
+            if(senders_pool_prepare(p, now_s)) {
+                p->slot = used;
+                fds[used++] = (struct pollfd){ .fd = p->s->rrdpush_sender_pipe[PIPE_READ], .events = POLLIN, .revents = 0 };
+                fds[used++] = (struct pollfd){ .fd = p->s->rrdpush_sender_socket, .events = POLLIN | (p->outstanding ? POLLOUT : 0), .revents = 0 };
+            }
+            else
+                senders_pool_release(t, p);
+
+            p = next;
+        }
+
+        worker_is_idle();
+        int rc = poll(fds, used, 50); // timeout in milliseconds, like the sender threads
+        if(rc <= 0) {
+            if(rc < 0 && errno != EINTR && errno != EAGAIN) {
+                netdata_log_error("STREAM: senders pool thread %zu: poll() failed", t->id);
+                sleep_usec(100 * USEC_PER_MS);
+            }
+            continue;
+        }
+
+        if(fds[0].revents & POLLIN) {
+            char buffer[1024];
+            if(read(t->pipe[PIPE_READ], buffer, sizeof(buffer)) == -1 && errno != EAGAIN && errno != EINTR)
+                netdata_log_error("STREAM: senders pool thread %zu: cannot read from internal pipe", t->id);
+        }
+
+        // the senders that lost their connections are released on the next iteration
+        for(p = t->senders; p ; p = p->next) {
+            if(p->slot && (fds[p->slot].revents || fds[p->slot + 1].revents))
+                senders_pool_process(p, fds[p->slot].revents, fds[p->slot + 1].revents, pipe_buffer);
+        }
+    }
+
+    // netdata is exiting
+    senders_pool_release_all(t);
+
+    freez(fds);
+    freez(pipe_buffer);
+    worker_unregister();
+    return NULL;
+}
+
+static void senders_pool_start_unsafe(void) {
+    senders_pool.array = callocz(rrdpush_senders_pool_threads, sizeof(*senders_pool.array));
+
+    for(size_t i = 0; i < rrdpush_senders_pool_threads ;i++) {
+        struct senders_pool_thread *t = &senders_pool.array[senders_pool.threads];
+        t->id = i;
+        spinlock_init(&t->spinlock);
+
+        if(pipe(t->pipe) != 0) {
+            netdata_log_error("STREAM: cannot create the internal pipe of senders pool thread %zu", i);
+            continue;
+        }
+        sock_setnonblock(t->pipe[PIPE_READ]);
+        sock_setnonblock(t->pipe[PIPE_WRITE]);
+
+        char tag[NETDATA_THREAD_TAG_MAX + 1];
+        snprintfz(tag, NETDATA_THREAD_TAG_MAX, THREAD_TAG_STREAM_SENDERS_POOL "[%zu]", i);
+
+        if(netdata_thread_create(&t->thread, tag, NETDATA_THREAD_OPTION_JOINABLE, senders_pool_thread, t)) {
+            netdata_log_error("STREAM: cannot create senders pool thread %zu", i);
+            close(t->pipe[PIPE_READ]);
+            close(t->pipe[PIPE_WRITE]);
+            continue;
+        }
+
+        senders_pool.threads++;
+    }
+}
+
+// called by the sender thread of a host, after it connects to the parent
+// returns false when the sender thread has to serve the connection itself
+static bool senders_pool_add(struct sender_state *s) {
+    // from now on the sender belongs to the pool thread,
+    // so this thread must exit without being cancelled
+    netdata_thread_disable_cancelability();
+
+    struct senders_pool_sender *p = callocz(1, sizeof(*p));
+    p->s = s;
+
+    sender_lock(s);
+    if(s->exit.shutdown) {
+        // rrdpush_sender_thread_stop() is already stopping us
+        sender_unlock(s);
+        netdata_thread_enable_cancelability();
+        freez(p);
+        return false;
+    }
+    s->pool = p;
+    sender_unlock(s);
+
+    // the pool spinlock is held until the sender is handed over,
+    // so that the pool cannot be stopped in the meantime
+    struct senders_pool_thread *t = NULL;
+    spinlock_lock(&senders_pool.spinlock);
+
+    if(!senders_pool.array && !senders_pool.stopped)
+        senders_pool_start_unsafe();
+
+    for(size_t i = 0; i < senders_pool.threads ;i++) {
+        struct senders_pool_thread *c = &senders_pool.array[i];
+        if(!t || __atomic_load_n(&c->count, __ATOMIC_RELAXED) < __atomic_load_n(&t->count, __ATOMIC_RELAXED))
+            t = c;
+    }
+
+    if(t) {
+        p->thread = t;
+        __atomic_add_fetch(&t->count, 1, __ATOMIC_RELAXED);
+
+        spinlock_lock(&t->spinlock);
+        DOUBLE_LINKED_LIST_APPEND_ITEM_UNSAFE(t->incoming, p, prev, next);
+        spinlock_unlock(&t->spinlock);
+
+        if(write(t->pipe[PIPE_WRITE], " ", 1) == -1 && errno != EAGAIN && errno != EWOULDBLOCK)
+            netdata_log_error("STREAM: cannot write to the internal pipe of senders pool thread %zu", t->id);
+    }
+
+    spinlock_unlock(&senders_pool.spinlock);
+
+    if(!t) {
+        sender_lock(s);
+        s->pool = NULL;
+        sender_unlock(s);
+
+        freez(p);
+        netdata_thread_enable_cancelability();
+        return false;
+    }
+
+    return true;
+}
+
+// called at netdata exit, after the streaming threads have been signaled to stop
+void rrdpush_senders_pool_stop(void) {
+    spinlock_lock(&senders_pool.spinlock);
+    senders_pool.stopped = true;
+    size_t threads = senders_pool.threads;
+    struct senders_pool_thread *array = senders_pool.array;
+    senders_pool.threads = 0;
+    senders_pool.array = NULL;
+    spinlock_unlock(&senders_pool.spinlock);
+
+    for(size_t i = 0; i < threads ;i++) {
+        struct senders_pool_thread *t = &array[i];
+
+        if(write(t->pipe[PIPE_WRITE], " ", 1) == -1 && errno != EAGAIN && errno != EWOULDBLOCK)
+            netdata_log_error("STREAM: cannot write to the internal pipe of senders pool thread %zu", t->id);
+
+        netdata_thread_join(t->thread, NULL);
+
+        // senders handed over while the thread was exiting
+        senders_pool_release_all(t);
+
+        close(t->pipe[PIPE_READ]);
+        close(t->pipe[PIPE_WRITE]);
+    }
+
+    freez(array);
+}
+
+void *rrdpush_sender_thread(void *ptr) {
+    struct sender_state *s = ptr;
+    bool pooled = false;
+
+    ND_LOG_STACK lgs[] = {
+            ND_LOG_FIELD_STR(NDF_NIDL_NODE, s->host->hostname),
+            ND_LOG_FIELD_CB(NDF_DST_IP, stream_sender_log_dst_ip, s),
+            ND_LOG_FIELD_CB(NDF_DST_PORT, stream_sender_log_dst_port, s),
+            ND_LOG_FIELD_CB(NDF_DST_TRANSPORT, stream_sender_log_transport, s),
+            ND_LOG_FIELD_CB(NDF_SRC_CAPABILITIES, stream_sender_log_capabilities, s),
+            ND_LOG_FIELD_END(),
+    };
+    ND_LOG_STACK_PUSH(lgs);
+
+    sender_worker_register();
 
     if(!rrdhost_has_rrdpush_sender_enabled(s->host) || !s->host->rrdpush_send_destination ||
        !*s->host->rrdpush_send_destination || !s->host->rrdpush_send_api_key ||
@@ -1681,54 +2153,25 @@ void *rrdpush_sender_thread(void *ptr) {
                    "STREAM %s [send to %s]: enabling metrics streaming...",
                    rrdhost_hostname(s->host), s->connected_to);
 
+            // the sender belongs to the senders pool when this returns true
+            if(rrdpush_senders_pool_threads && senders_pool_add(s)) {
+                pooled = true;
+                break;
+            }
+
             continue;
         }
 
         if(iterations % 1000 == 0)
             now_s = now_monotonic_sec();
 
-        // If the TCP window never opened then something is wrong, restart connection
-        if(unlikely(now_s - s->last_traffic_seen_t > s->timeout &&
-            !rrdpush_sender_pending_replication_requests(s) &&
-            !rrdpush_sender_replicating_charts(s)
-        )) {
-            worker_is_busy(WORKER_SENDER_JOB_DISCONNECT_TIMEOUT);
-            netdata_log_error("STREAM %s [send to %s]: could not send metrics for %d seconds - closing connection - we have sent %zu bytes on this connection via %zu send attempts.", rrdhost_hostname(s->host), s->connected_to, s->timeout, s->sent_bytes_on_this_connection, s->send_attempts);
-            rrdpush_sender_thread_close_socket(s->host);
-            continue;
-        }
-
-        sender_lock(s);
-        size_t outstanding = cbuffer_next_unsafe(s->buffer, NULL);
-        size_t available = cbuffer_available_size_unsafe(s->buffer);
-        if (unlikely(!outstanding)) {
-            rrdpush_sender_pipe_clear_pending_data(s);
-            rrdpush_sender_cbuffer_recreate_timed(s, now_s, true, false);
-        }
-
-        if(s->compressor.initialized) {
-            size_t bytes_uncompressed = s->compressor.sender_locked.total_uncompressed;
-            size_t bytes_compressed = s->compressor.sender_locked.total_compressed + s->compressor.sender_locked.total_compressions * sizeof(rrdpush_signature_t);
-            NETDATA_DOUBLE ratio = 100.0 - ((NETDATA_DOUBLE)bytes_compressed * 100.0 / (NETDATA_DOUBLE)bytes_uncompressed);
-            worker_set_metric(WORKER_SENDER_JOB_BYTES_UNCOMPRESSED, (NETDATA_DOUBLE)bytes_uncompressed);
-            worker_set_metric(WORKER_SENDER_JOB_BYTES_COMPRESSED, (NETDATA_DOUBLE)bytes_compressed);
-            worker_set_metric(WORKER_SENDER_JOB_BYTES_COMPRESSION_RATIO, ratio);
-        }
-        sender_unlock(s);
-
-        worker_set_metric(WORKER_SENDER_JOB_BUFFER_RATIO, (NETDATA_DOUBLE)(s->buffer->max_size - available) * 100.0 / (NETDATA_DOUBLE)s->buffer->max_size);
-
-        if(outstanding)
-            s->send_attempts++;
+        size_t outstanding = 0;
+        int rc = rrdpush_sender_prepare_poll(s, now_s, &outstanding);
+        if(unlikely(rc < 0))
+            break;
 
-        if(unlikely(s->rrdpush_sender_pipe[PIPE_READ] == -1)) {
-            if(!rrdpush_sender_pipe_close(s->host, s->rrdpush_sender_pipe, true)) {
-                netdata_log_error("STREAM %s [send]: cannot create inter-thread communication pipe. Disabling streaming.",
-                      rrdhost_hostname(s->host));
-                rrdpush_sender_thread_close_socket(s->host);
-                break;
-            }
-        }
+        if(unlikely(!rc))
+            continue;
 
         worker_is_idle();
 
@@ -1781,85 +2224,17 @@ void *rrdpush_sender_thread(void *ptr) {
             continue;
         }
 
-         // If we have data and have seen the TCP window open then try to close it by a transmission.
-        if(likely(outstanding && (fds[Socket].revents & POLLOUT))) {
-            worker_is_busy(WORKER_SENDER_JOB_SOCKET_SEND);
-            ssize_t bytes = attempt_to_send(s);
-            if(bytes > 0) {
-                s->last_traffic_seen_t = now_monotonic_sec();
-                worker_set_metric(WORKER_SENDER_JOB_BYTES_SENT, (NETDATA_DOUBLE)bytes);
-            }
-        }
-
-        // If the collector woke us up then empty the pipe to remove the signal
-        if (fds[Collector].revents & (POLLIN|POLLPRI)) {
-            worker_is_busy(WORKER_SENDER_JOB_PIPE_READ);
-            netdata_log_debug(D_STREAM, "STREAM: Data added to send buffer (current buffer chunk %zu bytes)...", outstanding);
-
-            if (read(fds[Collector].fd, thread_data->pipe_buffer, pipe_buffer_size) == -1)
-                netdata_log_error("STREAM %s [send to %s]: cannot read from internal pipe.", rrdhost_hostname(s->host), s->connected_to);
-        }
-
-        // Read as much as possible to fill the buffer, split into full lines for execution.
-        if (fds[Socket].revents & POLLIN) {
-            worker_is_busy(WORKER_SENDER_JOB_SOCKET_RECEIVE);
-            ssize_t bytes = attempt_read(s);
-            if(bytes > 0) {
-                s->last_traffic_seen_t = now_monotonic_sec();
-                worker_set_metric(WORKER_SENDER_JOB_BYTES_RECEIVED, (NETDATA_DOUBLE)bytes);
-            }
-        }
-
-        if(unlikely(s->read_len))
-            execute_commands(s);
-
-        if(unlikely(fds[Collector].revents & (POLLERR|POLLHUP|POLLNVAL))) {
-            char *error = NULL;
-
-            if (unlikely(fds[Collector].revents & POLLERR))
-                error = "pipe reports errors (POLLERR)";
-            else if (unlikely(fds[Collector].revents & POLLHUP))
-                error = "pipe closed (POLLHUP)";
-            else if (unlikely(fds[Collector].revents & POLLNVAL))
-                error = "pipe is invalid (POLLNVAL)";
-
-            if(error) {
-                rrdpush_sender_pipe_close(s->host, s->rrdpush_sender_pipe, true);
-                netdata_log_error("STREAM %s [send to %s]: restarting internal pipe: %s.",
-                      rrdhost_hostname(s->host), s->connected_to, error);
-            }
-        }
-
-        if(unlikely(fds[Socket].revents & (POLLERR|POLLHUP|POLLNVAL))) {
-            char *error = NULL;
-
-            if (unlikely(fds[Socket].revents & POLLERR))
-                error = "socket reports errors (POLLERR)";
-            else if (unlikely(fds[Socket].revents & POLLHUP))
-                error = "connection closed by remote end (POLLHUP)";
-            else if (unlikely(fds[Socket].revents & POLLNVAL))
-                error = "connection is invalid (POLLNVAL)";
-
-            if(unlikely(error)) {
-                worker_is_busy(WORKER_SENDER_JOB_DISCONNECT_SOCKET_ERROR);
-                netdata_log_error("STREAM %s [send to %s]: restarting connection: %s - %zu bytes transmitted.",
-                      rrdhost_hostname(s->host), s->connected_to, error, s->sent_bytes_on_this_connection);
-                rrdpush_sender_thread_close_socket(s->host);
-            }
-        }
+        rrdpush_sender_process_events(s, fds[Collector].revents, fds[Socket].revents, outstanding,
+                                      thread_data->pipe_buffer, pipe_buffer_size);
+    }
 
-        // protection from overflow
-        if(unlikely(s->flags & SENDER_FLAG_OVERFLOW)) {
-            worker_is_busy(WORKER_SENDER_JOB_DISCONNECT_OVERFLOW);
-            errno = 0;
-            netdata_log_error("STREAM %s [send to %s]: buffer full (allocated %zu bytes) after sending %zu bytes. Restarting connection",
-                  rrdhost_hostname(s->host), s->connected_to, s->buffer->size, s->sent_bytes_on_this_connection);
-            rrdpush_sender_thread_close_socket(s->host);
-        }
+    netdata_thread_cleanup_pop(!pooled);
 
-        worker_set_metric(WORKER_SENDER_JOB_REPLAY_DICT_SIZE, (NETDATA_DOUBLE) dictionary_entries(s->replication.requests));
+    if(pooled) {
+        worker_unregister();
+        freez(thread_data->pipe_buffer);
+        freez(thread_data);
     }
 
-    netdata_thread_cleanup_pop(1);
     return NULL;
 }
@@ -1322,6 +1322,8 @@ void rrdr_json_wrapper_begin2(RRDR *r, BUFFER *wb) {
             buffer_json_member_add_time_t(wb, "after", qt->request.after);
             buffer_json_member_add_time_t(wb, "before", qt->request.before);
             buffer_json_member_add_uint64(wb, "points", qt->request.points);
+            if (qt->request.since)
+                buffer_json_member_add_time_t(wb, "since", qt->request.since);
             if (qt->request.options & RRDR_OPTION_SELECTED_TIER)
                 buffer_json_member_add_uint64(wb, "tier", qt->request.tier);
             else
@@ -1257,7 +1257,7 @@ static void query_planer_initialize_plans(QUERY_ENGINE_OPS *ops) {
         ops->plans[p].expanded_after = after;
         ops->plans[p].expanded_before = before;
 
-        ops->r->internal.qt->db.tiers[tier].queries++;
+        __atomic_add_fetch(&ops->r->internal.qt->db.tiers[tier].queries, 1, __ATOMIC_RELAXED);
 
         struct query_metric_tier *tier_ptr = &qm->tiers[tier];
         STORAGE_ENGINE *eng = query_metric_storage_engine(ops->r->internal.qt, qm, tier);
@@ -1945,7 +1945,7 @@ static void rrd2rrdr_query_execute(RRDR *r, size_t dim_id_in_rrdr, QUERY_ENGINE_
     r->stats.result_points_generated += points_added;
     r->stats.db_points_read += ops->db_total_points_read;
     for(size_t tr = 0; tr < storage_tiers ; tr++)
-        qt->db.tiers[tr].points += ops->db_points_read_per_tier[tr];
+        __atomic_add_fetch(&qt->db.tiers[tr].points, ops->db_points_read_per_tier[tr], __ATOMIC_RELAXED);
 }
 
 // ----------------------------------------------------------------------------
@@ -2359,6 +2359,20 @@ bool query_target_calculate_window(QUERY_TARGET *qt) {
                    "QUERY: group %zu is not a multiple of the desired group points %zu",
                    group, resampling_group);
 
+    // incremental queries: the caller already has the points up to 'since'
+    // keep the grouping of the full window, but return only the points
+    // from the one ending at 'since' (it may have been partial) onwards
+    time_t view_update_every = (time_t)(group * query_granularity);
+    time_t since = qt->request.since;
+    if(since > 0 && since > after_wanted + view_update_every - query_granularity) {
+        size_t points_since = (since < before_wanted) ? (size_t)((before_wanted - since) / view_update_every) + 1 : 1;
+        if(points_since < points_wanted) {
+            points_wanted = points_since;
+            after_wanted = before_wanted - (time_t)(points_wanted * view_update_every) + query_granularity;
+            query_debug_log(":since %ld points_wanted %zu after_wanted %ld", since, points_wanted, after_wanted);
+        }
+    }
+
     // -------------------------------------------------------------------------
     // update QUERY_TARGET with our calculations
 
@@ -3425,6 +3439,405 @@ RRDR *rrd2rrdr_legacy(
     return r;
 }
 
+// ----------------------------------------------------------------------------
+// parallel execution of the metrics of a query
+
+// the maximum number of threads a single query may use, including the caller
+size_t query_parallel_threads_per_query = 4;
+
+// queries with fewer metrics per thread are executed serially
+#define QUERY_PARALLEL_MIN_METRICS_PER_THREAD 16
+
+// each thread claims that many metrics at most at once, and prepares them as a query group,
+// while it executes the metrics it claimed before them
+#define QUERY_PARALLEL_MAX_METRICS_PER_BATCH 16
+
+struct query_parallel {
+    QUERY_TARGET *qt;
+    RRDR *r;                            // the RRDR we group-by at
+
+    size_t batch;                       // the metrics a thread claims at once
+    size_t next_metric;                 // atomic, the next query metric to claim
+    bool cancel;                        // atomic, the query has been interrupted or timed out
+
+    SPINLOCK spinlock;                  // protects r, qi, qc, qn and the members below
+    long dimensions_used;
+    long dimensions_nonzero;
+
+    // protected by the mutex of the pool
+    size_t helpers_wanted;              // the helpers that may still join this query
+    size_t helpers_running;             // the helpers working on this query now
+    struct query_parallel *prev, *next; // in the queue of the pool, while helpers are wanted
+};
+
+struct query_parallel_batch {
+    size_t first;
+    size_t count;
+    QUERY_ENGINE_OPS *ops[QUERY_PARALLEL_MAX_METRICS_PER_BATCH];
+};
+
+// the helper threads are shared by all queries - they are started
+// with the first query that needs them and they wait for queries to join
+static struct {
+    netdata_mutex_t mutex;
+    pthread_cond_t queries_cond;        // the helpers wait here for queries that need them
+    pthread_cond_t helpers_cond;        // the queries wait here for their helpers to leave
+    bool initialized;
+    bool stopped;                       // netdata is exiting, the helpers exit and queries run serially
+    size_t threads;
+    netdata_thread_t *array;
+    struct query_parallel *queue;
+} query_parallel_pool = {
+        .mutex = NETDATA_MUTEX_INITIALIZER,
+        .queries_cond = PTHREAD_COND_INITIALIZER,
+        .helpers_cond = PTHREAD_COND_INITIALIZER,
+        .initialized = false,
+        .stopped = false,
+        .threads = 0,
+        .array = NULL,
+        .queue = NULL,
+};
+
+static void query_parallel_execute_metric(struct query_parallel *qp, RRDR *r_tmp, size_t d, QUERY_ENGINE_OPS *ops,
+                                          size_t *last_db_points_read, size_t *last_result_points_generated) {
+    QUERY_TARGET *qt = qp->qt;
+    RRDR *r = qp->r;
+
+    QUERY_METRIC *qm = query_metric(qt, d);
+    QUERY_DIMENSION *qd = query_dimension(qt, qm->link.query_dimension_id);
+    QUERY_INSTANCE *qi = query_instance(qt, qm->link.query_instance_id);
+    QUERY_CONTEXT *qc = query_context(qt, qm->link.query_context_id);
+    QUERY_NODE *qn = query_node(qt, qm->link.query_node_id);
+
+    usec_t started_ut = now_monotonic_usec();
+
+    // the query metric is only touched by this thread,
+    // so everything up to the merge runs without locks
+    if(ops) {
+        r_tmp->od[0] = qm->status;
+        r_tmp->time_grouping.reset(r_tmp);
+        rrd2rrdr_query_execute(r_tmp, 0, ops);
+        r_tmp->od[0] |= RRDR_DIMENSION_QUERIED;
+        rrd2rrdr_query_ops_release(ops);
+    }
+
+    usec_t now_ut = now_monotonic_usec();
+
+    spinlock_lock(&qp->spinlock);
+
+    if(!ops) {
+        qi->metrics.failed++;
+        qc->metrics.failed++;
+        qn->metrics.failed++;
+
+        qd->status |= QUERY_STATUS_FAILED;
+        qm->status |= RRDR_DIMENSION_FAILED;
+
+        spinlock_unlock(&qp->spinlock);
+        return;
+    }
+
+    qm->duration_ut = now_ut - started_ut;
+    qn->duration_ut += qm->duration_ut;
+
+    // the query updates RRDR_DIMENSION_NONZERO
+    qm->status = r_tmp->od[0];
+
+    if(unlikely(!qp->dimensions_used)) {
+        r->view.min = r_tmp->view.min;
+        r->view.max = r_tmp->view.max;
+        r->view.after = r_tmp->view.after;
+        r->view.before = r_tmp->view.before;
+        r->rows = r_tmp->rows;
+    }
+    else {
+        if(r_tmp->view.min < r->view.min)
+            r->view.min = r_tmp->view.min;
+
+        if(r_tmp->view.max > r->view.max)
+            r->view.max = r_tmp->view.max;
+
+        // verify all dimensions are aligned
+        if(r_tmp->view.after != r->view.after) {
+            internal_error(true, "QUERY: 'after' mismatch between dimensions for chart '%s': max is %zu, dimension '%s' has %zu",
+                           rrdinstance_acquired_id(qi->ria), (size_t)r->view.after, rrdmetric_acquired_id(qd->rma), (size_t)r_tmp->view.after);
+
+            r->view.after = (r_tmp->view.after > r->view.after) ? r_tmp->view.after : r->view.after;
+        }
+
+        if(r_tmp->view.before != r->view.before) {
+            internal_error(true, "QUERY: 'before' mismatch between dimensions for chart '%s': max is %zu, dimension '%s' has %zu",
+                           rrdinstance_acquired_id(qi->ria), (size_t)r->view.before, rrdmetric_acquired_id(qd->rma), (size_t)r_tmp->view.before);
+
+            r->view.before = (r_tmp->view.before < r->view.before) ? r_tmp->view.before : r->view.before;
+        }
+
+        if(r_tmp->rows != r->rows) {
+            internal_error(true, "QUERY: 'rows' mismatch between dimensions for chart '%s': max is %zu, dimension '%s' has %zu",
+                           rrdinstance_acquired_id(qi->ria), (size_t)r->rows, rrdmetric_acquired_id(qd->rma), (size_t)r_tmp->rows);
+
+            r->rows = (r_tmp->rows > r->rows) ? r_tmp->rows : r->rows;
+        }
+    }
+
+    rrd2rrdr_group_by_add_metric(r, qm->grouped_as.first_slot, r_tmp, 0,
+                                 qt->request.group_by[0].aggregation, &qm->query_points, 0);
+
+    qi->metrics.queried++;
+    qc->metrics.queried++;
+    qn->metrics.queried++;
+
+    qd->status |= QUERY_STATUS_QUERIED;
+    qm->status |= RRDR_DIMENSION_QUERIED;
+
+    storage_point_make_positive(qm->query_points);
+    storage_point_merge_to(qi->query_points, qm->query_points);
+    storage_point_merge_to(qc->query_points, qm->query_points);
+    storage_point_merge_to(qn->query_points, qm->query_points);
+    storage_point_merge_to(qt->query_points, qm->query_points);
+
+    if(qm->status & RRDR_DIMENSION_NONZERO)
+        qp->dimensions_nonzero++;
+
+    qp->dimensions_used++;
+
+    spinlock_unlock(&qp->spinlock);
+
+    // the interrupt callback checks the socket of the request, so it runs without the spinlock
+    if(!__atomic_load_n(&qp->cancel, __ATOMIC_RELAXED)) {
+        bool interrupted = false, timed_out = false;
+
+        if (qt->request.interrupt_callback && qt->request.interrupt_callback(qt->request.interrupt_callback_data))
+            interrupted = true;
+        else if (qt->request.timeout_ms && ((NETDATA_DOUBLE)(now_ut - qt->timings.received_ut) / 1000.0) > (NETDATA_DOUBLE)qt->request.timeout_ms)
+            timed_out = true;
+
+        // only the thread that cancels the query logs it
+        if((interrupted || timed_out) && !__atomic_exchange_n(&qp->cancel, true, __ATOMIC_RELAXED)) {
+            spinlock_lock(&qp->spinlock);
+            r->view.flags |= RRDR_RESULT_FLAG_CANCEL;
+            spinlock_unlock(&qp->spinlock);
+
+            if(interrupted)
+                nd_log(NDLS_ACCESS, NDLP_NOTICE, "QUERY INTERRUPTED");
+            else
+                nd_log(NDLS_ACCESS, NDLP_WARNING, "QUERY CANCELED RUNTIME EXCEEDED %0.2f ms (LIMIT %lld ms)",
+                       (NETDATA_DOUBLE)(now_ut - qt->timings.received_ut) / 1000.0, (long long)qt->request.timeout_ms);
+        }
+    }
+
+    global_statistics_rrdr_query_completed(
+            1,
+            r_tmp->stats.db_points_read - *last_db_points_read,
+            r_tmp->stats.result_points_generated - *last_result_points_generated,
+            qt->request.query_source);
+
+    *last_db_points_read = r_tmp->stats.db_points_read;
+    *last_result_points_generated = r_tmp->stats.result_points_generated;
+
+}
+
+// claim the next metrics of the query and prepare them together,
+// so that the extents they share are loaded once
+static void query_parallel_batch_claim(struct query_parallel *qp, RRDR *r_tmp, struct query_parallel_batch *b) {
+    size_t used = qp->qt->query.used;
+
+    b->count = 0;
+    if(__atomic_load_n(&qp->cancel, __ATOMIC_RELAXED))
+        return;
+
+    b->first = __atomic_fetch_add(&qp->next_metric, qp->batch, __ATOMIC_RELAXED);
+    if(b->first >= used)
+        return;
+
+    b->count = MIN(qp->batch, used - b->first);
+
+    storage_engine_query_group_begin();
+    for(size_t i = 0; i < b->count ; i++)
+        b->ops[i] = rrd2rrdr_query_ops_prep(r_tmp, b->first + i);
+    storage_engine_query_group_end();
+}
+
+static void query_parallel_execute_metrics(struct query_parallel *qp, RRDR *r_tmp) {
+    struct query_parallel_batch batches[2];
+    struct query_parallel_batch *now = &batches[0], *next = &batches[1];
+
+    size_t last_db_points_read = r_tmp->stats.db_points_read;
+    size_t last_result_points_generated = r_tmp->stats.result_points_generated;
+
+    query_parallel_batch_claim(qp, r_tmp, now);
+    while(now->count) {
+        // the next batch is loaded while this one is executed
+        query_parallel_batch_claim(qp, r_tmp, next);
+
+        for(size_t i = 0; i < now->count ; i++) {
+            if(unlikely(__atomic_load_n(&qp->cancel, __ATOMIC_RELAXED))) {
+                if(now->ops[i]) {
+                    query_planer_finalize_remaining_plans(now->ops[i]);
+                    rrd2rrdr_query_ops_release(now->ops[i]);
+                }
+                continue;
+            }
+
+            query_parallel_execute_metric(qp, r_tmp, now->first + i, now->ops[i],
+                                          &last_db_points_read, &last_result_points_generated);
+        }
+
+        struct query_parallel_batch *t = now;
+        now = next;
+        next = t;
+    }
+}
+
+static void query_parallel_help(struct query_parallel *qp) {
+    QUERY_TARGET *qt = qp->qt;
+
+    // one way allocators are not thread safe, so every helper
+    // gets its own, for its temporary RRDR and its query ops
+    ONEWAYALLOC *owa = onewayalloc_create(0);
+
+    RRDR *r_tmp = rrdr_create(owa, qt, 1, qt->window.points);
+    if(r_tmp) {
+        rrd2rrdr_set_timestamps(r_tmp);
+        rrdr_set_grouping_function(r_tmp, qt->window.time_group_method);
+        r_tmp->time_grouping.create(r_tmp, qt->window.time_group_options);
+
+        query_parallel_execute_metrics(qp, r_tmp);
+
+        r_tmp->time_grouping.free(r_tmp);
+        rrd2rrdr_query_ops_freeall(r_tmp);
+        rrdr_free(owa, r_tmp);
+    }
+
+    onewayalloc_destroy(owa);
+}
+
+static void *query_parallel_helper_thread(void *ptr __maybe_unused) {
+    netdata_mutex_lock(&query_parallel_pool.mutex);
+
+    while(!query_parallel_pool.stopped) {
+        struct query_parallel *qp = query_parallel_pool.queue;
+        if(!qp) {
+            pthread_cond_wait(&query_parallel_pool.queries_cond, &query_parallel_pool.mutex);
+            continue;
+        }
+
+        if(!--qp->helpers_wanted)
+            DOUBLE_LINKED_LIST_REMOVE_ITEM_UNSAFE(query_parallel_pool.queue, qp, prev, next);
+
+        qp->helpers_running++;
+        netdata_mutex_unlock(&query_parallel_pool.mutex);
+
+        query_parallel_help(qp);
+
+        netdata_mutex_lock(&query_parallel_pool.mutex);
+        if(!--qp->helpers_running)
+            pthread_cond_broadcast(&query_parallel_pool.helpers_cond);
+    }
+
+    netdata_mutex_unlock(&query_parallel_pool.mutex);
+    return NULL;
+}
+
+// the helper threads are bound to the number of cpus
+static size_t query_parallel_pool_threads(void) {
+    netdata_mutex_lock(&query_parallel_pool.mutex);
+
+    if(!query_parallel_pool.initialized && !query_parallel_pool.stopped) {
+        query_parallel_pool.initialized = true;
+
+        size_t threads = (size_t)get_netdata_cpus();
+        query_parallel_pool.array = callocz(threads, sizeof(*query_parallel_pool.array));
+        for(size_t i = 0; i < threads ; i++) {
+            char tag[NETDATA_THREAD_TAG_MAX + 1];
+            snprintfz(tag, NETDATA_THREAD_TAG_MAX, "QUERY_PARALLEL[%zu]", i);
+
+            if(netdata_thread_create(&query_parallel_pool.array[query_parallel_pool.threads], tag,
+                                     NETDATA_THREAD_OPTION_JOINABLE | NETDATA_THREAD_OPTION_DONT_LOG,
+                                     query_parallel_helper_thread, NULL) == 0)
+                query_parallel_pool.threads++;
+        }
+    }
+
+    size_t threads = query_parallel_pool.threads;
+    netdata_mutex_unlock(&query_parallel_pool.mutex);
+
+    return threads;
+}
+
+// called at netdata exit - the helpers finish the queries they help and exit,
+// and from now on all queries are executed serially
+void query_parallel_pool_stop(void) {
+    netdata_mutex_lock(&query_parallel_pool.mutex);
+    query_parallel_pool.stopped = true;
+    size_t threads = query_parallel_pool.threads;
+    netdata_thread_t *array = query_parallel_pool.array;
+    query_parallel_pool.threads = 0;
+    query_parallel_pool.array = NULL;
+    pthread_cond_broadcast(&query_parallel_pool.queries_cond);
+    netdata_mutex_unlock(&query_parallel_pool.mutex);
+
+    for(size_t i = 0; i < threads ; i++)
+        netdata_thread_join(array[i], NULL);
+
+    freez(array);
+}
+
+static bool query_parallel_execute(RRDR *r_tmp, long *dimensions_used, long *dimensions_nonzero) {
+    QUERY_TARGET *qt = r_tmp->internal.qt;
+
+    // only v2 queries group the metrics into another RRDR,
+    // v1 queries write directly to their final RRDR
+    if(!r_tmp->group_by.r || query_parallel_threads_per_query < 2)
+        return false;
+
+    size_t threads = qt->query.used / QUERY_PARALLEL_MIN_METRICS_PER_THREAD;
+    if(threads > query_parallel_threads_per_query)
+        threads = query_parallel_threads_per_query;
+
+    if(threads < 2 || !query_parallel_pool_threads())
+        return false;
+
+    // like the serial execution, keep up to 10 queries per libuv worker in flight,
+    // shared by the threads of this query (each has up to 2 batches in flight)
+    size_t batch = (size_t)libuv_worker_threads * 10 / (threads * 2);
+    if(batch > QUERY_PARALLEL_MAX_METRICS_PER_BATCH)
+        batch = QUERY_PARALLEL_MAX_METRICS_PER_BATCH;
+    if(batch < 1)
+        batch = 1;
+
+    struct query_parallel qp = {
+            .qt = qt,
+            .r = r_tmp->group_by.r,
+            .batch = batch,
+            .spinlock = NETDATA_SPINLOCK_INITIALIZER,
+            .helpers_wanted = threads - 1,
+    };
+
+    netdata_mutex_lock(&query_parallel_pool.mutex);
+    DOUBLE_LINKED_LIST_APPEND_ITEM_UNSAFE(query_parallel_pool.queue, &qp, prev, next);
+    pthread_cond_broadcast(&query_parallel_pool.queries_cond);
+    netdata_mutex_unlock(&query_parallel_pool.mutex);
+
+    // the calling thread executes metrics too - when the pool is busy,
+    // it may execute all of them before any helper joins
+    query_parallel_execute_metrics(&qp, r_tmp);
+
+    netdata_mutex_lock(&query_parallel_pool.mutex);
+
+    if(qp.helpers_wanted)
+        DOUBLE_LINKED_LIST_REMOVE_ITEM_UNSAFE(query_parallel_pool.queue, &qp, prev, next);
+
+    while(qp.helpers_running)
+        pthread_cond_wait(&query_parallel_pool.helpers_cond, &query_parallel_pool.mutex);
+
+    netdata_mutex_unlock(&query_parallel_pool.mutex);
+
+    *dimensions_used = qp.dimensions_used;
+    *dimensions_nonzero = qp.dimensions_nonzero;
+    return true;
+}
+
 RRDR *rrd2rrdr(ONEWAYALLOC *owa, QUERY_TARGET *qt) {
     if(!qt || !owa)
         return NULL;
@@ -3468,24 +3881,34 @@ RRDR *rrd2rrdr(ONEWAYALLOC *owa, QUERY_TARGET *qt) {
 
     internal_fatal(released_ops, "QUERY: released_ops should be NULL when the query starts");
 
+    // queries with many metrics are spread across threads,
+    // the rest are executed serially below
+    size_t queries_to_execute = qt->query.used;
+    if(query_parallel_execute(r_tmp, &dimensions_used, &dimensions_nonzero))
+        queries_to_execute = 0;
+
     QUERY_ENGINE_OPS **ops = NULL;
     if(qt->query.used)
         ops = onewayalloc_callocz(owa, qt->query.used, sizeof(QUERY_ENGINE_OPS *));
 
     size_t capacity = libuv_worker_threads * 10;
-    size_t max_queries_to_prepare = (qt->query.used > (capacity - 1)) ? (capacity - 1) : qt->query.used;
+    size_t max_queries_to_prepare = (queries_to_execute > (capacity - 1)) ? (capacity - 1) : queries_to_execute;
     size_t queries_prepared = 0;
+
+    // the first queries are prepared as a group, to load once the extents they share
+    storage_engine_query_group_begin();
     while(queries_prepared < max_queries_to_prepare) {
         // preload another query
         ops[queries_prepared] = rrd2rrdr_query_ops_prep(r_tmp, queries_prepared);
         queries_prepared++;
     }
+    storage_engine_query_group_end();
 
     QUERY_NODE *last_qn = NULL;
     usec_t last_ut = now_monotonic_usec();
     usec_t last_qn_ut = last_ut;
 
-    for(size_t d = 0; d < qt->query.used ; d++) {
+    for(size_t d = 0; d < queries_to_execute ; d++) {
         QUERY_METRIC *qm = query_metric(qt, d);
         QUERY_DIMENSION *qd = query_dimension(qt, qm->link.query_dimension_id);
         QUERY_INSTANCE *qi = query_instance(qt, qm->link.query_instance_id);
@@ -3501,7 +3924,7 @@ RRDR *rrd2rrdr(ONEWAYALLOC *owa, QUERY_TARGET *qt) {
             last_qn_ut = now_ut;
         }
 
-        if(queries_prepared < qt->query.used) {
+        if(queries_prepared < queries_to_execute) {
             // preload another query
             ops[queries_prepared] = rrd2rrdr_query_ops_prep(r_tmp, queries_prepared);
             queries_prepared++;
@@ -3711,3 +4134,94 @@ RRDR *rrd2rrdr(ONEWAYALLOC *owa, QUERY_TARGET *qt) {
 
     return r;
 }
+
+// ----------------------------------------------------------------------------
+// unittest
+
+static void query_window_unittest_calculate(QUERY_TARGET *qt, RRDR_OPTIONS options, time_t since) {
+    qt->request.since = since;
+    qt->window.options = options;
+    query_target_calculate_window(qt);
+}
+
+static int query_window_unittest_since(const char *name, time_t update_every, RRDR_OPTIONS options, size_t points, time_t after, time_t before) {
+    int errors = 0;
+    QUERY_TARGET *qt = callocz(1, sizeof(QUERY_TARGET));
+
+    strncpyz(qt->id, name, MAX_QUERY_TARGET_ID_LENGTH);
+    qt->request.after = after;
+    qt->request.before = before;
+    qt->request.points = points;
+    qt->request.time_group_method = RRDR_GROUPING_AVERAGE;
+    qt->db.first_time_s = after;
+    qt->db.last_time_s = before;
+    qt->db.minimum_latest_update_every_s = update_every;
+
+    // the full window, without 'since'
+    query_window_unittest_calculate(qt, options, 0);
+    time_t full_after = qt->window.after;
+    time_t full_before = qt->window.before;
+    size_t full_points = qt->window.points;
+    size_t group = qt->window.group;
+    time_t query_granularity = qt->window.query_granularity;
+    time_t view_update_every = (time_t)(group * query_granularity);
+    time_t first_point_end = full_after + view_update_every - query_granularity;
+
+    time_t sinces[] = {
+            full_after - 100 * view_update_every,           // before 'after'
+            full_after,
+            first_point_end,                                // the caller has the first point
+            first_point_end + 1,
+            full_before - 5 * view_update_every,            // the end of a point
+            full_before - 5 * view_update_every + 1,
+            full_before - 5 * view_update_every - 1,
+            full_before - 5 * view_update_every + update_every / 3, // not aligned to update_every
+            full_before - 1,
+            full_before,
+            full_before + 1,                                // after 'before'
+            full_before + 100 * view_update_every,
+    };
+
+    for(size_t i = 0; i < sizeof(sinces) / sizeof(sinces[0]) ;i++) {
+        time_t since = sinces[i];
+        query_window_unittest_calculate(qt, options, since);
+
+        // the points of the full window ending at or after 'since' (the one including it too)
+        // and at least the last one
+        size_t expected_points = 0;
+        for(size_t p = 0; p < full_points ;p++) {
+            if(full_before - (time_t)p * view_update_every >= since)
+                expected_points++;
+        }
+        if(!expected_points)
+            expected_points = 1;
+
+        time_t expected_after = full_before - (time_t)(expected_points * view_update_every) + query_granularity;
+
+        if(qt->window.after != expected_after || qt->window.before != full_before ||
+            qt->window.points != expected_points || qt->window.group != group) {
+            fprintf(stderr, "QUERY WINDOW: %s, since %ld (full window %ld to %ld, %zu points of %ld secs): "
+                            "got %ld to %ld, %zu points, group %zu, expected %ld to %ld, %zu points, group %zu\n",
+                    name, since, full_after, full_before, full_points, view_update_every,
+                    qt->window.after, qt->window.before, qt->window.points, qt->window.group,
+                    expected_after, full_before, expected_points, group);
+            errors++;
+        }
+    }
+
+    freez(qt);
+    return errors;
+}
+
+int query_window_unittest(void) {
+    int errors = 0;
+    time_t now = 1700000000;
+
+    errors += query_window_unittest_since("virtual points", 1, 0, 60, now - 3600, now);
+    errors += query_window_unittest_since("all natural points", 10, RRDR_OPTION_NATURAL_POINTS, 0, now - 3600, now);
+    errors += query_window_unittest_since("grouped natural points", 10, RRDR_OPTION_NATURAL_POINTS, 50, now - 3600, now);
+    errors += query_window_unittest_since("not aligned", 10, RRDR_OPTION_NATURAL_POINTS | RRDR_OPTION_NOT_ALIGNED, 50, now - 3607, now - 7);
+
+    fprintf(stderr, "QUERY WINDOW: since unittest %s\n", errors ? "FAILED" : "OK");
+    return errors;
+}
@@ -0,0 +1,264 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "daemon/common.h"
+
+// Dashboards poll the same queries again and again, from many browsers.
+// This cache keeps the rendered responses of queries, keyed by their
+// normalized request parameters, for as long as their data cannot change:
+// - queries touching the live edge of the database are valid until the
+//   database may have collected a newer point (one query granularity)
+// - queries of windows entirely in the past are valid for a longer time,
+//   since only replication and backfilling may update them
+// The least recently used responses are evicted when the cache is full.
+
+size_t query_cache_size_mb = 32;
+time_t query_cache_historical_ttl_s = 60;
+
+typedef struct query_cache_entry {
+    char *key;
+
+    int code;
+    HTTP_CONTENT_TYPE content_type;
+    BUFFER_OPTIONS options;
+    time_t http_expires;
+
+    char *body;
+    size_t body_len;
+
+    time_t expires_s;
+
+    struct query_cache_entry *prev, *next;
+} QUERY_CACHE_ENTRY;
+
+static struct {
+    SPINLOCK spinlock;
+    DICTIONARY *index;
+    QUERY_CACHE_ENTRY *lru;         // the head is the least recently used
+    size_t bytes;
+
+    struct {
+        size_t hits;
+        size_t misses;
+        size_t evictions;
+    } stats;
+} query_cache = {
+        .spinlock = NETDATA_SPINLOCK_INITIALIZER,
+        .index = NULL,
+        .lru = NULL,
+        .bytes = 0,
+};
+
+static inline size_t query_cache_entry_size(QUERY_CACHE_ENTRY *qce) {
+    return sizeof(*qce) + strlen(qce->key) + qce->body_len;
+}
+
+static void query_cache_entry_free_unsafe(QUERY_CACHE_ENTRY *qce) {
+    DOUBLE_LINKED_LIST_REMOVE_ITEM_UNSAFE(query_cache.lru, qce, prev, next);
+    dictionary_del(query_cache.index, qce->key);
+    query_cache.bytes -= query_cache_entry_size(qce);
+
+    freez(qce->key);
+    freez(qce->body);
+    freez(qce);
+}
+
+static void query_cache_init_unsafe(void) {
+    if(unlikely(!query_cache.index))
+        query_cache.index = dictionary_create_advanced(
+                DICT_OPTION_SINGLE_THREADED | DICT_OPTION_VALUE_LINK_DONT_CLONE | DICT_OPTION_DONT_OVERWRITE_VALUE,
+                NULL, 0);
+}
+
+// the free text parameters are prefixed with their length,
+// so that no combination of user patterns can produce the key of another request
+static inline void query_cache_key_text(BUFFER *key, const char *name, const char *text) {
+    if(!text)
+        text = "";
+
+    buffer_sprintf(key, "|%s%zu:%s", name, strlen(text), text);
+}
+
+void query_cache_key(BUFFER *key, QUERY_TARGET_REQUEST *qtr) {
+    buffer_flush(key);
+
+    buffer_sprintf(key, "v%zu", qtr->version);
+    query_cache_key_text(key, "sn", qtr->scope_nodes);
+    query_cache_key_text(key, "sc", qtr->scope_contexts);
+    query_cache_key_text(key, "n", qtr->nodes);
+    query_cache_key_text(key, "c", qtr->contexts);
+    query_cache_key_text(key, "i", qtr->instances);
+    query_cache_key_text(key, "d", qtr->dimensions);
+    query_cache_key_text(key, "l", qtr->labels);
+    query_cache_key_text(key, "a", qtr->alerts);
+
+    buffer_sprintf(key, "|w:%lld,%lld,%zu,%lld|f:%u|o:%llu|t:%zu|r:%lld|tg:%u",
+                   (long long)qtr->after, (long long)qtr->before, qtr->points, (long long)qtr->since,
+                   qtr->format, (unsigned long long)qtr->options, qtr->tier,
+                   (long long)qtr->resampling_time,
+                   (unsigned)qtr->time_group_method);
+    query_cache_key_text(key, "tgo", qtr->time_group_options);
+
+    for(size_t g = 0; g < MAX_QUERY_GROUP_BY_PASSES ;g++) {
+        buffer_sprintf(key, "|g%zu:%u,%u", g,
+                       (unsigned)qtr->group_by[g].group_by,
+                       (unsigned)qtr->group_by[g].aggregation);
+        query_cache_key_text(key, "gl", qtr->group_by[g].group_by_label);
+    }
+}
+
+bool query_cache_get(const char *key, BUFFER *wb, int *code) {
+    if(!query_cache_size_mb)
+        return false;
+
+    time_t now_s = now_realtime_sec();
+    bool found = false;
+
+    spinlock_lock(&query_cache.spinlock);
+    query_cache_init_unsafe();
+
+    QUERY_CACHE_ENTRY *qce = dictionary_get(query_cache.index, key);
+    if(qce && qce->expires_s <= now_s) {
+        query_cache_entry_free_unsafe(qce);
+        qce = NULL;
+    }
+
+    if(qce) {
+        // move it to the end of the lru list
+        DOUBLE_LINKED_LIST_REMOVE_ITEM_UNSAFE(query_cache.lru, qce, prev, next);
+        DOUBLE_LINKED_LIST_APPEND_ITEM_UNSAFE(query_cache.lru, qce, prev, next);
+
+        buffer_memcat(wb, qce->body, qce->body_len);
+        wb->content_type = qce->content_type;
+        wb->options = qce->options;
+        wb->expires = qce->http_expires;
+        *code = qce->code;
+
+        query_cache.stats.hits++;
+        found = true;
+    }
+    else
+        query_cache.stats.misses++;
+
+    spinlock_unlock(&query_cache.spinlock);
+
+    return found;
+}
+
+void query_cache_set(const char *key, BUFFER *wb, int code, QUERY_TARGET *qt) {
+    if(!query_cache_size_mb || code != HTTP_RESP_OK || !buffer_strlen(wb))
+        return;
+
+    time_t now_s = now_realtime_sec();
+    time_t granularity = qt->window.query_granularity ? qt->window.query_granularity : 1;
+
+    time_t expires_s;
+    if(!qt->window.relative && qt->window.before + granularity < now_s)
+        expires_s = now_s + query_cache_historical_ttl_s;
+    else
+        expires_s = now_s + granularity;
+
+    if(expires_s <= now_s)
+        return;
+
+    size_t max_bytes = query_cache_size_mb * 1024 * 1024;
+
+    QUERY_CACHE_ENTRY *qce = callocz(1, sizeof(*qce));
+    qce->key = strdupz(key);
+    qce->code = code;
+    qce->content_type = wb->content_type;
+    qce->options = wb->options;
+    qce->http_expires = wb->expires;
+    qce->body_len = buffer_strlen(wb);
+    qce->body = mallocz(qce->body_len);
+    memcpy(qce->body, buffer_tostring(wb), qce->body_len);
+    qce->expires_s = expires_s;
+
+    size_t size = query_cache_entry_size(qce);
+    if(size > max_bytes / 4) {
+        // do not let a single response flush the whole cache
+        freez(qce->key);
+        freez(qce->body);
+        freez(qce);
+        return;
+    }
+
+    spinlock_lock(&query_cache.spinlock);
+    query_cache_init_unsafe();
+
+    // another thread may have cached the same query in the meantime
+    QUERY_CACHE_ENTRY *old = dictionary_get(query_cache.index, key);
+    if(old)
+        query_cache_entry_free_unsafe(old);
+
+    while(query_cache.lru && query_cache.bytes + size > max_bytes) {
+        query_cache_entry_free_unsafe(query_cache.lru);
+        query_cache.stats.evictions++;
+    }
+
+    dictionary_set(query_cache.index, qce->key, qce, sizeof(*qce));
+    DOUBLE_LINKED_LIST_APPEND_ITEM_UNSAFE(query_cache.lru, qce, prev, next);
+    query_cache.bytes += size;
+
+    spinlock_unlock(&query_cache.spinlock);
+}
+
+void query_cache_statistics(size_t *hits, size_t *misses, size_t *evictions) {
+    spinlock_lock(&query_cache.spinlock);
+    *hits = query_cache.stats.hits;
+    *misses = query_cache.stats.misses;
+    *evictions = query_cache.stats.evictions;
+    spinlock_unlock(&query_cache.spinlock);
+}
+
+// ----------------------------------------------------------------------------
+// unittest
+
+int query_cache_unittest(void) {
+    int errors = 0;
+    BUFFER *k1 = buffer_create(0, NULL);
+    BUFFER *k2 = buffer_create(0, NULL);
+
+    // the same patterns, split differently between the parameters
+    QUERY_TARGET_REQUEST q1 = { .version = 2, .contexts = "a|i:b" };
+    QUERY_TARGET_REQUEST q2 = { .version = 2, .contexts = "a", .instances = "b|i:" };
+
+    query_cache_key(k1, &q1);
+    query_cache_key(k2, &q2);
+    if(strcmp(buffer_tostring(k1), buffer_tostring(k2)) == 0) {
+        fprintf(stderr, "QUERY CACHE: requests with different contexts and instances have the same key '%s'\n",
+                buffer_tostring(k1));
+        errors++;
+    }
+
+    // a missing parameter and an empty one are the same request
+    QUERY_TARGET_REQUEST q3 = { .version = 2, .contexts = "a", .instances = "" };
+    QUERY_TARGET_REQUEST q4 = { .version = 2, .contexts = "a" };
+
+    query_cache_key(k1, &q3);
+    query_cache_key(k2, &q4);
+    if(strcmp(buffer_tostring(k1), buffer_tostring(k2)) != 0) {
+        fprintf(stderr, "QUERY CACHE: the same request has the different keys '%s' and '%s'\n",
+                buffer_tostring(k1), buffer_tostring(k2));
+        errors++;
+    }
+
+    // the group by label of one pass cannot spill into the next pass
+    QUERY_TARGET_REQUEST q5 = { .version = 2 };
+    QUERY_TARGET_REQUEST q6 = { .version = 2 };
+    q5.group_by[0].group_by_label = "x|g1:0,0|gl0:";
+    q6.group_by[0].group_by_label = "x";
+
+    query_cache_key(k1, &q5);
+    query_cache_key(k2, &q6);
+    if(strcmp(buffer_tostring(k1), buffer_tostring(k2)) == 0) {
+        fprintf(stderr, "QUERY CACHE: requests with different group by labels have the same key '%s'\n",
+                buffer_tostring(k1));
+        errors++;
+    }
+
+    buffer_free(k1);
+    buffer_free(k2);
+
+    fprintf(stderr, "QUERY CACHE: key unittest %s\n", errors ? "FAILED" : "OK");
+    return errors;
+}
@@ -0,0 +1,27 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef NETDATA_API_QUERY_CACHE_H
+#define NETDATA_API_QUERY_CACHE_H 1
+
+#include "query.h"
+
+struct query_target_request;
+struct query_target;
+
+extern size_t query_cache_size_mb;
+extern time_t query_cache_historical_ttl_s;
+
+// the cache key of a query, its normalized request parameters
+void query_cache_key(BUFFER *key, struct query_target_request *qtr);
+
+// copies a cached response to wb, returns false when there is no valid entry
+bool query_cache_get(const char *key, BUFFER *wb, int *code);
+
+// caches the response in wb, for as long as the data of qt cannot change
+void query_cache_set(const char *key, BUFFER *wb, int code, struct query_target *qt);
+
+void query_cache_statistics(size_t *hits, size_t *misses, size_t *evictions);
+
+int query_cache_unittest(void);
+
+#endif //NETDATA_API_QUERY_CACHE_H
@@ -203,8 +203,12 @@ RRDR *rrd2rrdr_legacy(
         const char *group_options, time_t timeout_ms, size_t tier, QUERY_SOURCE query_source,
         STORAGE_PRIORITY priority);
 
+extern size_t query_parallel_threads_per_query;
+void query_parallel_pool_stop(void);
+
 RRDR *rrd2rrdr(ONEWAYALLOC *owa, struct query_target *qt);
 bool query_target_calculate_window(struct query_target *qt);
+int query_window_unittest(void);
 
 #ifdef __cplusplus
 }
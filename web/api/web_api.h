@@ -9,6 +9,7 @@
 #include "web/api/formatters/rrd2json.h"
 #include "web/api/health/health_cmdapi.h"
 #include "web/api/queries/weights.h"
+#include "web/api/queries/query_cache.h"
 
 extern bool netdata_is_protected_by_bearer;
 extern DICTIONARY *netdata_authorized_bearers;
@@ -402,6 +402,7 @@ static int web_client_api_request_v2_data(RRDHOST *host __maybe_unused, struct w
     char *after_str = NULL;
     char *resampling_time_str = NULL;
     char *points_str = NULL;
+    char *since_str = NULL;
     char *timeout_str = NULL;
     char *labels = NULL;
     char *alerts = NULL;
@@ -444,6 +445,7 @@ static int web_client_api_request_v2_data(RRDHOST *host __maybe_unused, struct w
         else if(!strcmp(name, "after")) after_str = value;
         else if(!strcmp(name, "before")) before_str = value;
         else if(!strcmp(name, "points")) points_str = value;
+        else if(!strcmp(name, "since")) since_str = value;
         else if(!strcmp(name, "timeout")) timeout_str = value;
         else if(!strcmp(name, "group_by")) {
             group_by[group_by_idx++].group_by = group_by_parse(value);
@@ -548,6 +550,7 @@ static int web_client_api_request_v2_data(RRDHOST *host __maybe_unused, struct w
     time_t    before = (before_str && *before_str)?str2l(before_str):0;
     time_t    after  = (after_str  && *after_str) ?str2l(after_str):-600;
     size_t    points = (points_str && *points_str)?str2u(points_str):0;
+    time_t    since  = (since_str  && *since_str) ?str2l(since_str):0;
     int       timeout = (timeout_str && *timeout_str)?str2i(timeout_str): 0;
     time_t    resampling_time = (resampling_time_str && *resampling_time_str) ? str2l(resampling_time_str) : 0;
 
@@ -566,6 +569,7 @@ static int web_client_api_request_v2_data(RRDHOST *host __maybe_unused, struct w
             .alerts = alerts,
             .timeout_ms = timeout,
             .points = points,
+            .since = since,
             .format = format,
             .options = options,
             .time_group_method = time_group,
@@ -585,9 +589,22 @@ static int web_client_api_request_v2_data(RRDHOST *host __maybe_unused, struct w
     for(size_t g = 0; g < MAX_QUERY_GROUP_BY_PASSES ;g++)
         qtr.group_by[g] = group_by[g];
 
-    QUERY_TARGET *qt = query_target_create(&qtr);
+    QUERY_TARGET *qt = NULL;
     ONEWAYALLOC *owa = NULL;
 
+    // responses wrapped for a specific client or file are not cached
+    BUFFER *cache_key = NULL;
+    if(format != DATASOURCE_DATATABLE_JSONP && format != DATASOURCE_JSONP &&
+        !(outFileName && *outFileName) && !(options & RRDR_OPTION_DEBUG)) {
+        cache_key = buffer_create(1024, NULL);
+        query_cache_key(cache_key, &qtr);
+
+        if(query_cache_get(buffer_tostring(cache_key), w->response.data, &ret))
+            goto cleanup;
+    }
+
+    qt = query_target_create(&qtr);
+
     if(!qt) {
         buffer_sprintf(w->response.data, "Failed to prepare the query.");
         ret = HTTP_RESP_INTERNAL_SERVER_ERROR;
@@ -652,7 +669,11 @@ static int web_client_api_request_v2_data(RRDHOST *host __maybe_unused, struct w
     else
         buffer_cacheable(w->response.data);
 
+    if(cache_key)
+        query_cache_set(buffer_tostring(cache_key), w->response.data, ret, qt);
+
 cleanup:
+    buffer_free(cache_key);
     query_target_release(qt);
     onewayalloc_destroy(owa);
     return ret;